@@ -0,0 +1,1007 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "traits.h"
+#include "dual.h"
+#include "hyper_dual.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class> class adjoint;
+template<class> class adjoint_tape;
+
+template<class>
+struct is_adjoint :
+    std::false_type
+{};
+
+template<class T>
+struct is_adjoint<adjoint<T>> :
+    std::true_type
+{};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  records the computational graph of adjoint<T> numbers
+ *         for reverse-mode differentiation
+ *
+ * @details every operation with at least one active operand appends one
+ *          fixed-size node record (up to 2 parent indices and the
+ *          corresponding local partial derivatives);
+ *          records are stored in large contiguous blocks (arena) that are
+ *          kept on rewind/reset, so recording does not allocate once
+ *          the arena has grown to the required size
+ *
+ *          operations on adjoint<T> are recorded on the tape that is
+ *          active for the calling thread (see activate())
+ *
+ *****************************************************************************/
+template<class NumberType>
+class adjoint_tape
+{
+public:
+    //---------------------------------------------------------------
+    using value_type = NumberType;
+    using index_type = std::uint32_t;
+    using checkpoint_type = index_type;
+
+    static constexpr index_type none = std::numeric_limits<index_type>::max();
+
+
+private:
+    //---------------------------------------------------------------
+    struct node {
+        index_type parent[2];
+        value_type partial[2];
+    };
+
+    static constexpr int block_bits = 14;
+    static constexpr index_type block_size = index_type(1) << block_bits;
+    static constexpr index_type block_mask = block_size - 1;
+
+
+public:
+    //---------------------------------------------------------------
+    adjoint_tape() = default;
+
+    adjoint_tape(const adjoint_tape&) = delete;
+    adjoint_tape& operator = (const adjoint_tape&) = delete;
+
+    //-----------------------------------------------------
+    ~adjoint_tape() {
+        deactivate();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief makes this the tape that records operations of the
+    ///        calling thread
+    void activate() noexcept {
+        active_ref() = this;
+    }
+    //-----------------------------------------------------
+    void deactivate() noexcept {
+        if(active_ref() == this) active_ref() = nullptr;
+    }
+    //-----------------------------------------------------
+    static adjoint_tape*
+    active() noexcept {
+        return active_ref();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief new independent variable
+    adjoint<value_type>
+    variable(const value_type& x) {
+        return adjoint<value_type>{x, push(none, value_type(0), none, value_type(0))};
+    }
+
+
+    //---------------------------------------------------------------
+    index_type size() const noexcept {
+        return size_;
+    }
+    //-----------------------------------------------------
+    bool empty() const noexcept {
+        return size_ < 1;
+    }
+    //-----------------------------------------------------
+    /// @brief current tape position
+    checkpoint_type checkpoint() const noexcept {
+        return size_;
+    }
+    //-----------------------------------------------------
+    /// @brief discards all records after checkpoint c;
+    ///        adjoint numbers recorded after c become invalid
+    void rewind(checkpoint_type c) noexcept {
+        assert(c <= size_);
+        size_ = c;
+        if(adjoints_.size() > size_) adjoints_.resize(size_);
+    }
+    //-----------------------------------------------------
+    void reset() noexcept {
+        rewind(0);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief reverse sweep: computes d(seed * y) / d(x) for all records x
+    ///        back to (and including) checkpoint 'stop'
+    void backward(const adjoint<value_type>& y,
+                  const value_type& seed = value_type(1),
+                  checkpoint_type stop = 0)
+    {
+        adjoints_.assign(size_, value_type(0));
+        if(!y.is_active()) return;
+
+        assert(y.index() < size_);
+        adjoints_[y.index()] = seed;
+
+        for(auto i = y.index() + 1; i-- > stop; ) {
+            const auto a = adjoints_[i];
+            if(a == value_type(0)) continue;
+            const auto& n = at(i);
+            if(n.parent[0] != none) adjoints_[n.parent[0]] += n.partial[0] * a;
+            if(n.parent[1] != none) adjoints_[n.parent[1]] += n.partial[1] * a;
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief derivative w.r.t. x computed by the last backward sweep
+    value_type
+    derivative(const adjoint<value_type>& x) const noexcept {
+        return (x.is_active() && x.index() < adjoints_.size())
+            ? adjoints_[x.index()] : value_type(0);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief appends a node record; returns its index
+    index_type
+    push(index_type p0, const value_type& d0,
+         index_type p1, const value_type& d1)
+    {
+        assert(size_ < none);
+        if((size_ >> block_bits) >= blocks_.size()) {
+            blocks_.emplace_back(new node[block_size]);
+        }
+        auto& n = at(size_);
+        n.parent[0] = p0;
+        n.parent[1] = p1;
+        n.partial[0] = d0;
+        n.partial[1] = d1;
+        return size_++;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    node& at(index_type i) noexcept {
+        return blocks_[i >> block_bits][i & block_mask];
+    }
+    const node& at(index_type i) const noexcept {
+        return blocks_[i >> block_bits][i & block_mask];
+    }
+
+    //---------------------------------------------------------------
+    static adjoint_tape*&
+    active_ref() noexcept {
+        static thread_local adjoint_tape* t = nullptr;
+        return t;
+    }
+
+
+    //---------------------------------------------------------------
+    std::vector<std::unique_ptr<node[]>> blocks_;
+    index_type size_ = 0;
+    std::vector<value_type> adjoints_;
+};
+
+template<class T>
+constexpr typename adjoint_tape<T>::index_type adjoint_tape<T>::none;
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  reverse-mode differentiable number
+ *
+ * @details adjoint numbers created by adjoint_tape<T>::variable() and all
+ *          results of operations involving them are 'active' and recorded
+ *          on the thread's active tape; all other adjoint numbers are
+ *          passive constants and do not produce records
+ *
+ *          adjoint<dual<T>> (forward-over-reverse) yields
+ *          Hessian-vector products: the adjoints' dual parts are H*v
+ *          if the variables' dual parts are v
+ *
+ *****************************************************************************/
+template<class NumberType>
+class adjoint
+{
+    friend class adjoint_tape<NumberType>;
+
+public:
+
+    static_assert(is_number<NumberType>::value,
+        "adjoint<T>: T must be a number type");
+
+    static_assert(!is_adjoint<NumberType>::value,
+        "adjoint<T>: T must not be an adjoint<> type itself");
+
+
+    //---------------------------------------------------------------
+    using value_type   = NumberType;
+    using numeric_type = value_type;
+    using tape_type    = adjoint_tape<value_type>;
+    using index_type   = typename tape_type::index_type;
+
+
+    //---------------------------------------------------------------
+    /// @brief passive zero
+    constexpr
+    adjoint():
+        v_(0), i_{tape_type::none}
+    {}
+
+    /// @brief passive constant
+    explicit constexpr
+    adjoint(const value_type& v):
+        v_{v}, i_{tape_type::none}
+    {}
+
+
+    //---------------------------------------------------------------
+    constexpr const value_type&
+    value() const noexcept {
+        return v_;
+    }
+    //-----------------------------------------------------
+    constexpr index_type
+    index() const noexcept {
+        return i_;
+    }
+    //-----------------------------------------------------
+    constexpr bool
+    is_active() const noexcept {
+        return i_ != tape_type::none;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief result of a unary operation with local partial d
+    static adjoint
+    recorded(const value_type& v, const adjoint& x, const value_type& d)
+    {
+        if(!x.is_active()) return adjoint{v};
+        return adjoint{v, tape().push(x.i_, d, tape_type::none, value_type(0))};
+    }
+    //-----------------------------------------------------
+    /// @brief result of a binary operation with local partials dx, dy
+    static adjoint
+    recorded(const value_type& v,
+             const adjoint& x, const value_type& dx,
+             const adjoint& y, const value_type& dy)
+    {
+        if(!y.is_active()) return recorded(v, x, dx);
+        if(!x.is_active()) return recorded(v, y, dy);
+        return adjoint{v, tape().push(x.i_, dx, y.i_, dy)};
+    }
+
+
+    //---------------------------------------------------------------
+    adjoint& operator += (const adjoint& o) { return (*this = *this + o); }
+    adjoint& operator -= (const adjoint& o) { return (*this = *this - o); }
+    adjoint& operator *= (const adjoint& o) { return (*this = *this * o); }
+    adjoint& operator /= (const adjoint& o) { return (*this = *this / o); }
+
+    adjoint& operator += (const value_type& o) { return (*this = *this + o); }
+    adjoint& operator -= (const value_type& o) { return (*this = *this - o); }
+    adjoint& operator *= (const value_type& o) { return (*this = *this * o); }
+    adjoint& operator /= (const value_type& o) { return (*this = *this / o); }
+
+
+    //---------------------------------------------------------------
+    // with passive value_type operands; non-template, so these are
+    // preferred over the generic scalar overloads of e.g. dual<T>
+    // (needed for adjoint<dual<T>> op dual<T>)
+    //---------------------------------------------------------------
+    friend adjoint
+    operator + (const adjoint& x, const value_type& y) {
+        return recorded(x.v_ + y, x, value_type(1));
+    }
+    friend adjoint
+    operator + (const value_type& y, const adjoint& x) {
+        return recorded(y + x.v_, x, value_type(1));
+    }
+    friend adjoint
+    operator - (const adjoint& x, const value_type& y) {
+        return recorded(x.v_ - y, x, value_type(1));
+    }
+    friend adjoint
+    operator - (const value_type& y, const adjoint& x) {
+        return recorded(y - x.v_, x, value_type(-1));
+    }
+    friend adjoint
+    operator * (const adjoint& x, const value_type& y) {
+        return recorded(x.v_ * y, x, y);
+    }
+    friend adjoint
+    operator * (const value_type& y, const adjoint& x) {
+        return recorded(y * x.v_, x, y);
+    }
+    friend adjoint
+    operator / (const adjoint& x, const value_type& y) {
+        const auto inv = value_type(1) / y;
+        return recorded(x.v_ * inv, x, inv);
+    }
+    friend adjoint
+    operator / (const value_type& y, const adjoint& x) {
+        const auto inv = value_type(1) / x.v_;
+        const auto q = y * inv;
+        return recorded(q, x, -q * inv);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    constexpr
+    adjoint(const value_type& v, index_type i):
+        v_{v}, i_{i}
+    {}
+
+    //---------------------------------------------------------------
+    static tape_type&
+    tape() noexcept {
+        assert(tape_type::active());
+        return *tape_type::active();
+    }
+
+    //---------------------------------------------------------------
+    value_type v_;
+    index_type i_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * LOCAL PARTIALS
+ *
+ * @details f(x) and f'(x) for elementary functions are obtained by
+ *          evaluating f with dual<T>{x,1} (dual.h), or for T = dual<U>
+ *          (forward-over-reverse) with hyper_dual<U>{x.real(),1,x.imag(),0}
+ *          which yields f(x) = {f, f' x.imag()} and f'(x) = {f', f'' x.imag()}
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+template<class T>
+struct adjoint_partials
+{
+    template<class F>
+    static std::pair<T,T>
+    eval(const T& x, F&& f) {
+        const auto d = f(dual<T>{x, T(1)});
+        return {d.real(), d.imag()};
+    }
+
+    static const T& real_part(const T& x) noexcept { return x; }
+
+    template<class T2>
+    static T constant(const T2& x) { return T(x); }
+
+    static T log1p(const T& x) { using std::log1p; return log1p(x); }
+
+    static T pow(const T& b, const T& e) { using std::pow; return pow(b, e); }
+
+    static T atan2(const T& y, const T& x) { using std::atan2; return atan2(y, x); }
+};
+
+//---------------------------------------------------------
+template<class U>
+struct adjoint_partials<dual<U>>
+{
+    using T = dual<U>;
+
+    template<class F>
+    static std::pair<T,T>
+    eval(const T& x, F&& f) {
+        const auto h = f(hyper_dual<U>{x.real(), U(1), x.imag(), U(0)});
+        return {T{h.real(), h.e2()}, T{h.e1(), h.e1e2()}};
+    }
+
+    static const U& real_part(const T& x) noexcept { return x.real(); }
+
+    static const T& constant(const T& x) noexcept { return x; }
+
+    template<class T2>
+    static T constant(const T2& x) { return T(U(x)); }
+
+    static T log1p(const T& x) {
+        using std::log1p;
+        return T{log1p(x.real()), x.imag() / (U(1) + x.real())};
+    }
+
+    static T pow(const T& b, const T& e) {
+        using std::exp; using std::log;
+        return exp(e * log(b));
+    }
+
+    static T atan2(const T& y, const T& x) {
+        using std::atan2;
+        const auto q = U(1) / (x.real() * x.real() + y.real() * y.real());
+        return T{atan2(y.real(), x.real()),
+                 (x.real() * y.imag() - y.real() * x.imag()) * q};
+    }
+};
+
+
+//-------------------------------------------------------------------
+/// @brief passive number converted to T
+template<class T, class T2>
+inline T
+adjoint_constant(const T2& x)
+{
+    return adjoint_partials<T>::constant(x);
+}
+
+//---------------------------------------------------------
+template<class T, class F>
+inline adjoint<T>
+adjoint_unary(const adjoint<T>& x, F&& f)
+{
+    if(!x.is_active()) {
+        return adjoint<T>{adjoint_partials<T>::eval(x.value(), f).first};
+    }
+    const auto p = adjoint_partials<T>::eval(x.value(), f);
+    return adjoint<T>::recorded(p.first, x, p.second);
+}
+
+}  // namespace detail
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T>
+inline constexpr decltype(auto)
+value(const adjoint<T>& x) noexcept
+{
+    return x.value();
+}
+
+//---------------------------------------------------------
+template<class Ostream, class T>
+inline Ostream&
+operator << (Ostream& os, const adjoint<T>& x)
+{
+    return (os << x.value());
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON (values only)
+ *
+ *****************************************************************************/
+template<class T>
+inline bool
+operator == (const adjoint<T>& a, const adjoint<T>& b) { return a.value() == b.value(); }
+template<class T>
+inline bool
+operator != (const adjoint<T>& a, const adjoint<T>& b) { return a.value() != b.value(); }
+template<class T>
+inline bool
+operator <  (const adjoint<T>& a, const adjoint<T>& b) { return a.value() <  b.value(); }
+template<class T>
+inline bool
+operator >  (const adjoint<T>& a, const adjoint<T>& b) { return a.value() >  b.value(); }
+template<class T>
+inline bool
+operator <= (const adjoint<T>& a, const adjoint<T>& b) { return a.value() <= b.value(); }
+template<class T>
+inline bool
+operator >= (const adjoint<T>& a, const adjoint<T>& b) { return a.value() >= b.value(); }
+
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline bool
+operator < (const adjoint<T>& a, const T2& b) { return a.value() < b; }
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline bool
+operator < (const T2& a, const adjoint<T>& b) { return a < b.value(); }
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline bool
+operator > (const adjoint<T>& a, const T2& b) { return a.value() > b; }
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline bool
+operator > (const T2& a, const adjoint<T>& b) { return a > b.value(); }
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+template<class T>
+inline adjoint<T>
+operator + (const adjoint<T>& x, const adjoint<T>& y)
+{
+    return adjoint<T>::recorded(x.value() + y.value(), x, T(1), y, T(1));
+}
+//---------------------------------------------------------
+template<class T>
+inline adjoint<T>
+operator - (const adjoint<T>& x, const adjoint<T>& y)
+{
+    return adjoint<T>::recorded(x.value() - y.value(), x, T(1), y, T(-1));
+}
+//---------------------------------------------------------
+template<class T>
+inline adjoint<T>
+operator * (const adjoint<T>& x, const adjoint<T>& y)
+{
+    return adjoint<T>::recorded(x.value() * y.value(), x, y.value(), y, x.value());
+}
+//---------------------------------------------------------
+template<class T>
+inline adjoint<T>
+operator / (const adjoint<T>& x, const adjoint<T>& y)
+{
+    const auto inv = T(1) / y.value();
+    const auto q = x.value() * inv;
+    return adjoint<T>::recorded(q, x, inv, y, -q * inv);
+}
+//---------------------------------------------------------
+template<class T>
+inline adjoint<T>
+operator - (const adjoint<T>& x)
+{
+    return adjoint<T>::recorded(-x.value(), x, T(-1));
+}
+
+
+//-------------------------------------------------------------------
+// with passive numbers
+//-------------------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator + (const adjoint<T>& x, const T2& y) {
+    return adjoint<T>::recorded(x.value() + detail::adjoint_constant<T>(y), x, T(1));
+}
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator + (const T2& y, const adjoint<T>& x) {
+    return adjoint<T>::recorded(detail::adjoint_constant<T>(y) + x.value(), x, T(1));
+}
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator - (const adjoint<T>& x, const T2& y) {
+    return adjoint<T>::recorded(x.value() - detail::adjoint_constant<T>(y), x, T(1));
+}
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator - (const T2& y, const adjoint<T>& x) {
+    return adjoint<T>::recorded(detail::adjoint_constant<T>(y) - x.value(), x, T(-1));
+}
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator * (const adjoint<T>& x, const T2& y) {
+    const auto c = detail::adjoint_constant<T>(y);
+    return adjoint<T>::recorded(x.value() * c, x, c);
+}
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator * (const T2& y, const adjoint<T>& x) {
+    const auto c = detail::adjoint_constant<T>(y);
+    return adjoint<T>::recorded(c * x.value(), x, c);
+}
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator / (const adjoint<T>& x, const T2& y) {
+    const auto inv = T(1) / detail::adjoint_constant<T>(y);
+    return adjoint<T>::recorded(x.value() * inv, x, inv);
+}
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+operator / (const T2& y, const adjoint<T>& x) {
+    const auto inv = T(1) / x.value();
+    const auto q = detail::adjoint_constant<T>(y) * inv;
+    return adjoint<T>::recorded(q, x, -q * inv);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * FUNCTIONS
+ *
+ *****************************************************************************/
+template<class T>
+inline adjoint<T>
+ceil(const adjoint<T>& x)
+{
+    using std::ceil;
+    return adjoint<T>{T(ceil(detail::adjoint_partials<T>::real_part(x.value())))};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline adjoint<T>
+floor(const adjoint<T>& x)
+{
+    using std::floor;
+    return adjoint<T>{T(floor(detail::adjoint_partials<T>::real_part(x.value())))};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline adjoint<T>
+abs(const adjoint<T>& x)
+{
+    return (detail::adjoint_partials<T>::real_part(x.value()) < 0) ? -x : x;
+}
+
+//---------------------------------------------------------
+/// @brief magnitude squared
+template<class T>
+inline adjoint<T>
+abs2(const adjoint<T>& x)
+{
+    return adjoint<T>::recorded(x.value() * x.value(), x, T(2) * x.value());
+}
+
+
+//-------------------------------------------------------------------
+#define AM_NUMERIC_ADJOINT_UNARY(fun)                                         \
+template<class T>                                                             \
+inline adjoint<T>                                                             \
+fun(const adjoint<T>& x)                                                      \
+{                                                                             \
+    return detail::adjoint_unary(x, [](const auto& d) {                       \
+        using std::fun;                                                       \
+        return fun(d);                                                        \
+    });                                                                       \
+}
+
+AM_NUMERIC_ADJOINT_UNARY(sqrt)
+AM_NUMERIC_ADJOINT_UNARY(cbrt)
+AM_NUMERIC_ADJOINT_UNARY(exp)
+AM_NUMERIC_ADJOINT_UNARY(exp2)
+AM_NUMERIC_ADJOINT_UNARY(expm1)
+AM_NUMERIC_ADJOINT_UNARY(log)
+AM_NUMERIC_ADJOINT_UNARY(log10)
+AM_NUMERIC_ADJOINT_UNARY(log2)
+AM_NUMERIC_ADJOINT_UNARY(logb)
+AM_NUMERIC_ADJOINT_UNARY(sin)
+AM_NUMERIC_ADJOINT_UNARY(cos)
+AM_NUMERIC_ADJOINT_UNARY(tan)
+AM_NUMERIC_ADJOINT_UNARY(asin)
+AM_NUMERIC_ADJOINT_UNARY(acos)
+AM_NUMERIC_ADJOINT_UNARY(atan)
+AM_NUMERIC_ADJOINT_UNARY(sinh)
+AM_NUMERIC_ADJOINT_UNARY(cosh)
+AM_NUMERIC_ADJOINT_UNARY(tanh)
+AM_NUMERIC_ADJOINT_UNARY(asinh)
+AM_NUMERIC_ADJOINT_UNARY(acosh)
+AM_NUMERIC_ADJOINT_UNARY(atanh)
+AM_NUMERIC_ADJOINT_UNARY(erf)
+AM_NUMERIC_ADJOINT_UNARY(erfc)
+
+#undef AM_NUMERIC_ADJOINT_UNARY
+
+
+//-------------------------------------------------------------------
+/// @brief log(1 + x)
+template<class T>
+inline adjoint<T>
+log1p(const adjoint<T>& x)
+{
+    return adjoint<T>::recorded(detail::adjoint_partials<T>::log1p(x.value()),
+                                x, T(1) / (T(1) + x.value()));
+}
+
+//---------------------------------------------------------
+/// @brief logarithm to any base
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+log_base(const T2& base, const adjoint<T>& x)
+{
+    using std::log;
+    return log(x) / log(base);
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline adjoint<T>
+pow(const adjoint<T>& b, const adjoint<T>& e)
+{
+    using std::log;
+    using P = detail::adjoint_partials<T>;
+    const auto p = P::pow(b.value(), e.value());
+    return adjoint<T>::recorded(p,
+        b, e.value() * P::pow(b.value(), e.value() - T(1)),
+        e, p * log(b.value()));
+}
+
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+pow(const adjoint<T>& b, const T2& e)
+{
+    using P = detail::adjoint_partials<T>;
+    const auto c = detail::adjoint_constant<T>(e);
+    return adjoint<T>::recorded(P::pow(b.value(), c),
+        b, c * P::pow(b.value(), c - T(1)));
+}
+
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_adjoint<T2>::value && is_number<T2>::value>>
+inline adjoint<T>
+pow(const T2& b, const adjoint<T>& e)
+{
+    using std::log;
+    const auto c = detail::adjoint_constant<T>(b);
+    const auto p = detail::adjoint_partials<T>::pow(c, e.value());
+    return adjoint<T>::recorded(p, e, p * log(c));
+}
+
+//---------------------------------------------------------
+template<class T>
+inline adjoint<T>
+atan2(const adjoint<T>& y, const adjoint<T>& x)
+{
+    const auto q = T(1) / (x.value() * x.value() + y.value() * y.value());
+    return adjoint<T>::recorded(
+        detail::adjoint_partials<T>::atan2(y.value(), x.value()),
+        y, x.value() * q, x, -y.value() * q);
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline bool
+isfinite(const adjoint<T>& x)
+{
+    using std::isfinite;
+    return isfinite(x.value());
+}
+
+//---------------------------------------------------------
+template<class T>
+inline bool
+isinf(const adjoint<T>& x)
+{
+    using std::isinf;
+    return isinf(x.value());
+}
+
+//---------------------------------------------------------
+template<class T>
+inline bool
+isnan(const adjoint<T>& x)
+{
+    using std::isnan;
+    return isnan(x.value());
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * DRIVERS
+ *
+ * @details f is a functor (or generic lambda) templated on the number type
+ *          returning a scalar:
+ *
+ *              template<class D> D operator () (const D* x) const;
+ *
+ *          the tape is rewound to its initial state afterwards
+ *
+ *****************************************************************************/
+
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief activates a tape for the lifetime of the scope;
+///        on exit (also by exception) the records made in the scope
+///        are discarded and the previously active tape is restored
+template<class T>
+class adjoint_tape_scope
+{
+public:
+    explicit
+    adjoint_tape_scope(adjoint_tape<T>& tape) noexcept :
+        tape_(tape),
+        prev_{adjoint_tape<T>::active()},
+        checkpoint_{tape.checkpoint()}
+    {
+        tape_.activate();
+    }
+
+    adjoint_tape_scope(const adjoint_tape_scope&) = delete;
+    adjoint_tape_scope& operator = (const adjoint_tape_scope&) = delete;
+
+    ~adjoint_tape_scope() {
+        tape_.rewind(checkpoint_);
+        tape_.deactivate();
+        if(prev_) prev_->activate();
+    }
+
+    typename adjoint_tape<T>::checkpoint_type
+    checkpoint() const noexcept {
+        return checkpoint_;
+    }
+
+private:
+    adjoint_tape<T>& tape_;
+    adjoint_tape<T>* prev_;
+    typename adjoint_tape<T>::checkpoint_type checkpoint_;
+};
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief returns f(x); stores the gradient of f at x in g (size n)
+template<class F, class T>
+inline T
+value_and_gradient(adjoint_tape<T>& tape, F&& f,
+                   std::size_t n, const T* x, T* g)
+{
+    const detail::adjoint_tape_scope<T> scope{tape};
+
+    std::vector<adjoint<T>> ax;
+    ax.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) ax.push_back(tape.variable(x[i]));
+
+    const auto y = f(static_cast<const adjoint<T>*>(ax.data()));
+    tape.backward(y, T(1), scope.checkpoint());
+    for(std::size_t i = 0; i < n; ++i) g[i] = tape.derivative(ax[i]);
+
+    return y.value();
+}
+
+//---------------------------------------------------------
+/// @brief Hessian-vector product hv = H(x) v (forward-over-reverse);
+///        stores the gradient in g (size n) unless g is nullptr
+template<class F, class T>
+inline void
+hessian_vector_product(adjoint_tape<dual<T>>& tape, F&& f,
+                       std::size_t n, const T* x, const T* v,
+                       T* hv, T* g = nullptr)
+{
+    std::vector<dual<T>> dx;
+    std::vector<dual<T>> dg(n);
+    dx.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) dx.push_back(dual<T>{x[i], v[i]});
+
+    value_and_gradient(tape, f, n,
+        static_cast<const dual<T>*>(dx.data()), dg.data());
+
+    for(std::size_t i = 0; i < n; ++i) {
+        hv[i] = dg[i].imag();
+        if(g) g[i] = dg[i].real();
+    }
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T>
+struct is_number<adjoint<T>> : std::true_type {};
+
+template<class T>
+struct is_number<adjoint<T>&> : std::true_type {};
+
+template<class T>
+struct is_number<adjoint<T>&&> : std::true_type {};
+
+template<class T>
+struct is_number<const adjoint<T>&> : std::true_type {};
+
+template<class T>
+struct is_number<const adjoint<T>> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+struct is_floating_point<adjoint<T>> :
+    std::integral_constant<bool, is_floating_point<T>::value>
+{};
+
+
+
+//-------------------------------------------------------------------
+template<class T, class T2>
+struct common_numeric_type<adjoint<T>,T2>
+{
+    using type = adjoint<common_numeric_t<T,T2>>;
+};
+//---------------------------------------------------------
+template<class T, class T2>
+struct common_numeric_type<T2,adjoint<T>>
+{
+    using type = adjoint<common_numeric_t<T,T2>>;
+};
+//---------------------------------------------------------
+template<class T1, class T2>
+struct common_numeric_type<adjoint<T1>,adjoint<T2>>
+{
+    using type = adjoint<common_numeric_t<T1,T2>>;
+};
+
+
+}  // namespace num
+}  // namespace am
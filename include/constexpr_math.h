@@ -0,0 +1,116 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+
+/*****************************************************************************
+ *
+ * AM_NUMERIC_IS_CONSTANT_EVALUATED()
+ *
+ * @details true inside constant evaluation if the compiler supports
+ *          __builtin_is_constant_evaluated (g++ >= 9, clang++ >= 9);
+ *          always false otherwise, so that runtime calls keep their
+ *          fast (library) implementation; on such compilers constant
+ *          evaluation is only possible where the library function is
+ *          itself usable in constant expressions (e.g. g++ builtins)
+ *
+ *****************************************************************************/
+#if defined(__has_builtin)
+#  if __has_builtin(__builtin_is_constant_evaluated)
+#    define AM_NUMERIC_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#  endif
+#endif
+#if !defined(AM_NUMERIC_IS_CONSTANT_EVALUATED) && \
+    defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 9)
+#  define AM_NUMERIC_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#if !defined(AM_NUMERIC_IS_CONSTANT_EVALUATED)
+#  define AM_NUMERIC_IS_CONSTANT_EVALUATED() false
+#endif
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * CONSTEXPR SQUARE ROOT
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief Newton-Raphson iteration started above the root;
+///        the iterates decrease monotonically until they stall
+template<class T>
+inline constexpr T
+newton_sqrt(T x) noexcept
+{
+    if(x != x) return x;
+    if(x < T(0)) return std::numeric_limits<T>::quiet_NaN();
+    if(x == T(0) || x > std::numeric_limits<T>::max()) return x;
+
+    T y = (x > T(1)) ? x : T(1);
+    for(;;) {
+        const T next = (y + x / y) / T(2);
+        if(!(next < y)) return y;
+        y = next;
+    }
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr T
+constexpr_sqrt(const T& x, std::true_type) noexcept
+{
+    if(AM_NUMERIC_IS_CONSTANT_EVALUATED()) {
+        return newton_sqrt(x);
+    }
+    using std::sqrt;
+    return sqrt(x);
+}
+
+//---------------------------------------------------------
+/// @brief non-floating-point types: overload found by ADL
+template<class T>
+inline constexpr auto
+constexpr_sqrt(const T& x, std::false_type)
+{
+    using std::sqrt;
+    return sqrt(x);
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief square root that can be used in constant expressions
+/// @details Newton-Raphson iteration during constant evaluation and
+///          std::sqrt at runtime; if the compiler cannot detect constant
+///          evaluation std::sqrt is always used;
+///          other number types use their (ADL-found) sqrt
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+constexpr_sqrt(const T& x)
+{
+    return detail::constexpr_sqrt(x, std::is_floating_point<T>{});
+}
+
+
+}  // namespace num
+}  // namespace am
@@ -12,11 +12,13 @@
 
 #include <cmath>
 #include <cfloat>
+#include <type_traits>
 
 #include "constants.h"
 #include "traits.h"
 #include "limits.h"
 #include "equality.h"
+#include "constexpr_math.h"
 
 
 namespace am {
@@ -96,15 +98,15 @@ public:
 
 
     //---------------------------------------------------------------
-    dual&
+    constexpr dual&
     operator = (const dual&) = default;
-    
-    dual&
+
+    constexpr dual&
     operator = (dual&&) = default;
 
 
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator = (const value_type& realPart)
     {
         r_ = realPart;
@@ -124,13 +126,13 @@ public:
         return i_;
     }
 
-    dual&
+    constexpr dual&
     real(const value_type& v) noexcept {
         r_ = v;
         return *this;
     }
 
-    dual&
+    constexpr dual&
     imag(const value_type& v) noexcept {
         i_ = v;
         return *this;
@@ -138,14 +140,14 @@ public:
 
 
     //---------------------------------------------------------------
-    dual&
+    constexpr dual&
     conjugate() {
         i_ = -i_;
         return *this;
     }
 
     //---------------------------------------------------------
-    dual&
+    constexpr dual&
     negate() noexcept {
         r_ = -r_;
         i_ = -i_;
@@ -156,26 +158,26 @@ public:
     //---------------------------------------------------------------
     // dual (op)= number
     //---------------------------------------------------------------
-    dual&
+    constexpr dual&
     operator += (const value_type& v) {
         r_ += v;
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator -= (const value_type& v) {
         r_ -= v;
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator *= (const value_type& v) {
         r_ *= v;
         i_ *= v;
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator /= (const value_type& v) {
         r_ /= v;
         i_ /= v;
@@ -196,27 +198,27 @@ public:
 
 
     //---------------------------------------------------------------
-    dual&
+    constexpr dual&
     operator ++ () {
         ++r_;
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator -- () {
         --r_;
         return *this;
     }
 
     //-----------------------------------------------------
-    dual
+    constexpr dual
     operator ++ (int) {
         auto old = *this;
         ++*this;
         return old;
     }
     //-----------------------------------------------------
-    dual
+    constexpr dual
     operator -- (int) {
         auto old = *this;
         --*this;
@@ -227,21 +229,21 @@ public:
     //---------------------------------------------------------------
     // dual (op)= dual with different value_type
     //---------------------------------------------------------------
-    dual&
+    constexpr dual&
     operator += (const dual& o) {
         r_ += o.real();
         i_ += o.imag();
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator -= (const dual& o) {
         r_ -= o.real();
         i_ -= o.imag();
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator *= (const dual& o)
     {
         i_ = (r_ * o.imag()) + (o.real() * i_);
@@ -249,7 +251,7 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     operator /= (const dual& o)
     {
         i_ = ((i_ * o.real()) - (r_ * o.imag())) / (o.real() * o.real());
@@ -272,7 +274,7 @@ public:
     }
 
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     times_conj(const dual& o)
     {
         i_ = (r_ * (-o.imag())) + (o.real() * i_);
@@ -280,7 +282,7 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    dual&
+    constexpr dual&
     conj_times(const dual& o) {
         i_ = (r_ * o.imag()) + (o.real() * (-i_));
         r_ *= o.real();
@@ -398,7 +400,7 @@ conj(const dual<T>& x)
  *
  *****************************************************************************/
 template<class T1, class T2>
-inline bool
+inline constexpr bool
 operator == (const dual<T1>& a, const dual<T2>& b)
 {
     return ((a.real() == b.real()) && (a.imag() == b.imag()));
@@ -406,7 +408,7 @@ operator == (const dual<T1>& a, const dual<T2>& b)
 
 //---------------------------------------------------------
 template<class T1, class T2>
-inline bool
+inline constexpr bool
 operator != (const dual<T1>& a, const dual<T2>& b)
 {
     return ((a.real() != b.real()) || (a.imag() != b.imag()));
@@ -450,7 +452,7 @@ approx_0(const dual<T>& x, const T& tol = tolerance<T>)
 //-------------------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator > (const dual<T1>& x, const T2& r)
 {
     return (x.real() > r);
@@ -458,7 +460,7 @@ operator > (const dual<T1>& x, const T2& r)
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator > (const T2& r, const dual<T1>& x)
 {
     return (r > x.real());
@@ -467,7 +469,7 @@ operator > (const T2& r, const dual<T1>& x)
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator >= (const dual<T1>& x, const T2& r)
 {
     return (x.real() >= r);
@@ -475,7 +477,7 @@ operator >= (const dual<T1>& x, const T2& r)
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator >= (const T2& r, const dual<T1>& x)
 {
     return (r >= x.real());
@@ -484,7 +486,7 @@ operator >= (const T2& r, const dual<T1>& x)
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator < (const dual<T1>& x, const T2& r)
 {
     return (x.real() < r);
@@ -492,7 +494,7 @@ operator < (const dual<T1>& x, const T2& r)
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator < (const T2& r, const dual<T1>& x)
 {
     return (r < x.real());
@@ -501,7 +503,7 @@ operator < (const T2& r, const dual<T1>& x)
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator <= (const dual<T1>& x, const T2& r)
 {
     return (x.real() <= r);
@@ -509,7 +511,7 @@ operator <= (const dual<T1>& x, const T2& r)
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
     std::enable_if<!is_dual<T2>::value && is_number<T2>::value>::type>
-inline bool
+inline constexpr bool
 operator <= (const T2& r, const dual<T1>& x)
 {
     return (r <= x.real());
@@ -543,7 +545,7 @@ inline constexpr auto
 operator + (const dual<T1> x, const T2& y)
 {
     using T = common_numeric_t<T1,T2>;
-    return dual<T>{ T(x.real()) + T(y), T(x.imag()) + T(y) };
+    return dual<T>{ T(x.real()) + T(y), T(x.imag()) };
 }
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
@@ -552,7 +554,7 @@ inline constexpr auto
 operator + (const T2& y, const dual<T1> x)
 {
     using T = common_numeric_t<T1,T2>;
-    return dual<T>{ T(y) + T(x.real()), T(y) + T(x.imag()) };
+    return dual<T>{ T(y) + T(x.real()), T(x.imag()) };
 }
 
 
@@ -576,7 +578,7 @@ inline constexpr auto
 operator - (const dual<T1> x, const T2& y)
 {
     using T = common_numeric_t<T1,T2>;
-    return dual<T>{ T(x.real()) - T(y), T(x.imag()) - T(y)};
+    return dual<T>{ T(x.real()) - T(y), T(x.imag()) };
 }
 //---------------------------------------------------------
 template<class T1, class T2, class = typename
@@ -585,7 +587,7 @@ inline constexpr auto
 operator - (const T2& y, const dual<T1> x)
 {
     using T = common_numeric_t<T1,T2>;
-    return dual<T>{T(y) - T(x.real()), T(y) - T(x.imag())};
+    return dual<T>{T(y) - T(x.real()), -T(x.imag())};
 }
 
 
@@ -655,7 +657,8 @@ inline constexpr auto
 operator / (const T2& y, const dual<T1> x)
 {
     using T = common_numeric_t<T1,T2>;
-    return dual<T>{T(y) / T(x.real()), T(y) / T(x.imag())};
+    return dual<T>{T(y) / T(x.real()),
+                   -(T(y) * T(x.imag())) / (T(x.real()) * T(x.real()))};
 }
 
 
@@ -705,7 +708,7 @@ operator - (const dual<T> x)
 // SPECIAL MULTIPLICATIONS
 //-------------------------------------------------------------------
 template<class T1, class T2>
-inline auto
+inline constexpr auto
 times_conj(const dual<T1>& x, const dual<T2>& y)
 {
     using T = common_numeric_t<T1,T2>;
@@ -716,7 +719,7 @@ times_conj(const dual<T1>& x, const dual<T2>& y)
 
 //---------------------------------------------------------
 template<class T1, class T2>
-inline auto
+inline constexpr auto
 conj_times(const dual<T1>& x, const dual<T2>& y)
 {
     using T = common_numeric_t<T1,T2>;
@@ -786,11 +789,10 @@ abs2(const dual<T>& x)
 // ROOTS
 //-------------------------------------------------------------------
 template<class T>
-inline auto
+inline constexpr auto
 sqrt(const dual<T>& x)
 {
-    using std::sqrt;
-    auto sqrt_r = sqrt(x.real());
+    const auto sqrt_r = constexpr_sqrt(x.real());
 
     return dual<T>{sqrt_r, x.imag() / (T(2) * sqrt_r)};
 }
@@ -973,6 +975,119 @@ log_base(const T& base, const dual<T>& x)
 
 
 
+//-------------------------------------------------------------------
+// FUSED EVALUATION OF FUNCTION AND DERIVATIVE
+//-------------------------------------------------------------------
+namespace detail {
+
+/// @brief sin(x) and cos(x)
+template<class T>
+inline void
+sincos(const T& x, T* s, T* c)
+{
+    using std::sin;
+    using std::cos;
+    *s = sin(x);
+    *c = cos(x);
+}
+
+#if defined(__GNUC__)
+/// @brief one call with shared argument reduction
+inline void
+sincos(float x, float* s, float* c) noexcept { __builtin_sincosf(x, s, c); }
+
+inline void
+sincos(double x, double* s, double* c) noexcept { __builtin_sincos(x, s, c); }
+
+inline void
+sincos(long double x, long double* s, long double* c) noexcept {
+    __builtin_sincosl(x, s, c);
+}
+#endif
+
+
+//-------------------------------------------------------------------
+/// @brief sinh(x) and cosh(x)
+template<class T>
+inline void
+sinhcosh(const T& x, T* s, T* c, std::false_type)
+{
+    using std::sinh;
+    using std::cosh;
+    *s = sinh(x);
+    *c = cosh(x);
+}
+
+/// @brief from a single expm1: e = e^|x|,
+///        sinh = (e-1 + (e-1)/e) / 2,  cosh = sinh + 1/e
+template<class T>
+inline void
+sinhcosh(const T& x, T* s, T* c, std::true_type)
+{
+    using std::abs;
+    const auto a = abs(x);
+    //e^x would overflow before sinh, cosh do
+    if(a > T(20)) {
+        sinhcosh(x, s, c, std::false_type{});
+        return;
+    }
+    //|x| avoids cancellation in expm1(x) + 1 for negative x
+    using std::expm1;
+    using std::copysign;
+    const auto em = expm1(a);
+    const auto e = em + T(1);
+    const auto sa = T(0.5) * (em + em / e);
+    *s = copysign(sa, x);
+    *c = sa + T(1) / e;
+}
+
+template<class T>
+inline void
+sinhcosh(const T& x, T* s, T* c)
+{
+    sinhcosh(x, s, c, std::is_floating_point<T>{});
+}
+
+
+//-------------------------------------------------------------------
+/// @brief tanh(x) and its derivative 1/cosh(x)^2
+template<class T>
+inline void
+tanh_sech2(const T& x, T* t, T* d, std::false_type)
+{
+    using std::tanh;
+    using std::cosh;
+    *t = tanh(x);
+    const auto c = cosh(x);
+    *d = T(1) / (c * c);
+}
+
+/// @brief from a single expm1(-2|x|) = e - 1; no overflow and no
+///        cancellation in 1 - tanh^2 for large |x|
+template<class T>
+inline void
+tanh_sech2(const T& x, T* t, T* d, std::true_type)
+{
+    using std::abs;
+    using std::expm1;
+    using std::copysign;
+    const auto em = expm1(T(-2) * abs(x));
+    const auto ep = em + T(2);
+    *t = copysign(-em / ep, x);
+    *d = T(4) * (em + T(1)) / (ep * ep);
+}
+
+template<class T>
+inline void
+tanh_sech2(const T& x, T* t, T* d)
+{
+    tanh_sech2(x, t, d, std::is_floating_point<T>{});
+}
+
+}  // namespace detail
+
+
+
 //-------------------------------------------------------------------
 // TRIGONOMETRIC
 //-------------------------------------------------------------------
@@ -980,9 +1095,9 @@ template<class T>
 inline auto
 sin(const dual<T>& x)
 {
-    using std::sin;
-    using std::cos;
-    return dual<T>{sin(x.real()), x.imag() * cos(x.real())};
+    T s, c;
+    detail::sincos(x.real(), &s, &c);
+    return dual<T>{s, x.imag() * c};
 }
 
 //---------------------------------------------------------
@@ -990,9 +1105,22 @@ template<class T>
 inline auto
 cos(const dual<T>& x)
 {
-    using std::sin;
-    using std::cos;
-    return dual<T>{cos(x.real()), -x.imag() * sin(x.real())};
+    T s, c;
+    detail::sincos(x.real(), &s, &c);
+    return dual<T>{c, -x.imag() * s};
+}
+
+//---------------------------------------------------------
+/// @brief sin(x) and cos(x) with one evaluation of the real part's
+///        sine and cosine
+template<class T>
+inline void
+sincos(const dual<T>& x, dual<T>* s, dual<T>* c)
+{
+    T sr, cr;
+    detail::sincos(x.real(), &sr, &cr);
+    *s = dual<T>{sr,  x.imag() * cr};
+    *c = dual<T>{cr, -x.imag() * sr};
 }
 
 //---------------------------------------------------------
@@ -1000,11 +1128,9 @@ template<class T>
 inline auto
 tan(const dual<T>& x)
 {
-    using std::cos;
     using std::tan;
-    auto cosr2 = cos(x.real());
-    cosr2 *= cosr2;
-    return dual<T>{tan(x.real()), x.imag() / cosr2};
+    const auto t = tan(x.real());
+    return dual<T>{t, x.imag() * (T(1) + t * t)};
 }
 
 
@@ -1050,9 +1176,9 @@ template<class T>
 inline auto
 sinh(const dual<T>& x)
 {
-    using std::sinh;
-    using std::cosh;
-    return dual<T>{sinh(x.real()), x.imag() * cosh(x.real())};
+    T s, c;
+    detail::sinhcosh(x.real(), &s, &c);
+    return dual<T>{s, x.imag() * c};
 }
 
 //---------------------------------------------------------
@@ -1060,9 +1186,22 @@ template<class T>
 inline auto
 cosh(const dual<T>& x)
 {
-    using std::sinh;
-    using std::cosh;
-    return dual<T>{cosh(x.real()), x.imag() * sinh(x.real())};
+    T s, c;
+    detail::sinhcosh(x.real(), &s, &c);
+    return dual<T>{c, x.imag() * s};
+}
+
+//---------------------------------------------------------
+/// @brief sinh(x) and cosh(x) with one evaluation of the real part's
+///        hyperbolic sine and cosine
+template<class T>
+inline void
+sinhcosh(const dual<T>& x, dual<T>* s, dual<T>* c)
+{
+    T sr, cr;
+    detail::sinhcosh(x.real(), &sr, &cr);
+    *s = dual<T>{sr, x.imag() * cr};
+    *c = dual<T>{cr, x.imag() * sr};
 }
 
 //---------------------------------------------------------
@@ -1070,11 +1209,9 @@ template<class T>
 inline auto
 tanh(const dual<T>& x)
 {
-    using std::cosh;
-    using std::tanh;
-    auto coshr2 = cosh(x.real());
-    coshr2 *= coshr2;
-    return dual<T>{tanh(x.real()), x.imag() / coshr2};
+    T t, d;
+    detail::tanh_sech2(x.real(), &t, &d);
+    return dual<T>{t, x.imag() * d};
 }
 
 
@@ -1099,7 +1236,7 @@ acosh(const dual<T>& x)
 {
     using std::acosh;
     using std::sqrt;
-    return dual<T>{acosh(x.real()), -x.imag() / sqrt((x.real()*x.real()) - 1)};
+    return dual<T>{acosh(x.real()), x.imag() / sqrt((x.real()*x.real()) - 1)};
 }
 
 //---------------------------------------------------------
@@ -0,0 +1,208 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "dual.h"
+#include "parallel.h"
+#include "simd.h"
+#include "simd_math.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief pointers to the value and derivative lanes of a
+ *        structure-of-arrays sequence of dual numbers;
+ *        T may be const-qualified
+ *
+ *****************************************************************************/
+template<class T>
+struct dual_lanes
+{
+    T* real;
+    T* imag;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * BATCH KERNELS
+ *
+ * @details out[i] = f(x[i]) for i in [0,n) with dual numbers x[i] =
+ *          {x.real[i], x.imag[i]};
+ *          full packs use the polynomial approximations from simd_math.h,
+ *          the tail elements (and all long double elements) use the
+ *          standard library;
+ *          the output may alias the input
+ *
+ *****************************************************************************/
+namespace detail {
+
+/// @brief f(r, &value, &derivative) is called with packs of real parts
+template<class T, class F>
+inline void
+unary_dual_kernel(std::size_t n, const dual_lanes<const T>& x,
+                  const dual_lanes<T>& out, std::size_t numThreads, F&& f)
+{
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                p_t v, d;
+                f(p_t::load(x.real+i), &v, &d);
+                const auto dx = p_t::load(x.imag+i);
+                v.store(out.real+i);
+                (dx * d).store(out.imag+i);
+            });
+        });
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline void
+exp(std::size_t n, const dual_lanes<const T>& x, const dual_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_dual_kernel(n, x, out, numThreads,
+        [](const auto& r, auto* v, auto* d) {
+            *v = simd::exp(r);
+            *d = *v;
+        });
+}
+
+//---------------------------------------------------------
+/// @brief natural logarithm; real parts must be positive normal numbers
+template<class T>
+inline void
+log(std::size_t n, const dual_lanes<const T>& x, const dual_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_dual_kernel(n, x, out, numThreads,
+        [](const auto& r, auto* v, auto* d) {
+            using p_t = std::decay_t<decltype(r)>;
+            *v = simd::log(r);
+            *d = p_t::broadcast(T(1)) / r;
+        });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+sin(std::size_t n, const dual_lanes<const T>& x, const dual_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_dual_kernel(n, x, out, numThreads,
+        [](const auto& r, auto* v, auto* d) {
+            simd::sincos(r, v, d);
+        });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+cos(std::size_t n, const dual_lanes<const T>& x, const dual_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_dual_kernel(n, x, out, numThreads,
+        [](const auto& r, auto* v, auto* d) {
+            simd::sincos(r, d, v);
+            *d = -*d;
+        });
+}
+
+//---------------------------------------------------------
+/// @brief sin(x[i]) and cos(x[i]) with shared argument reduction
+template<class T>
+inline void
+sincos(std::size_t n, const dual_lanes<const T>& x,
+       const dual_lanes<T>& sinOut, const dual_lanes<T>& cosOut,
+       std::size_t numThreads = 1)
+{
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                p_t s, c;
+                simd::sincos(p_t::load(x.real+i), &s, &c);
+                const auto dx = p_t::load(x.imag+i);
+                s.store(sinOut.real+i);
+                c.store(cosOut.real+i);
+                (dx * c).store(sinOut.imag+i);
+                (-dx * s).store(cosOut.imag+i);
+            });
+        });
+}
+
+//---------------------------------------------------------
+/// @brief square root; real parts must be positive
+template<class T>
+inline void
+sqrt(std::size_t n, const dual_lanes<const T>& x, const dual_lanes<T>& out,
+     std::size_t numThreads = 1)
+{
+    detail::unary_dual_kernel(n, x, out, numThreads,
+        [](const auto& r, auto* v, auto* d) {
+            using p_t = std::decay_t<decltype(r)>;
+            *v = simd::sqrt(r);
+            *d = p_t::broadcast(T(0.5)) / *v;
+        });
+}
+
+//---------------------------------------------------------
+/// @brief x^p = e^(p log(x)); real parts must be positive normal numbers
+template<class T>
+inline void
+pow(std::size_t n, const dual_lanes<const T>& x, const T& p,
+    const dual_lanes<T>& out, std::size_t numThreads = 1)
+{
+    detail::unary_dual_kernel(n, x, out, numThreads,
+        [&p](const auto& r, auto* v, auto* d) {
+            using p_t = std::decay_t<decltype(r)>;
+            const auto pp = p_t::broadcast(p);
+            *v = simd::exp(pp * simd::log(r));
+            *d = pp * *v / r;
+        });
+}
+
+//---------------------------------------------------------
+/// @brief error function
+template<class T>
+inline void
+erf(std::size_t n, const dual_lanes<const T>& x, const dual_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_dual_kernel(n, x, out, numThreads,
+        [](const auto& r, auto* v, auto* d) {
+            using p_t = std::decay_t<decltype(r)>;
+            *v = simd::erf(r);
+            //2/sqrt(pi)
+            *d = p_t::broadcast(T(1.1283791670955125738961589031215451716881012586580L)) *
+                 simd::exp(-r*r);
+        });
+}
+
+
+}  // namespace num
+}  // namespace am
@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <cmath>
+#include <array>
+#include <limits>
+
 #include "quaternion.h"
 #include "dual.h"
 
@@ -20,9 +24,401 @@ namespace num {
 
 /*****************************************************************************
  *
+ * FUSED KERNELS
  *
+ * @details dual quaternions are stored as 8 contiguous scalars
+ *          (rw,rx,ry,rz, dw,dx,dy,dz) = real quaternion r, dual quaternion d
  *
  *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief (pr + e pd) * (qr + e qd) = pr qr + e (pr qd + pd qr)
+template<class T>
+inline constexpr void
+dual_quaternion_product(const T* p, const T* q, T* r) noexcept
+{
+    const T rw = p[0]*q[0] - p[1]*q[1] - p[2]*q[2] - p[3]*q[3];
+    const T rx = p[0]*q[1] + p[1]*q[0] + p[2]*q[3] - p[3]*q[2];
+    const T ry = p[0]*q[2] - p[1]*q[3] + p[2]*q[0] + p[3]*q[1];
+    const T rz = p[0]*q[3] + p[1]*q[2] - p[2]*q[1] + p[3]*q[0];
+
+    const T dw = p[0]*q[4] - p[1]*q[5] - p[2]*q[6] - p[3]*q[7]
+               + p[4]*q[0] - p[5]*q[1] - p[6]*q[2] - p[7]*q[3];
+    const T dx = p[0]*q[5] + p[1]*q[4] + p[2]*q[7] - p[3]*q[6]
+               + p[4]*q[1] + p[5]*q[0] + p[6]*q[3] - p[7]*q[2];
+    const T dy = p[0]*q[6] - p[1]*q[7] + p[2]*q[4] + p[3]*q[5]
+               + p[4]*q[2] - p[5]*q[3] + p[6]*q[0] + p[7]*q[1];
+    const T dz = p[0]*q[7] + p[1]*q[6] - p[2]*q[5] + p[3]*q[4]
+               + p[4]*q[3] + p[5]*q[2] - p[6]*q[1] + p[7]*q[0];
+
+    r[0] = rw; r[1] = rx; r[2] = ry; r[3] = rz;
+    r[4] = dw; r[5] = dx; r[6] = dy; r[7] = dz;
+}
+
+//-------------------------------------------------------------------
+/// @brief unit dual quaternion of a screw motion from
+///        sine and cosine of the half angle, half the pitch,
+///        axis and moment (3 elements each)
+template<class T>
+inline constexpr void
+screw_motion(const T& sinHalf, const T& cosHalf, const T& halfPitch,
+             const T* axis, const T* moment, T* r) noexcept
+{
+    const T hc = halfPitch * cosHalf;
+    r[0] = cosHalf;
+    r[1] = sinHalf * axis[0];
+    r[2] = sinHalf * axis[1];
+    r[3] = sinHalf * axis[2];
+    r[4] = -halfPitch * sinHalf;
+    r[5] = sinHalf * moment[0] + hc * axis[0];
+    r[6] = sinHalf * moment[1] + hc * axis[1];
+    r[7] = sinHalf * moment[2] + hc * axis[2];
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  dual quaternion r + e d
+ *
+ * @details specialization of quaternion<dual<T>> with the same interface
+ *          (components are dual numbers) that stores 8 contiguous
+ *          scalars and uses fused kernels for products, conjugation
+ *          and normalization instead of 16 dual number products
+ *
+ *****************************************************************************/
+template<class T>
+class quaternion<dual<T>>
+{
+    template<class> friend class quaternion;
+
+public:
+    //---------------------------------------------------------------
+    using numeric_type = dual<T>;
+    using value_type   = numeric_type;
+    using scalar_type  = T;
+
+
+    //---------------------------------------------------------------
+    /// @brief unit dual quaternion (identity transform)
+    constexpr
+    quaternion():
+        c_{T(1), T(0), T(0), T(0), T(0), T(0), T(0), T(0)}
+    {}
+
+    explicit constexpr
+    quaternion(const value_type& w, const value_type& x,
+               const value_type& y, const value_type& z)
+    :
+        c_{w.real(), x.real(), y.real(), z.real(),
+           w.imag(), x.imag(), y.imag(), z.imag()}
+    {}
+
+    /// @brief from real quaternion r and dual quaternion d
+    explicit constexpr
+    quaternion(const quaternion<T>& r, const quaternion<T>& d):
+        c_{r.real(), r.imag_i(), r.imag_j(), r.imag_k(),
+           d.real(), d.imag_i(), d.imag_j(), d.imag_k()}
+    {}
+
+    /// @brief from real quaternion (dual part = 0)
+    explicit constexpr
+    quaternion(const quaternion<T>& r):
+        c_{r.real(), r.imag_i(), r.imag_j(), r.imag_k(),
+           T(0), T(0), T(0), T(0)}
+    {}
+
+
+    //---------------------------------------------------------------
+    constexpr
+    quaternion(const quaternion&) = default;
+
+    constexpr
+    quaternion(quaternion&&) = default;
+
+    /// @brief from other dual quaternion (different numeric_type)
+    template<class T2>
+    explicit constexpr
+    quaternion(const quaternion<dual<T2>>& q):
+        c_{T(q.c_[0]), T(q.c_[1]), T(q.c_[2]), T(q.c_[3]),
+           T(q.c_[4]), T(q.c_[5]), T(q.c_[6]), T(q.c_[7])}
+    {}
+
+    /// @brief from real quaternion (different numeric_type; dual part = 0)
+    template<class T2>
+    explicit constexpr
+    quaternion(const quaternion<T2>& r):
+        c_{T(r.real()), T(r.imag_i()), T(r.imag_j()), T(r.imag_k()),
+           T(0), T(0), T(0), T(0)}
+    {}
+
+
+    //---------------------------------------------------------------
+    constexpr quaternion&
+    operator = (const quaternion&) = default;
+
+    constexpr quaternion&
+    operator = (quaternion&&) = default;
+
+    template<class T2>
+    constexpr quaternion&
+    operator = (const quaternion<dual<T2>>& q) {
+        for(int i = 0; i < 8; ++i) c_[i] = T(q.c_[i]);
+        return *this;
+    }
+
+    /// @brief from real quaternion (dual part = 0)
+    template<class T2>
+    constexpr quaternion&
+    operator = (const quaternion<T2>& q) {
+        c_[0] = T(q.real());
+        c_[1] = T(q.imag_i());
+        c_[2] = T(q.imag_j());
+        c_[3] = T(q.imag_k());
+        c_[4] = c_[5] = c_[6] = c_[7] = T(0);
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr value_type
+    real() const noexcept {
+        return value_type{c_[0], c_[4]};
+    }
+    //-----------------------------------------------------
+    constexpr value_type
+    imag_i() const noexcept {
+        return value_type{c_[1], c_[5]};
+    }
+    //-----------------------------------------------------
+    constexpr value_type
+    imag_j() const noexcept {
+        return value_type{c_[2], c_[6]};
+    }
+    //-----------------------------------------------------
+    constexpr value_type
+    imag_k() const noexcept {
+        return value_type{c_[3], c_[7]};
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr quaternion&
+    real(const value_type& w) {
+        c_[0] = w.real(); c_[4] = w.imag();
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    imag_i(const value_type& x) {
+        c_[1] = x.real(); c_[5] = x.imag();
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    imag_j(const value_type& y) {
+        c_[2] = y.real(); c_[6] = y.imag();
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    imag_k(const value_type& z) {
+        c_[3] = z.real(); c_[7] = z.imag();
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief real quaternion r of r + e d
+    constexpr quaternion<T>
+    real_part() const noexcept {
+        return quaternion<T>{c_[0], c_[1], c_[2], c_[3]};
+    }
+    //-----------------------------------------------------
+    /// @brief dual quaternion d of r + e d
+    constexpr quaternion<T>
+    dual_part() const noexcept {
+        return quaternion<T>{c_[4], c_[5], c_[6], c_[7]};
+    }
+
+    //-----------------------------------------------------
+    /// @brief 8 contiguous scalars (rw,rx,ry,rz, dw,dx,dy,dz)
+    constexpr const scalar_type*
+    data() const noexcept {
+        return c_;
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr int
+    dimensions() noexcept {
+        return 4;
+    }
+
+
+    //---------------------------------------------------------------
+    // SPECIAL SETTERS
+    //---------------------------------------------------------------
+    constexpr quaternion&
+    set_unit() {
+        c_[0] = T(1);
+        for(int i = 1; i < 8; ++i) c_[i] = T(0);
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    /// @brief quaternion conjugate of both parts: conj(r) + e conj(d)
+    constexpr quaternion&
+    conjugate() {
+        c_[1] = -c_[1]; c_[2] = -c_[2]; c_[3] = -c_[3];
+        c_[5] = -c_[5]; c_[6] = -c_[6]; c_[7] = -c_[7];
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    invert() {
+        conjugate();
+        normalize();
+        return *this;
+    }
+    //-----------------------------------------------------
+    /// @brief projects onto the unit dual quaternions:
+    ///        r' = r/|r|,  d' = d/|r| - <r',d/|r|> r'
+    ///        (same result as division by the dual number norm);
+    ///        r must not be zero
+    constexpr quaternion&
+    normalize() {
+        const auto s = T(1) / constexpr_sqrt(
+            c_[0]*c_[0] + c_[1]*c_[1] + c_[2]*c_[2] + c_[3]*c_[3]);
+        for(int i = 0; i < 8; ++i) c_[i] *= s;
+        remove_parallel_dual();
+        return *this;
+    }
+    //-----------------------------------------------------
+    /// @brief  cheap renormalization of nearly-unit dual quaternions
+    /// @see    quaternion::renormalize
+    constexpr quaternion&
+    renormalize() {
+        const auto f = (T(3) -
+            (c_[0]*c_[0] + c_[1]*c_[1] + c_[2]*c_[2] + c_[3]*c_[3])) / T(2);
+        for(int i = 0; i < 8; ++i) c_[i] *= f;
+        remove_parallel_dual();
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // dual_quaternion (op)= numeric_type
+    //---------------------------------------------------------------
+    constexpr quaternion&
+    operator += (const value_type& v) {
+        for(int i = 0; i < 4; ++i) {
+            c_[i]   += v.real();
+            c_[i+4] += v.imag();
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    operator -= (const value_type& v) {
+        for(int i = 0; i < 4; ++i) {
+            c_[i]   -= v.real();
+            c_[i+4] -= v.imag();
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    operator *= (const value_type& v) {
+        for(int i = 0; i < 4; ++i) {
+            c_[i+4] = c_[i+4] * v.real() + c_[i] * v.imag();
+            c_[i]  *= v.real();
+        }
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    operator /= (const value_type& v) {
+        const auto ir = T(1) / v.real();
+        const auto id = -v.imag() * ir * ir;
+        return *this *= value_type{ir, id};
+    }
+
+    //---------------------------------------------------------------
+    // dual_quaternion (op)= scalar
+    //---------------------------------------------------------------
+    constexpr quaternion&
+    operator *= (const scalar_type& s) {
+        for(int i = 0; i < 8; ++i) c_[i] *= s;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    operator /= (const scalar_type& s) {
+        for(int i = 0; i < 8; ++i) c_[i] /= s;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // dual_quaternion (op)= dual_quaternion
+    //---------------------------------------------------------------
+    constexpr quaternion&
+    operator *= (const quaternion& q) {
+        detail::dual_quaternion_product(c_, q.c_, c_);
+        return *this;
+    }
+
+    //---------------------------------------------------------
+    constexpr quaternion&
+    times_conj(const quaternion& q) {
+        auto cq = q;
+        cq.conjugate();
+        detail::dual_quaternion_product(c_, cq.c_, c_);
+        return *this;
+    }
+    //---------------------------------------------------------
+    constexpr quaternion&
+    conj_times(const quaternion& q) {
+        conjugate();
+        detail::dual_quaternion_product(c_, q.c_, c_);
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    constexpr quaternion&
+    operator += (const quaternion& q) {
+        for(int i = 0; i < 8; ++i) c_[i] += q.c_[i];
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr quaternion&
+    operator -= (const quaternion& q) {
+        for(int i = 0; i < 8; ++i) c_[i] -= q.c_[i];
+        return *this;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    /// @brief d -= <r,d> r  for |r| = 1
+    constexpr void
+    remove_parallel_dual() noexcept {
+        const auto rd = c_[0]*c_[4] + c_[1]*c_[5] + c_[2]*c_[6] + c_[3]*c_[7];
+        for(int i = 0; i < 4; ++i) c_[i+4] -= rd * c_[i];
+    }
+
+    //---------------------------------------------------------------
+    scalar_type c_[8];
+};
+
+
+
+//-------------------------------------------------------------------
 template<class T>
 using dual_quaternion = quaternion<dual<T>>;
 
@@ -59,59 +455,309 @@ print(Ostream& os, const dual_quaternion<T>& q)
  *
  *
  *****************************************************************************/
+
+//-------------------------------------------------------------------
+// REAL PART
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+real(const dual_quaternion<T>& dq)
+{
+    return dq.real_part();
+}
+
+
+
+//-------------------------------------------------------------------
+// DUAL PART
+//-------------------------------------------------------------------
 template<class T>
 inline constexpr auto
+imag(const dual_quaternion<T>& dq)
+{
+    return dq.dual_part();
+}
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+template<class T>
+inline constexpr dual_quaternion<T>
+operator * (const dual_quaternion<T>& p, const dual_quaternion<T>& q)
+{
+    auto r = p;
+    r *= q;
+    return r;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr dual_quaternion<T>
+operator * (const T& s, dual_quaternion<T> q)
+{
+    q *= s;
+    return q;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr dual_quaternion<T>
+operator * (dual_quaternion<T> q, const T& s)
+{
+    q *= s;
+    return q;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr dual_quaternion<T>
+operator + (dual_quaternion<T> p, const dual_quaternion<T>& q)
+{
+    p += q;
+    return p;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr dual_quaternion<T>
+operator - (dual_quaternion<T> p, const dual_quaternion<T>& q)
+{
+    p -= q;
+    return p;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr dual_quaternion<T>
+operator - (dual_quaternion<T> q)
+{
+    q *= T(-1);
+    return q;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr dual_quaternion<T>
+times_conj(dual_quaternion<T> p, const dual_quaternion<T>& q)
+{
+    p.times_conj(q);
+    return p;
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr dual_quaternion<T>
+conj_times(dual_quaternion<T> p, const dual_quaternion<T>& q)
+{
+    p.conj_times(q);
+    return p;
+}
+
+
+
+/*****************************************************************************
+ *
+ * CONJUGATES
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief quaternion conjugate: conj(r) + e conj(d)
+template<class T>
+inline constexpr dual_quaternion<T>
+conj(dual_quaternion<T> q)
+{
+    q.conjugate();
+    return q;
+}
+
+//---------------------------------------------------------
+/// @brief dual number conjugate: r - e d
+template<class T>
+inline constexpr dual_quaternion<T>
 dual_conj(const dual_quaternion<T>& q)
 {
-    return dual_quaternion<T> {
-        dual<T>{q.real().real(),   -q.real().imag()},
-        dual<T>{q.imag_i().real(), -q.imag_i().imag()},
-        dual<T>{q.imag_j().real(), -q.imag_j().imag()},
-        dual<T>{q.imag_k().real(), -q.imag_k().imag()}
-    };
+    const auto c = q.data();
+    return dual_quaternion<T>{
+        quaternion<T>{ c[0],  c[1],  c[2],  c[3]},
+        quaternion<T>{-c[4], -c[5], -c[6], -c[7]} };
 }
 
 //---------------------------------------------------------
+/// @brief combined conjugate: conj(r) - e conj(d)
 template<class T>
-inline constexpr auto
+inline constexpr dual_quaternion<T>
 full_conj(const dual_quaternion<T>& q)
 {
-    return dual_quaternion<T> {
-        dual<T>{ q.real().real(),  -q.real().imag()},
-        dual<T>{-q.imag_i().real(), q.imag_i().imag()},
-        dual<T>{-q.imag_j().real(), q.imag_j().imag()},
-        dual<T>{-q.imag_k().real(), q.imag_k().imag()}
-    };
+    const auto c = q.data();
+    return dual_quaternion<T>{
+        quaternion<T>{ c[0], -c[1], -c[2], -c[3]},
+        quaternion<T>{-c[4],  c[5],  c[6],  c[7]} };
 }
 
 
 
+/*****************************************************************************
+ *
+ * RIGID TRANSFORMS
+ *
+ * @details a unit dual quaternion r + e t r / 2 represents the rotation r
+ *          followed by the translation t
+ *
+ *****************************************************************************/
+
 //-------------------------------------------------------------------
-// REAL PART
+/// @brief translation t = 2 d conj(r) of a unit dual quaternion
+template<class T>
+inline constexpr std::array<T,3>
+translation(const dual_quaternion<T>& q)
+{
+    const auto c = q.data();
+    return std::array<T,3>{{
+        T(2) * (c[0]*c[5] - c[4]*c[1] + c[2]*c[7] - c[3]*c[6]),
+        T(2) * (c[0]*c[6] - c[4]*c[2] + c[3]*c[5] - c[1]*c[7]),
+        T(2) * (c[0]*c[7] - c[4]*c[3] + c[1]*c[6] - c[2]*c[5]) }};
+}
+
+//---------------------------------------------------------
+/// @brief applies unit dual quaternion q to point p
+///        (without forming q (1 + e p) full_conj(q))
+template<class T>
+inline constexpr std::array<T,3>
+transform(const dual_quaternion<T>& q, const std::array<T,3>& p)
+{
+    const auto r = rotate(q.real_part(), p);
+    const auto t = translation(q);
+    return std::array<T,3>{{r[0] + t[0], r[1] + t[1], r[2] + t[2]}};
+}
+
+//---------------------------------------------------------
+/// @brief unit dual quaternion for rotation r followed by translation t
+template<class T>
+inline constexpr dual_quaternion<T>
+make_rigid_transform(const quaternion<T>& r, const std::array<T,3>& t)
+{
+    return dual_quaternion<T>{r, T(0.5) * (quaternion<T>{T(0), t[0], t[1], t[2]} * r)};
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  screw parameters of a rigid transform:
+ *         rotation by 'angle' about the line with unit direction 'axis'
+ *         and moment 'moment' (= p x axis for any point p on the line)
+ *         combined with the translation 'pitch' along that line
+ *
+ * @details the unit dual quaternion of a screw motion is
+ *            r = (cos(angle/2), sin(angle/2) axis)
+ *            d = (-pitch/2 sin(angle/2),
+ *                 sin(angle/2) moment + pitch/2 cos(angle/2) axis)
+ *
+ *****************************************************************************/
+template<class T>
+struct screw
+{
+    std::array<T,3> axis;
+    std::array<T,3> moment;
+    T angle;
+    T pitch;
+};
+
+
+
 //-------------------------------------------------------------------
+/// @brief screw parameters of unit dual quaternion q (the "log");
+///        pure translations (rotation below rounding level) yield
+///        angle = 0, axis = translation direction and moment = 0
 template<class T>
-inline constexpr auto
-real(const dual_quaternion<T>& dq)
+inline screw<T>
+screw_parameters(const dual_quaternion<T>& q)
 {
-    return quaternion<T>{dq.real().real(),
-                         dq.imag_i().real(),
-                         dq.imag_j().real(),
-                         dq.imag_k().real()};
+    using std::sqrt;
+    using std::atan2;
+
+    const auto c = q.data();
+    const auto t = translation(q);
+    const auto s = sqrt(c[1]*c[1] + c[2]*c[2] + c[3]*c[3]);
+
+    if(s > std::numeric_limits<T>::epsilon()) {
+        const auto is = T(1) / s;
+        const auto l = std::array<T,3>{{c[1] * is, c[2] * is, c[3] * is}};
+        //translation along the axis; stable for small angles
+        const auto pitch = t[0]*l[0] + t[1]*l[1] + t[2]*l[2];
+        const auto hc = T(0.5) * pitch * c[0];
+        return screw<T>{l,
+            std::array<T,3>{{(c[5] - hc * l[0]) * is,
+                             (c[6] - hc * l[1]) * is,
+                             (c[7] - hc * l[2]) * is}},
+            T(2) * atan2(s, c[0]), pitch};
+    }
+
+    const auto tn = sqrt(t[0]*t[0] + t[1]*t[1] + t[2]*t[2]);
+    const auto it = (tn > T(0)) ? T(1) / tn : T(0);
+    return screw<T>{
+        (tn > T(0)) ? std::array<T,3>{{t[0] * it, t[1] * it, t[2] * it}}
+                    : std::array<T,3>{{T(1), T(0), T(0)}},
+        std::array<T,3>{{T(0), T(0), T(0)}}, T(0), tn};
 }
 
 
 
 //-------------------------------------------------------------------
-// DUAL PART
+/// @brief unit dual quaternion of a screw motion (the "exp")
+template<class T>
+inline dual_quaternion<T>
+make_dual_quaternion(const screw<T>& s)
+{
+    using std::sin;
+    using std::cos;
+
+    const auto h = T(0.5) * s.angle;
+    T c[8] = {};
+    detail::screw_motion(sin(h), cos(h), T(0.5) * s.pitch,
+                         s.axis.data(), s.moment.data(), c);
+
+    return dual_quaternion<T>{
+        quaternion<T>{c[0], c[1], c[2], c[3]},
+        quaternion<T>{c[4], c[5], c[6], c[7]} };
+}
+
+
+
 //-------------------------------------------------------------------
+/// @brief q^t of a unit dual quaternion: same screw, angle and pitch
+///        scaled by t
 template<class T>
-inline constexpr auto
-imag(const dual_quaternion<T>& dq)
+inline dual_quaternion<T>
+pow(const dual_quaternion<T>& q, const T& t)
+{
+    auto s = screw_parameters(q);
+    s.angle *= t;
+    s.pitch *= t;
+    return make_dual_quaternion(s);
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief screw linear interpolation a (conj(a) b)^t between unit dual
+///        quaternions along the shortest path; t in [0,1]
+/// @see   sclerp_table for repeated interpolation of the same key pairs
+template<class T>
+inline dual_quaternion<T>
+sclerp(const dual_quaternion<T>& a, const dual_quaternion<T>& b, const T& t)
 {
-    return quaternion<T>{dq.real().imag(),
-                         dq.imag_i().imag(),
-                         dq.imag_j().imag(),
-                         dq.imag_k().imag()};
+    assert((t >= T(0)) && (t <= T(1)));
+
+    auto d = conj_times(a, b);
+    if(d.data()[0] < T(0)) d *= T(-1);
+
+    return a * pow(d, t);
 }
 
 
@@ -133,10 +779,8 @@ make_dual_quaternion(
     using res_t = common_numeric_t<T1,T2,T3,T4,T5,T6,T7,T8>;
 
     return dual_quaternion<res_t>{
-            dual<res_t>{aw, bw},
-            dual<res_t>{ax, bx},
-            dual<res_t>{ay, by},
-            dual<res_t>{az, bz}
+            quaternion<res_t>{res_t(aw), res_t(ax), res_t(ay), res_t(az)},
+            quaternion<res_t>{res_t(bw), res_t(bx), res_t(by), res_t(bz)}
         };
 }
 
@@ -148,11 +792,7 @@ make_dual(const quaternion<T1>& real, const quaternion<T2>& imag)
     using res_t = common_numeric_t<T1,T2>;
 
     return dual_quaternion<res_t>{
-            dual<res_t>{real.real(),   imag.real()},
-            dual<res_t>{real.imag_i(), imag.imag_i()},
-            dual<res_t>{real.imag_j(), imag.imag_j()},
-            dual<res_t>{real.imag_k(), imag.imag_k()}  
-        };
+            quaternion<res_t>{real}, quaternion<res_t>{imag} };
 }
 
 //---------------------------------------------------------
@@ -166,4 +806,3 @@ make_dual(const quaternion<T>& q)
 
 }  // namespace num
 }  // namespace am
-
@@ -0,0 +1,169 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include "dual_quaternion.h"
+#include "quaternion_array.h"
+#include "parallel.h"
+#include "simd.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief pointers to the 8 component lanes of a structure-of-arrays
+ *        dual quaternion sequence (real and dual quaternion lanes);
+ *        T may be const-qualified
+ *
+ *****************************************************************************/
+template<class T>
+struct dual_quaternion_lanes
+{
+    quaternion_lanes<T> real;
+    quaternion_lanes<T> imag;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * BATCH RIGID TRANSFORMS
+ *
+ * @details applies unit dual quaternions to n points stored in SoA lanes;
+ *          'out' may alias 'in'
+ *
+ *****************************************************************************/
+namespace detail {
+
+/// @brief p = rotate(r, p) + 2 d conj(r); q = (rw,rx,ry,rz, dw,dx,dy,dz)
+template<class P>
+inline void
+transform_packs(const P* q, P& x, P& y, P& z) noexcept
+{
+    const auto two = P::broadcast(typename P::value_type(2));
+
+    const auto tx = two * (q[0]*q[5] - q[4]*q[1] + q[2]*q[7] - q[3]*q[6]);
+    const auto ty = two * (q[0]*q[6] - q[4]*q[2] + q[3]*q[5] - q[1]*q[7]);
+    const auto tz = two * (q[0]*q[7] - q[4]*q[3] + q[1]*q[6] - q[2]*q[5]);
+
+    rotate_packs(q[0], q[1], q[2], q[3], x, y, z);
+
+    x = x + tx;
+    y = y + ty;
+    z = z + tz;
+}
+
+//---------------------------------------------------------
+template<class P, class T>
+inline void
+load_dual_quaternion_packs(const dual_quaternion_lanes<T>& q, std::size_t i,
+                           P* out) noexcept
+{
+    out[0] = P::load(q.real.w+i);
+    out[1] = P::load(q.real.x+i);
+    out[2] = P::load(q.real.y+i);
+    out[3] = P::load(q.real.z+i);
+    out[4] = P::load(q.imag.w+i);
+    out[5] = P::load(q.imag.x+i);
+    out[6] = P::load(q.imag.y+i);
+    out[7] = P::load(q.imag.z+i);
+}
+
+//---------------------------------------------------------
+template<class P, class T>
+inline void
+store_dual_quaternion_packs(const P* q, const dual_quaternion_lanes<T>& out,
+                            std::size_t i) noexcept
+{
+    q[0].store(out.real.w+i);
+    q[1].store(out.real.x+i);
+    q[2].store(out.real.y+i);
+    q[3].store(out.real.z+i);
+    q[4].store(out.imag.w+i);
+    q[5].store(out.imag.x+i);
+    q[6].store(out.imag.y+i);
+    q[7].store(out.imag.z+i);
+}
+
+} // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = transform(q, in[i]) for i in [0,n);
+///        q must be a unit dual quaternion
+/// @param numThreads  number of threads to split the work across
+///                    (1 = run on calling thread, 0 = all hardware threads)
+//-------------------------------------------------------------------
+template<class T>
+inline void
+transform_points(const dual_quaternion<T>& q, std::size_t n,
+                 const vector3_lanes<const T>& in, const vector3_lanes<T>& out,
+                 std::size_t numThreads = 1)
+{
+    const auto c = q.data();
+
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                const p_t qp[8] = {
+                    p_t::broadcast(c[0]), p_t::broadcast(c[1]),
+                    p_t::broadcast(c[2]), p_t::broadcast(c[3]),
+                    p_t::broadcast(c[4]), p_t::broadcast(c[5]),
+                    p_t::broadcast(c[6]), p_t::broadcast(c[7]) };
+                auto x = p_t::load(in.x+i);
+                auto y = p_t::load(in.y+i);
+                auto z = p_t::load(in.z+i);
+                detail::transform_packs(qp, x, y, z);
+                x.store(out.x+i);
+                y.store(out.y+i);
+                z.store(out.z+i);
+            });
+        });
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = transform(q[i], in[i]) for i in [0,n)
+template<class T>
+inline void
+transform_points(std::size_t n, const dual_quaternion_lanes<const T>& q,
+                 const vector3_lanes<const T>& in, const vector3_lanes<T>& out,
+                 std::size_t numThreads = 1)
+{
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                p_t qp[8];
+                detail::load_dual_quaternion_packs(q, i, qp);
+                auto x = p_t::load(in.x+i);
+                auto y = p_t::load(in.y+i);
+                auto z = p_t::load(in.z+i);
+                detail::transform_packs(qp, x, y, z);
+                x.store(out.x+i);
+                y.store(out.y+i);
+                z.store(out.z+i);
+            });
+        });
+}
+
+
+}  // namespace num
+}  // namespace am
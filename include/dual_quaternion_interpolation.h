@@ -0,0 +1,209 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include "dual_quaternion.h"
+#include "dual_quaternion_array.h"
+#include "simd.h"
+#include "simd_math.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief  screw linear interpolation (ScLERP) between many pairs of
+ *         unit dual quaternion keys (e.g. the segments of a trajectory)
+ *
+ * @details the screw parameters of the relative motion conj(a) b
+ *          (shortest path) are extracted once when keys are added;
+ *          evaluation only needs one sine/cosine and one fused product:
+ *            sclerp(a,b,t) = a * screw_motion(t*angle, t*pitch, axis, moment)
+ *          batch evaluation processes several key pairs per vector
+ *          instruction
+ *
+ *****************************************************************************/
+template<class NumberT>
+class sclerp_table
+{
+    static_assert(
+        is_floating_point<NumberT>::value,
+        "sclerp_table<T>: T must be a floating-point number type");
+
+    using lane_type = std::vector<NumberT,simd::aligned_allocator<NumberT>>;
+
+    //from (8), axis (3), moment (3), angle, pitch
+    static constexpr int num_lanes = 16;
+
+public:
+    //---------------------------------------------------------------
+    using numeric_type = NumberT;
+    using value_type   = dual_quaternion<numeric_type>;
+    using size_type    = std::size_t;
+
+
+    //---------------------------------------------------------------
+    sclerp_table() = default;
+
+    //-----------------------------------------------------
+    sclerp_table(const std::vector<value_type>& from,
+                 const std::vector<value_type>& to)
+    {
+        assign(from, to);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return lanes_[0].size();
+    }
+
+    //-----------------------------------------------------
+    void
+    reserve(size_type n) {
+        for(auto& l : lanes_) l.reserve(n);
+    }
+
+    //-----------------------------------------------------
+    void
+    clear() noexcept {
+        for(auto& l : lanes_) l.clear();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief replaces all keys
+    void
+    assign(const std::vector<value_type>& from,
+           const std::vector<value_type>& to)
+    {
+        assert(from.size() == to.size());
+
+        clear();
+        reserve(from.size());
+        for(size_type i = 0; i < from.size(); ++i) {
+            push_back(from[i], to[i]);
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief key pairs (keys[i], keys[i+1]) of a trajectory
+    void
+    assign_segments(const std::vector<value_type>& keys)
+    {
+        clear();
+        if(keys.size() < 2) return;
+        reserve(keys.size() - 1);
+        for(size_type i = 0; i + 1 < keys.size(); ++i) {
+            push_back(keys[i], keys[i+1]);
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief adds a key pair; both keys must be unit dual quaternions
+    void
+    push_back(const value_type& from, const value_type& to)
+    {
+        auto d = conj_times(from, to);
+        //shortest path
+        if(d.data()[0] < numeric_type(0)) d *= numeric_type(-1);
+
+        const auto s = screw_parameters(d);
+        const auto c = from.data();
+
+        for(int k = 0; k < 8; ++k) lanes_[k].push_back(c[k]);
+        for(int k = 0; k < 3; ++k) {
+            lanes_[8+k].push_back(s.axis[k]);
+            lanes_[11+k].push_back(s.moment[k]);
+        }
+        lanes_[14].push_back(s.angle);
+        lanes_[15].push_back(s.pitch);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief interpolates key pair i at t in [0,1]
+    value_type
+    operator () (size_type i, numeric_type t) const noexcept
+    {
+        using p_t = simd::pack<numeric_type,1>;
+
+        p_t r[8];
+        interpolate_packs(p_t{t}, i, r);
+        return value_type{
+            quaternion<numeric_type>{r[0].v, r[1].v, r[2].v, r[3].v},
+            quaternion<numeric_type>{r[4].v, r[5].v, r[6].v, r[7].v} };
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief out[i] = sclerp(from[i], to[i], t[i]) for i in [0,size())
+    void
+    interpolate(const numeric_type* t,
+                const dual_quaternion_lanes<numeric_type>& out) const
+    {
+        simd::for_each_pack<numeric_type>(size(), [&](auto tag, std::size_t i) {
+            using p_t = decltype(tag);
+            p_t r[8];
+            this->interpolate_packs(p_t::load(t+i), i, r);
+            detail::store_dual_quaternion_packs(r, out, i);
+        });
+    }
+
+    //-----------------------------------------------------
+    /// @brief out[i] = sclerp(from[i], to[i], t) for i in [0,size())
+    void
+    interpolate(numeric_type t,
+                const dual_quaternion_lanes<numeric_type>& out) const
+    {
+        simd::for_each_pack<numeric_type>(size(), [&](auto tag, std::size_t i) {
+            using p_t = decltype(tag);
+            p_t r[8];
+            this->interpolate_packs(p_t::broadcast(t), i, r);
+            detail::store_dual_quaternion_packs(r, out, i);
+        });
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    template<class P>
+    void
+    interpolate_packs(const P& t, size_type i, P* r) const noexcept
+    {
+        P k[num_lanes];
+        for(int l = 0; l < num_lanes; ++l) k[l] = P::load(lanes_[l].data()+i);
+
+        const auto half = P::broadcast(numeric_type(0.5)) * t;
+        P s, c;
+        simd::sincos(half * k[14], &s, &c);
+
+        P d[8];
+        detail::screw_motion(s, c, half * k[15], k+8, k+11, d);
+        detail::dual_quaternion_product(k, d, r);
+    }
+
+
+    //---------------------------------------------------------------
+    std::array<lane_type,num_lanes> lanes_;
+};
+
+
+}  // namespace num
+}  // namespace am
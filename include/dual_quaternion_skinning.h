@@ -0,0 +1,244 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "dual_quaternion.h"
+#include "dual_quaternion_array.h"
+#include "quaternion_array.h"
+#include "parallel.h"
+#include "simd.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief per-vertex bone influences of a mesh with n vertices and
+ *        'count' influences per vertex in structure-of-arrays layout:
+ *        influence k of vertex i has
+ *          bone index  bone[k*n + i]  and
+ *          weight      weight[k*n + i]
+ *
+ * @details unused slots must have weight 0 (and any valid bone index);
+ *          the weights of each vertex must not all be 0
+ *
+ *****************************************************************************/
+template<class T>
+struct skinning_influences
+{
+    const std::uint32_t* bone;
+    const T* weight;
+    std::size_t count;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  dual quaternion linear blend skinning
+ *
+ * @details for each vertex the bone dual quaternions are blended
+ *          (sign-flipped to the hemisphere of the vertex' first
+ *          influence to resolve the antipodality q ~ -q), normalized
+ *          and applied to the vertex position (and normal);
+ *          the fused pass works on packs of vertices, bone data is
+ *          gathered from a compact table of 8 scalars per bone;
+ *          vertex chunks are distributed over threads
+ *
+ *          bones must be unit dual quaternions (rigid transforms)
+ *
+ *****************************************************************************/
+template<class NumberT>
+class dual_quaternion_skinning
+{
+    using bone_type = std::array<NumberT,8>;
+
+public:
+    //---------------------------------------------------------------
+    using numeric_type = NumberT;
+    using value_type   = dual_quaternion<numeric_type>;
+    using size_type    = std::size_t;
+
+
+    //---------------------------------------------------------------
+    dual_quaternion_skinning() = default;
+
+    explicit
+    dual_quaternion_skinning(const std::vector<value_type>& bones)
+    {
+        set_bones(bones);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    bone_count() const noexcept {
+        return bones_.size();
+    }
+
+    //-----------------------------------------------------
+    void
+    set_bones(const value_type* bones, size_type n)
+    {
+        bones_.resize(n);
+        for(size_type i = 0; i < n; ++i) set_bone(i, bones[i]);
+    }
+
+    void
+    set_bones(const std::vector<value_type>& bones)
+    {
+        set_bones(bones.data(), bones.size());
+    }
+
+    //-----------------------------------------------------
+    void
+    set_bone(size_type i, const value_type& b)
+    {
+        assert(i < bones_.size());
+        std::copy(b.data(), b.data() + 8, bones_[i].begin());
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief skins n vertex positions; 'out' may alias 'in'
+    /// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+    void
+    operator () (size_type n, const skinning_influences<numeric_type>& inf,
+                 const vector3_lanes<const numeric_type>& in,
+                 const vector3_lanes<numeric_type>& out,
+                 size_type numThreads = 1) const
+    {
+        run(n, inf, in, out, nullptr, nullptr, numThreads);
+    }
+
+    //-----------------------------------------------------
+    /// @brief skins n vertex positions and normals (rotation only)
+    void
+    operator () (size_type n, const skinning_influences<numeric_type>& inf,
+                 const vector3_lanes<const numeric_type>& in,
+                 const vector3_lanes<numeric_type>& out,
+                 const vector3_lanes<const numeric_type>& normalsIn,
+                 const vector3_lanes<numeric_type>& normalsOut,
+                 size_type numThreads = 1) const
+    {
+        run(n, inf, in, out, &normalsIn, &normalsOut, numThreads);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    void
+    run(size_type n, const skinning_influences<numeric_type>& inf,
+        const vector3_lanes<const numeric_type>& in,
+        const vector3_lanes<numeric_type>& out,
+        const vector3_lanes<const numeric_type>* nin,
+        const vector3_lanes<numeric_type>* nout,
+        size_type numThreads) const
+    {
+        assert(inf.count > 0);
+
+        parallel_for_chunks(n, numThreads, 1 << 12,
+            [&](size_type b, size_type e) {
+                simd::for_each_pack<numeric_type>(e - b,
+                    [&](auto tag, size_type j) {
+                        skin_pack(decltype(tag){}, n, inf, b + j,
+                                  in, out, nin, nout);
+                    });
+            });
+    }
+
+
+    //---------------------------------------------------------------
+    template<class P>
+    void
+    skin_pack(P, size_type n, const skinning_influences<numeric_type>& inf,
+              size_type i,
+              const vector3_lanes<const numeric_type>& in,
+              const vector3_lanes<numeric_type>& out,
+              const vector3_lanes<const numeric_type>* nin,
+              const vector3_lanes<numeric_type>* nout) const noexcept
+    {
+        constexpr auto w = size_type(P::size());
+
+        //blend
+        P q[8];
+        P pivot[4];
+        P acc[8];
+        alignas(simd::max_alignment) numeric_type g[8][w];
+
+        for(size_type k = 0; k < inf.count; ++k) {
+            const auto idx = inf.bone + k*n + i;
+            for(size_type l = 0; l < w; ++l) {
+                assert(idx[l] < bones_.size());
+                const auto& src = bones_[idx[l]];
+                for(int c = 0; c < 8; ++c) g[c][l] = src[c];
+            }
+            for(int c = 0; c < 8; ++c) q[c] = P::load(g[c]);
+
+            auto wk = P::load(inf.weight + k*n + i);
+            if(k == 0) {
+                for(int c = 0; c < 4; ++c) pivot[c] = q[c];
+                for(int c = 0; c < 8; ++c) acc[c] = wk * q[c];
+            }
+            else {
+                //antipodality: use -q if it is closer to the pivot
+                const auto d = mul_add(pivot[0], q[0], mul_add(pivot[1], q[1],
+                               mul_add(pivot[2], q[2], pivot[3] * q[3])));
+                wk = copysign(wk, d);
+                for(int c = 0; c < 8; ++c) acc[c] = mul_add(wk, q[c], acc[c]);
+            }
+        }
+
+        //normalize
+        const auto one = P::broadcast(numeric_type(1));
+        const auto inv = one / sqrt(
+            mul_add(acc[0], acc[0], mul_add(acc[1], acc[1],
+            mul_add(acc[2], acc[2], acc[3] * acc[3]))));
+        for(int c = 0; c < 8; ++c) acc[c] = acc[c] * inv;
+
+        //transform
+        auto x = P::load(in.x+i);
+        auto y = P::load(in.y+i);
+        auto z = P::load(in.z+i);
+        detail::transform_packs(acc, x, y, z);
+        x.store(out.x+i);
+        y.store(out.y+i);
+        z.store(out.z+i);
+
+        if(nin) {
+            auto nx = P::load(nin->x+i);
+            auto ny = P::load(nin->y+i);
+            auto nz = P::load(nin->z+i);
+            detail::rotate_packs(acc[0], acc[1], acc[2], acc[3], nx, ny, nz);
+            nx.store(nout->x+i);
+            ny.store(nout->y+i);
+            nz.store(nout->z+i);
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    std::vector<bone_type> bones_;
+};
+
+
+}  // namespace num
+}  // namespace am
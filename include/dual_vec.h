@@ -0,0 +1,1149 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <limits>
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "traits.h"
+#include "simd.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+/// @brief tangent count of dual_vecs whose size is set at runtime
+constexpr std::size_t dynamic_size = std::size_t(-1);
+
+
+template<class,std::size_t> class dual_vec;
+
+template<class>
+struct is_dual_vec :
+    std::false_type
+{};
+
+template<class T, std::size_t N>
+struct is_dual_vec<dual_vec<T,N>> :
+    std::true_type
+{};
+
+
+
+
+/*****************************************************************************
+ *
+ * TANGENT STORAGE AND KERNELS
+ *
+ * @details tangents are stored padded to a multiple of the SIMD width;
+ *          padding lanes are always 0, so that kernels can run over
+ *          whole packs only
+ *
+ *****************************************************************************/
+namespace detail {
+
+struct uninitialized_tag {};
+
+
+//-------------------------------------------------------------------
+template<class T>
+constexpr std::size_t
+padded_tangent_count(std::size_t n) noexcept
+{
+    return ((n + simd::pack<T>::size() - 1) / simd::pack<T>::size()) *
+           simd::pack<T>::size();
+}
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+class tangent_storage
+{
+public:
+    static constexpr std::size_t capacity = padded_tangent_count<T>(N);
+
+    tangent_storage() noexcept : v_{} {}
+
+    /// @brief storage with the same size as 'like'; contents undefined
+    tangent_storage(const tangent_storage&, uninitialized_tag) noexcept {}
+
+    static constexpr std::size_t size() noexcept { return N; }
+    static constexpr std::size_t padded_size() noexcept { return capacity; }
+
+    T*       data()       noexcept { return v_; }
+    const T* data() const noexcept { return v_; }
+
+private:
+    alignas(simd::pack<T>) T v_[capacity];
+};
+
+template<class T, std::size_t N>
+constexpr std::size_t tangent_storage<T,N>::capacity;
+
+
+//---------------------------------------------------------
+template<class T>
+class tangent_storage<T,dynamic_size>
+{
+public:
+    tangent_storage() = default;
+
+    explicit
+    tangent_storage(std::size_t n):
+        v_(padded_tangent_count<T>(n), T(0)), n_{n}
+    {}
+
+    tangent_storage(const tangent_storage& like, uninitialized_tag):
+        v_(like.v_.size()), n_{like.n_}
+    {}
+
+    std::size_t size() const noexcept { return n_; }
+    std::size_t padded_size() const noexcept { return v_.size(); }
+
+    T*       data()       noexcept { return v_.data(); }
+    const T* data() const noexcept { return v_.data(); }
+
+private:
+    std::vector<T,simd::aligned_allocator<T>> v_;
+    std::size_t n_ = 0;
+};
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = s * a[i], n must be a multiple of the pack width
+template<class T>
+inline void
+tangent_scale(std::size_t n, const T& s, const T* a, T* out) noexcept
+{
+    using p_t = simd::pack<T>;
+    const auto ps = p_t::broadcast(s);
+    for(std::size_t i = 0; i < n; i += p_t::size()) {
+        (ps * p_t::load(a+i)).store(out+i);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = s * a[i] + t * b[i], n must be a multiple of the pack width
+template<class T>
+inline void
+tangent_combine(std::size_t n, const T& s, const T* a,
+                const T& t, const T* b, T* out) noexcept
+{
+    using p_t = simd::pack<T>;
+    const auto ps = p_t::broadcast(s);
+    const auto pt = p_t::broadcast(t);
+    for(std::size_t i = 0; i < n; i += p_t::size()) {
+        mul_add(ps, p_t::load(a+i), pt * p_t::load(b+i)).store(out+i);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief a[i] += s * b[i], n must be a multiple of the pack width
+template<class T>
+inline void
+tangent_add_scaled(std::size_t n, T* a, const T& s, const T* b) noexcept
+{
+    using p_t = simd::pack<T>;
+    const auto ps = p_t::broadcast(s);
+    for(std::size_t i = 0; i < n; i += p_t::size()) {
+        mul_add(ps, p_t::load(b+i), p_t::load(a+i)).store(a+i);
+    }
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  dual number with N tangents: r + sum_i e_i * d_i
+ *         (vector-mode forward automatic differentiation)
+ *
+ * @details with e_i e_j = 0 for all i,j; one evaluation of a function
+ *          on dual_vecs yields its value and all N directional
+ *          derivatives (e.g. a full gradient);
+ *          the real part is computed only once per operation, the
+ *          tangents are updated with SIMD kernels
+ *
+ * @tparam N  number of tangents or 'dynamic_size' (runtime-sized);
+ *            runtime-sized constants may have 0 tangents and are
+ *            treated as having all tangents 0
+ *
+ *****************************************************************************/
+template<class NumberType, std::size_t N = dynamic_size>
+class dual_vec
+{
+    static_assert(is_floating_point<NumberType>::value,
+        "dual_vec<T,N>: T must be a floating-point number type");
+
+    using storage_t = detail::tangent_storage<NumberType,N>;
+
+public:
+    //---------------------------------------------------------------
+    using value_type   = NumberType;
+    using numeric_type = value_type;
+    using size_type    = std::size_t;
+
+
+    //---------------------------------------------------------------
+    /// @brief zero
+    dual_vec():
+        r_{value_type(0)}, d_{}
+    {}
+
+    /// @brief constant (all tangents 0)
+    explicit
+    dual_vec(const value_type& realPart):
+        r_{realPart}, d_{}
+    {}
+
+    /// @brief independent variable number 'seed' (tangent 'seed' = 1)
+    template<std::size_t M = N, class = std::enable_if_t<M != dynamic_size>>
+    dual_vec(const value_type& realPart, size_type seed):
+        r_{realPart}, d_{}
+    {
+        assert(seed < N);
+        d_.data()[seed] = value_type(1);
+    }
+
+    /// @brief independent variable number 'seed' out of 'n' variables
+    template<std::size_t M = N, class = std::enable_if_t<M == dynamic_size>>
+    dual_vec(const value_type& realPart, size_type seed, size_type n):
+        r_{realPart}, d_(n)
+    {
+        assert(seed < n);
+        d_.data()[seed] = value_type(1);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief {r, s * x'}
+    static dual_vec
+    scaled(const value_type& r, const value_type& s, const dual_vec& x)
+    {
+        dual_vec y{r, x.d_, detail::uninitialized_tag{}};
+        detail::tangent_scale(x.d_.padded_size(), s, x.d_.data(), y.d_.data());
+        return y;
+    }
+
+    //-----------------------------------------------------
+    /// @brief {r, s * a' + t * b'}
+    static dual_vec
+    combined(const value_type& r,
+             const value_type& s, const dual_vec& a,
+             const value_type& t, const dual_vec& b)
+    {
+        if(a.size() != b.size()) {
+            assert(a.size() == 0 || b.size() == 0);
+            return (a.size() == 0) ? scaled(r, t, b) : scaled(r, s, a);
+        }
+        dual_vec y{r, a.d_, detail::uninitialized_tag{}};
+        detail::tangent_combine(a.d_.padded_size(),
+            s, a.d_.data(), t, b.d_.data(), y.d_.data());
+        return y;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr const value_type&
+    real() const noexcept {
+        return r_;
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    real(const value_type& v) noexcept {
+        r_ = v;
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    /// @brief number of tangents
+    size_type
+    size() const noexcept {
+        return d_.size();
+    }
+
+    //-----------------------------------------------------
+    const value_type&
+    tangent(size_type i) const noexcept {
+        assert(i < size());
+        return d_.data()[i];
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    tangent(size_type i, const value_type& v) noexcept {
+        assert(i < size());
+        d_.data()[i] = v;
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    /// @brief tangents [0,size()); SIMD-aligned
+    const value_type*
+    tangents() const noexcept {
+        return d_.data();
+    }
+
+
+    //---------------------------------------------------------------
+    dual_vec&
+    negate() noexcept {
+        r_ = -r_;
+        detail::tangent_scale(d_.padded_size(), value_type(-1),
+                              d_.data(), d_.data());
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // dual_vec (op)= number
+    //---------------------------------------------------------------
+    dual_vec&
+    operator += (const value_type& v) noexcept {
+        r_ += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    operator -= (const value_type& v) noexcept {
+        r_ -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    operator *= (const value_type& v) noexcept {
+        r_ *= v;
+        detail::tangent_scale(d_.padded_size(), v, d_.data(), d_.data());
+        return *this;
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    operator /= (const value_type& v) noexcept {
+        return (*this *= (value_type(1) / v));
+    }
+
+
+    //---------------------------------------------------------------
+    // dual_vec (op)= dual_vec
+    //---------------------------------------------------------------
+    dual_vec&
+    operator += (const dual_vec& o) {
+        return add_scaled(value_type(1), o);
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    operator -= (const dual_vec& o) {
+        return add_scaled(value_type(-1), o);
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    operator *= (const dual_vec& o) {
+        *this = combined(r_ * o.r_, o.r_, *this, r_, o);
+        return *this;
+    }
+    //-----------------------------------------------------
+    dual_vec&
+    operator /= (const dual_vec& o) {
+        const auto inv = value_type(1) / o.r_;
+        const auto q = r_ * inv;
+        *this = combined(q, inv, *this, -q * inv, o);
+        return *this;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    dual_vec(const value_type& r, const storage_t& like, detail::uninitialized_tag t):
+        r_{r}, d_{like, t}
+    {}
+
+    //---------------------------------------------------------------
+    dual_vec&
+    add_scaled(const value_type& s, const dual_vec& o)
+    {
+        r_ += s * o.r_;
+        if(size() == o.size()) {
+            detail::tangent_add_scaled(d_.padded_size(), d_.data(), s, o.d_.data());
+        }
+        else {
+            assert(size() == 0 || o.size() == 0);
+            if(size() == 0) *this = scaled(r_, s, o);
+        }
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type r_;
+    storage_t d_;
+};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+using dynamic_dual_vec = dual_vec<T,dynamic_size>;
+
+
+
+
+/*****************************************************************************
+ *
+ * I/O
+ *
+ *****************************************************************************/
+template<class Ostream, class T, std::size_t N>
+inline Ostream&
+operator << (Ostream& os, const dual_vec<T,N>& x)
+{
+    os << x.real();
+    for(std::size_t i = 0; i < x.size(); ++i) os << " " << x.tangent(i);
+    return os;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class Ostream>
+inline Ostream&
+print(Ostream& os, const dual_vec<T,N>& x)
+{
+    os << "(" << x.real() << ";";
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        os << (i > 0 ? "," : "") << x.tangent(i);
+    }
+    return (os << ")");
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ACCESS
+ *
+ *****************************************************************************/
+template<class T, std::size_t N>
+inline constexpr decltype(auto)
+real(const dual_vec<T,N>& x) noexcept
+{
+    return x.real();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ * @details == and != compare all parts; ordering only uses the real part
+ *
+ *****************************************************************************/
+template<class T, std::size_t N>
+inline bool
+operator == (const dual_vec<T,N>& a, const dual_vec<T,N>& b) noexcept
+{
+    if(a.real() != b.real()) return false;
+    const auto n = std::max(a.size(), b.size());
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto ai = (i < a.size()) ? a.tangent(i) : T(0);
+        const auto bi = (i < b.size()) ? b.tangent(i) : T(0);
+        if(ai != bi) return false;
+    }
+    return true;
+}
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline bool
+operator != (const dual_vec<T,N>& a, const dual_vec<T,N>& b) noexcept
+{
+    return !(a == b);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline bool
+operator < (const dual_vec<T,N>& a, const dual_vec<T,N>& b) noexcept {
+    return a.real() < b.real();
+}
+template<class T, std::size_t N>
+inline bool
+operator > (const dual_vec<T,N>& a, const dual_vec<T,N>& b) noexcept {
+    return a.real() > b.real();
+}
+template<class T, std::size_t N>
+inline bool
+operator <= (const dual_vec<T,N>& a, const dual_vec<T,N>& b) noexcept {
+    return a.real() <= b.real();
+}
+template<class T, std::size_t N>
+inline bool
+operator >= (const dual_vec<T,N>& a, const dual_vec<T,N>& b) noexcept {
+    return a.real() >= b.real();
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator < (const dual_vec<T,N>& a, const T2& b) noexcept { return a.real() < T(b); }
+
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator < (const T2& a, const dual_vec<T,N>& b) noexcept { return T(a) < b.real(); }
+
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator > (const dual_vec<T,N>& a, const T2& b) noexcept { return a.real() > T(b); }
+
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator > (const T2& a, const dual_vec<T,N>& b) noexcept { return T(a) > b.real(); }
+
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator <= (const dual_vec<T,N>& a, const T2& b) noexcept { return a.real() <= T(b); }
+
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator <= (const T2& a, const dual_vec<T,N>& b) noexcept { return T(a) <= b.real(); }
+
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator >= (const dual_vec<T,N>& a, const T2& b) noexcept { return a.real() >= T(b); }
+
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline bool
+operator >= (const T2& a, const dual_vec<T,N>& b) noexcept { return T(a) >= b.real(); }
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+// ADDITION
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+operator + (dual_vec<T,N> x, const dual_vec<T,N>& y)
+{
+    return (x += y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator + (dual_vec<T,N> x, const T2& y)
+{
+    return (x += T(y));
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator + (const T2& y, dual_vec<T,N> x)
+{
+    return (x += T(y));
+}
+
+
+//-------------------------------------------------------------------
+// SUBTRACTION
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+operator - (dual_vec<T,N> x, const dual_vec<T,N>& y)
+{
+    return (x -= y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator - (dual_vec<T,N> x, const T2& y)
+{
+    return (x -= T(y));
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator - (const T2& y, dual_vec<T,N> x)
+{
+    x.negate();
+    return (x += T(y));
+}
+
+
+//-------------------------------------------------------------------
+// MULTIPLICATION
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+operator * (const dual_vec<T,N>& x, const dual_vec<T,N>& y)
+{
+    return dual_vec<T,N>::combined(
+        x.real() * y.real(), y.real(), x, x.real(), y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator * (const dual_vec<T,N>& x, const T2& y)
+{
+    return dual_vec<T,N>::scaled(x.real() * T(y), T(y), x);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator * (const T2& y, const dual_vec<T,N>& x)
+{
+    return dual_vec<T,N>::scaled(T(y) * x.real(), T(y), x);
+}
+
+
+//-------------------------------------------------------------------
+// DIVISION
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+operator / (const dual_vec<T,N>& x, const dual_vec<T,N>& y)
+{
+    const auto inv = T(1) / y.real();
+    const auto q = x.real() * inv;
+    return dual_vec<T,N>::combined(q, inv, x, -q * inv, y);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator / (const dual_vec<T,N>& x, const T2& y)
+{
+    const auto inv = T(1) / T(y);
+    return dual_vec<T,N>::scaled(x.real() * inv, inv, x);
+}
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+operator / (const T2& y, const dual_vec<T,N>& x)
+{
+    const auto inv = T(1) / x.real();
+    const auto q = T(y) * inv;
+    return dual_vec<T,N>::scaled(q, -q * inv, x);
+}
+
+
+//-------------------------------------------------------------------
+// INVERSION
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+operator - (dual_vec<T,N> x)
+{
+    return x.negate();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * FUNCTIONS
+ *
+ * @note f(r + sum_i e_i d_i) = f(r) + f'(r) * sum_i e_i d_i
+ *       f(r) and f'(r) are computed once for all tangents
+ *
+ *****************************************************************************/
+namespace detail {
+
+/// @brief {f(r), f'(r) * x'}
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+chain(const dual_vec<T,N>& x, const T& f, const T& df)
+{
+    return dual_vec<T,N>::scaled(f, df, x);
+}
+
+}  // namespace detail
+
+
+//-------------------------------------------------------------------
+/// @brief tangents are 0 (piecewise constant)
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+ceil(const dual_vec<T,N>& x)
+{
+    using std::ceil;
+    return detail::chain(x, T(ceil(x.real())), T(0));
+}
+
+//---------------------------------------------------------
+/// @brief tangents are 0 (piecewise constant)
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+floor(const dual_vec<T,N>& x)
+{
+    using std::floor;
+    return detail::chain(x, T(floor(x.real())), T(0));
+}
+
+
+//-------------------------------------------------------------------
+// ABSOLUTE
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+abs(const dual_vec<T,N>& x)
+{
+    return (x.real() < T(0)) ? -x : x;
+}
+
+//---------------------------------------------------------
+/// @brief magnitude squared
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+abs2(const dual_vec<T,N>& x)
+{
+    return detail::chain(x, x.real() * x.real(), T(2) * x.real());
+}
+
+
+
+//-------------------------------------------------------------------
+// ROOTS
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+sqrt(const dual_vec<T,N>& x)
+{
+    using std::sqrt;
+    const auto s = sqrt(x.real());
+    return detail::chain(x, s, T(1) / (T(2) * s));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+cbrt(const dual_vec<T,N>& x)
+{
+    using std::cbrt;
+    const auto c = cbrt(x.real());
+    return detail::chain(x, c, T(1) / (T(3) * c * c));
+}
+
+
+
+//-------------------------------------------------------------------
+// EXPONENTIATION
+//-------------------------------------------------------------------
+/// @brief b^e = exp(e log b); d(b^e) = e b^(e-1) db + b^e log(b) de
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+pow(const dual_vec<T,N>& b, const dual_vec<T,N>& e)
+{
+    using std::pow;
+    using std::log;
+    const auto p = pow(b.real(), e.real());
+    return dual_vec<T,N>::combined(p,
+        e.real() * pow(b.real(), e.real() - T(1)), b, p * log(b.real()), e);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+pow(const dual_vec<T,N>& b, const T2& e)
+{
+    using std::pow;
+    const auto p = pow(b.real(), T(e) - T(1));
+    return detail::chain(b, p * b.real(), T(e) * p);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    is_number<T2>::value && !is_dual_vec<T2>::value>>
+inline dual_vec<T,N>
+pow(const T2& b, const dual_vec<T,N>& e)
+{
+    using std::pow;
+    using std::log;
+    const auto p = pow(T(b), e.real());
+    return detail::chain(e, p, p * T(log(T(b))));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+exp(const dual_vec<T,N>& x)
+{
+    using std::exp;
+    const auto e = exp(x.real());
+    return detail::chain(x, e, e);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+exp2(const dual_vec<T,N>& x)
+{
+    using std::exp2;
+    const auto e = exp2(x.real());
+    return detail::chain(x, e,
+        e * T(0.69314718055994530941723212145817656807550013436026));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+expm1(const dual_vec<T,N>& x)
+{
+    using std::expm1;
+    const auto e = expm1(x.real());
+    return detail::chain(x, e, e + T(1));
+}
+
+
+
+//-------------------------------------------------------------------
+// LOGARITHMS
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+log(const dual_vec<T,N>& x)
+{
+    using std::log;
+    return detail::chain(x, log(x.real()), T(1) / x.real());
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+log10(const dual_vec<T,N>& x)
+{
+    using std::log10;
+    return detail::chain(x, log10(x.real()), T(1) /
+        (x.real() * T(2.3025850929940456840179914546843642076011014886288)));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+log2(const dual_vec<T,N>& x)
+{
+    using std::log2;
+    return detail::chain(x, log2(x.real()), T(1) /
+        (x.real() * T(0.69314718055994530941723212145817656807550013436026)));
+}
+
+//---------------------------------------------------------
+/// @brief logarithm to floating-point basis (FLT_RADIX)
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+logb(const dual_vec<T,N>& x)
+{
+    using std::logb;
+    using std::log;
+    return detail::chain(x, logb(x.real()),
+        T(1) / (x.real() * log(T(FLT_RADIX))));
+}
+
+//---------------------------------------------------------
+/// @brief log(1 + x)
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+log1p(const dual_vec<T,N>& x)
+{
+    using std::log1p;
+    return detail::chain(x, log1p(x.real()), T(1) / (T(1) + x.real()));
+}
+
+//---------------------------------------------------------
+/// @brief logarithm to any base
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+log_base(const T& base, const dual_vec<T,N>& x)
+{
+    using std::log;
+    const auto logbase_inv = T(1) / log(base);
+    return detail::chain(x, log(x.real()) * logbase_inv,
+                         logbase_inv / x.real());
+}
+
+
+
+//-------------------------------------------------------------------
+// TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+sin(const dual_vec<T,N>& x)
+{
+    using std::sin;
+    using std::cos;
+    return detail::chain(x, sin(x.real()), cos(x.real()));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+cos(const dual_vec<T,N>& x)
+{
+    using std::sin;
+    using std::cos;
+    return detail::chain(x, cos(x.real()), -sin(x.real()));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+tan(const dual_vec<T,N>& x)
+{
+    using std::tan;
+    const auto t = tan(x.real());
+    return detail::chain(x, t, T(1) + t * t);
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+asin(const dual_vec<T,N>& x)
+{
+    using std::asin;
+    using std::sqrt;
+    return detail::chain(x, asin(x.real()),
+        T(1) / sqrt(T(1) - x.real() * x.real()));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+acos(const dual_vec<T,N>& x)
+{
+    using std::acos;
+    using std::sqrt;
+    return detail::chain(x, acos(x.real()),
+        T(-1) / sqrt(T(1) - x.real() * x.real()));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+atan(const dual_vec<T,N>& x)
+{
+    using std::atan;
+    return detail::chain(x, atan(x.real()),
+        T(1) / (T(1) + x.real() * x.real()));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+atan2(const dual_vec<T,N>& y, const dual_vec<T,N>& x)
+{
+    using std::atan2;
+    const auto inv = T(1) / (x.real() * x.real() + y.real() * y.real());
+    return dual_vec<T,N>::combined(atan2(y.real(), x.real()),
+        x.real() * inv, y, -y.real() * inv, x);
+}
+
+
+
+//-------------------------------------------------------------------
+// HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+sinh(const dual_vec<T,N>& x)
+{
+    using std::sinh;
+    using std::cosh;
+    return detail::chain(x, sinh(x.real()), cosh(x.real()));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+cosh(const dual_vec<T,N>& x)
+{
+    using std::sinh;
+    using std::cosh;
+    return detail::chain(x, cosh(x.real()), sinh(x.real()));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+tanh(const dual_vec<T,N>& x)
+{
+    using std::tanh;
+    const auto t = tanh(x.real());
+    return detail::chain(x, t, T(1) - t * t);
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+asinh(const dual_vec<T,N>& x)
+{
+    using std::asinh;
+    using std::sqrt;
+    return detail::chain(x, asinh(x.real()),
+        T(1) / sqrt(x.real() * x.real() + T(1)));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+acosh(const dual_vec<T,N>& x)
+{
+    using std::acosh;
+    using std::sqrt;
+    return detail::chain(x, acosh(x.real()),
+        T(1) / sqrt(x.real() * x.real() - T(1)));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+atanh(const dual_vec<T,N>& x)
+{
+    using std::atanh;
+    return detail::chain(x, atanh(x.real()),
+        T(1) / (T(1) - x.real() * x.real()));
+}
+
+
+
+//-------------------------------------------------------------------
+//
+//-------------------------------------------------------------------
+///@brief  error function
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+erf(const dual_vec<T,N>& x)
+{
+    using std::erf;
+    using std::exp;
+    return detail::chain(x, erf(x.real()), exp(-x.real() * x.real()) *
+        T(1.1283791670955125738961589031215451716881012586580));
+}
+
+//---------------------------------------------------------
+///@brief complementary error function
+template<class T, std::size_t N>
+inline dual_vec<T,N>
+erfc(const dual_vec<T,N>& x)
+{
+    using std::erfc;
+    using std::exp;
+    return detail::chain(x, erfc(x.real()), -exp(-x.real() * x.real()) *
+        T(1.1283791670955125738961589031215451716881012586580));
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline bool
+isfinite(const dual_vec<T,N>& x)
+{
+    using std::isfinite;
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        if(!isfinite(x.tangent(i))) return false;
+    }
+    return isfinite(x.real());
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline bool
+isinf(const dual_vec<T,N>& x)
+{
+    using std::isinf;
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        if(isinf(x.tangent(i))) return true;
+    }
+    return isinf(x.real());
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline bool
+isnan(const dual_vec<T,N>& x)
+{
+    using std::isnan;
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        if(isnan(x.tangent(i))) return true;
+    }
+    return isnan(x.real());
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T, std::size_t N>
+struct is_number<dual_vec<T,N>> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<dual_vec<T,N>&> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<dual_vec<T,N>&&> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<const dual_vec<T,N>&> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<const dual_vec<T,N>> : std::true_type {};
+
+
+}  // namespace num
+}  // namespace am
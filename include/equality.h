@@ -79,6 +79,22 @@ approx_equal(
 
 
 
+//-------------------------------------------------------------------
+/// @brief relative comparison: |a-b| <= tolerance * max(1,|a|,|b|)
+///        (absolute for magnitudes below 1)
+template<class T, class = std::enable_if_t<std::is_floating_point<T>::value>>
+inline constexpr bool
+rel_approx_equal(const T& a, const T& b, const T& tolerance = num::tolerance<T>)
+{
+    const auto d  = (a < b) ? (b - a) : (a - b);
+    const auto ma = (a < T(0)) ? -a : a;
+    const auto mb = (b < T(0)) ? -b : b;
+    const auto m  = (ma < mb) ? mb : ma;
+    return d <= tolerance * ((m < T(1)) ? T(1) : m);
+}
+
+
+
 //-------------------------------------------------------------------
 template<class T1, class T2>
 inline constexpr bool
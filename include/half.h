@@ -0,0 +1,307 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if !defined(AM_NUMERIC_NO_SIMD) && defined(__F16C__)
+    #include <immintrin.h>
+#endif
+
+#include "traits.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * BINARY16 <-> BINARY32 CONVERSION
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief IEEE 754 binary16 bits of x; rounds to nearest even,
+///        overflows to infinity, keeps NaNs quiet
+inline std::uint16_t
+float_to_half_bits(float x) noexcept
+{
+    std::uint32_t f;
+    std::memcpy(&f, &x, sizeof(f));
+
+    const auto sign = (f >> 16) & 0x8000u;
+    f &= 0x7fffffffu;
+
+    std::uint32_t h;
+    if(f >= 0x47800000u) {
+        //inf / NaN / too large
+        h = (f > 0x7f800000u) ? 0x7e00u : 0x7c00u;
+    }
+    else if(f < 0x38800000u) {
+        //subnormal or zero: let the FPU round at 2^-24 granularity
+        float a;
+        std::memcpy(&a, &f, sizeof(a));
+        a += 0.5f;
+        std::memcpy(&h, &a, sizeof(h));
+        h -= 0x3f000000u;
+    }
+    else {
+        //normal: rebias exponent, round mantissa to nearest even
+        const auto odd = (f >> 13) & 1u;
+        f += 0xc8000fffu + odd;
+        h = f >> 13;
+    }
+    return std::uint16_t(sign | h);
+}
+
+//---------------------------------------------------------
+/// @brief value of IEEE 754 binary16 bits (exact)
+inline float
+half_bits_to_float(std::uint16_t h) noexcept
+{
+    const auto sign = (h & 0x8000u) << 16;
+    const auto expo = std::uint32_t(h >> 10) & 0x1fu;
+    const auto mant = h & 0x3ffu;
+
+    std::uint32_t f;
+    if(expo == 0) {
+        //zero or subnormal: mant * 2^-24
+        float a = float(mant) * (1.0f / 16777216.0f);
+        std::memcpy(&f, &a, sizeof(f));
+        f |= sign;
+    }
+    else if(expo == 0x1fu) {
+        f = sign | 0x7f800000u | (mant << 13);
+    }
+    else {
+        f = sign | ((expo + 112u) << 23) | (mant << 13);
+    }
+    float x;
+    std::memcpy(&x, &f, sizeof(x));
+    return x;
+}
+
+//---------------------------------------------------------
+/// @brief x rounded to float with round-to-odd (inexact results get an
+///        odd last mantissa bit); rounding that float to binary16 then
+///        yields the correctly rounded binary16 value of x, i.e. there
+///        is no double rounding error
+template<class T>
+inline float
+round_to_odd_float(const T& x) noexcept
+{
+    auto f = static_cast<float>(x);
+    std::uint32_t b;
+    std::memcpy(&b, &f, sizeof(b));
+    if((b & 1u) == 0 && static_cast<T>(f) != x) {
+        const auto inf = std::numeric_limits<float>::infinity();
+        f = std::nextafter(f, (static_cast<T>(f) < x) ? inf : -inf);
+    }
+    return f;
+}
+
+//---------------------------------------------------------
+/// @brief types wider than float
+template<class T>
+inline float
+narrow_to_float(const T& x, std::true_type) noexcept
+{
+    return round_to_odd_float(x);
+}
+
+//---------------------------------------------------------
+/// @brief float and types that convert to float exactly enough
+template<class T>
+inline float
+narrow_to_float(const T& x, std::false_type) noexcept
+{
+    return static_cast<float>(x);
+}
+
+//---------------------------------------------------------
+/// @brief x as float, such that rounding the result to binary16
+///        gives the correctly rounded binary16 value of x
+template<class T>
+inline float
+narrow_to_float(const T& x) noexcept
+{
+    return narrow_to_float(x, std::integral_constant<bool,
+        std::is_floating_point<T>::value &&
+        (std::numeric_limits<T>::digits > std::numeric_limits<float>::digits)>{});
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  IEEE 754 binary16 storage type
+ *
+ * @details converts implicitly to float and from all arithmetic types,
+ *          so that all arithmetic is carried out in (at least) float
+ *          precision; common_numeric_t<half,half> is float,
+ *          so e.g. quaternion<half> * quaternion<half> yields a
+ *          quaternion<float>
+ *
+ *          relative rounding error is at most 2^-11 in the normal range
+ *          (|x| >= 2^-14), absolute error at most 2^-25 below;
+ *          largest finite value: 65504
+ *
+ *****************************************************************************/
+class half
+{
+public:
+    //---------------------------------------------------------------
+    using numeric_type = half;
+    using value_type   = half;
+
+
+    //---------------------------------------------------------------
+    constexpr
+    half() noexcept : bits_{0} {}
+
+    /// @brief rounds to nearest even; double and long double are
+    ///        narrowed to float with round-to-odd first, so that the
+    ///        result is correctly rounded
+    template<class T, class = std::enable_if_t<std::is_arithmetic<T>::value>>
+    half(const T& x) noexcept :
+        bits_{detail::float_to_half_bits(detail::narrow_to_float(x))}
+    {}
+
+
+    //---------------------------------------------------------------
+    static constexpr half
+    from_bits(std::uint16_t bits) noexcept {
+        half h;
+        h.bits_ = bits;
+        return h;
+    }
+
+    //-----------------------------------------------------
+    constexpr std::uint16_t
+    bits() const noexcept {
+        return bits_;
+    }
+
+
+    //---------------------------------------------------------------
+    operator float() const noexcept {
+        return detail::half_bits_to_float(bits_);
+    }
+
+
+private:
+    std::uint16_t bits_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * BATCH CONVERSION
+ *
+ * @details uses the F16C instructions if available
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief out[i] = half(in[i]) for i in [0,n)
+inline void
+to_half(std::size_t n, const float* in, half* out) noexcept
+{
+    std::size_t i = 0;
+#if !defined(AM_NUMERIC_NO_SIMD) && defined(__F16C__)
+    for(; (i + 8) <= n; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out+i),
+            _mm256_cvtps_ph(_mm256_loadu_ps(in+i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for(; i < n; ++i) out[i] = half(in[i]);
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = float(in[i]) for i in [0,n)
+inline void
+to_float(std::size_t n, const half* in, float* out) noexcept
+{
+    std::size_t i = 0;
+#if !defined(AM_NUMERIC_NO_SIMD) && defined(__F16C__)
+    for(; (i + 8) <= n; i += 8) {
+        _mm256_storeu_ps(out+i, _mm256_cvtph_ps(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in+i))));
+    }
+#endif
+    for(; i < n; ++i) out[i] = float(in[i]);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<>
+struct is_number<half> : std::true_type {};
+
+template<>
+struct is_number<half&> : std::true_type {};
+
+template<>
+struct is_number<half&&> : std::true_type {};
+
+template<>
+struct is_number<const half&> : std::true_type {};
+
+template<>
+struct is_number<const half> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<>
+struct is_floating_point<half> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<class T2>
+struct common_numeric_type<half,T2>
+{
+    using type = common_numeric_t<float,T2>;
+};
+//---------------------------------------------------------
+template<class T2>
+struct common_numeric_type<T2,half>
+{
+    using type = common_numeric_t<float,T2>;
+};
+//---------------------------------------------------------
+template<>
+struct common_numeric_type<half,half>
+{
+    using type = float;
+};
+
+
+}  // namespace num
+}  // namespace am
@@ -0,0 +1,1554 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cfloat>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "traits.h"
+#include "dual_vec.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class> class hyper_dual;
+
+template<class>
+struct is_hyper_dual :
+    std::false_type
+{};
+
+template<class T>
+struct is_hyper_dual<hyper_dual<T>> :
+    std::true_type
+{};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * represents a hyper-dual number r + e1 * a + e2 * b + e1e2 * c where
+ * e1 and e2 are dual units with e1*e1 = e2*e2 = 0 and e1*e2 = e2*e1 != 0
+ *
+ * @details f(r + e1 a + e2 b + e1e2 c) =
+ *            f(r) + f'(r) (e1 a + e2 b) + (f'(r) c + f''(r) a b) e1e2
+ *
+ *          seeding x = {x0,1,0,0} and y = {y0,0,1,0} yields
+ *          f, df/dx, df/dy and d2f/dxdy in one evaluation;
+ *          x = {x0,1,1,0} yields d2f/dx2 (truncation-error free)
+ *
+ *****************************************************************************/
+template<class NumberType>
+class hyper_dual
+{
+public:
+
+    static_assert(is_number<NumberType>::value,
+        "hyper_dual<T>: T must be a number type");
+
+    static_assert(!is_hyper_dual<NumberType>::value,
+        "hyper_dual<T>: T must not be a hyper_dual<> type itself");
+
+
+    //---------------------------------------------------------------
+    using value_type      = NumberType;
+    using numeric_type    = value_type;
+
+
+    //---------------------------------------------------------------
+    /// @brief default constructor
+    constexpr
+    hyper_dual() = default;
+
+    /// @brief
+    explicit constexpr
+    hyper_dual(const value_type& a):
+        r_{a}, e1_(0), e2_(0), e12_(0)
+    {}
+
+    /// @brief
+    constexpr
+    hyper_dual(const value_type& realPart,
+               const value_type& e1Part, const value_type& e2Part,
+               const value_type& e1e2Part):
+        r_{realPart}, e1_{e1Part}, e2_{e2Part}, e12_{e1e2Part}
+    {}
+
+    /// @brief from hyper_dual with different value_type
+    template<class T>
+    explicit constexpr
+    hyper_dual(const hyper_dual<T>& x):
+        r_(x.real()), e1_(x.e1()), e2_(x.e2()), e12_(x.e1e2())
+    {}
+
+
+    //---------------------------------------------------------------
+    constexpr
+    hyper_dual(const hyper_dual&) = default;
+
+    constexpr
+    hyper_dual(hyper_dual&&) = default;
+
+
+    //---------------------------------------------------------------
+    constexpr hyper_dual&
+    operator = (const hyper_dual&) = default;
+
+    constexpr hyper_dual&
+    operator = (hyper_dual&&) = default;
+
+
+    //-----------------------------------------------------
+    constexpr hyper_dual&
+    operator = (const value_type& realPart)
+    {
+        r_ = realPart;
+        e1_ = value_type(0);
+        e2_ = value_type(0);
+        e12_ = value_type(0);
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr const value_type&
+    real() const noexcept {
+        return r_;
+    }
+
+    constexpr const value_type&
+    e1() const noexcept {
+        return e1_;
+    }
+
+    constexpr const value_type&
+    e2() const noexcept {
+        return e2_;
+    }
+
+    constexpr const value_type&
+    e1e2() const noexcept {
+        return e12_;
+    }
+
+    constexpr hyper_dual&
+    real(const value_type& v) noexcept {
+        r_ = v;
+        return *this;
+    }
+
+    constexpr hyper_dual&
+    e1(const value_type& v) noexcept {
+        e1_ = v;
+        return *this;
+    }
+
+    constexpr hyper_dual&
+    e2(const value_type& v) noexcept {
+        e2_ = v;
+        return *this;
+    }
+
+    constexpr hyper_dual&
+    e1e2(const value_type& v) noexcept {
+        e12_ = v;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr hyper_dual&
+    negate() noexcept {
+        r_ = -r_;
+        e1_ = -e1_;
+        e2_ = -e2_;
+        e12_ = -e12_;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // hyper_dual (op)= number
+    //---------------------------------------------------------------
+    constexpr hyper_dual&
+    operator += (const value_type& v) {
+        r_ += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr hyper_dual&
+    operator -= (const value_type& v) {
+        r_ -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr hyper_dual&
+    operator *= (const value_type& v) {
+        r_ *= v;
+        e1_ *= v;
+        e2_ *= v;
+        e12_ *= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr hyper_dual&
+    operator /= (const value_type& v) {
+        r_ /= v;
+        e1_ /= v;
+        e2_ /= v;
+        e12_ /= v;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // hyper_dual (op)= hyper_dual
+    //---------------------------------------------------------------
+    constexpr hyper_dual&
+    operator += (const hyper_dual& o) {
+        r_ += o.r_;
+        e1_ += o.e1_;
+        e2_ += o.e2_;
+        e12_ += o.e12_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr hyper_dual&
+    operator -= (const hyper_dual& o) {
+        r_ -= o.r_;
+        e1_ -= o.e1_;
+        e2_ -= o.e2_;
+        e12_ -= o.e12_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr hyper_dual&
+    operator *= (const hyper_dual& o)
+    {
+        e12_ = r_ * o.e12_ + e12_ * o.r_ + e1_ * o.e2_ + e2_ * o.e1_;
+        e1_  = r_ * o.e1_ + e1_ * o.r_;
+        e2_  = r_ * o.e2_ + e2_ * o.r_;
+        r_  *= o.r_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr hyper_dual&
+    operator /= (const hyper_dual& o)
+    {
+        //x * (1/y) with 1/y = {1/r, -a/r^2, -b/r^2, 2ab/r^3 - c/r^2}
+        const auto inv = value_type(1) / o.r_;
+        const auto inv2 = inv * inv;
+        return *this *= hyper_dual{inv, -o.e1_ * inv2, -o.e2_ * inv2,
+            (value_type(2) * o.e1_ * o.e2_ * inv - o.e12_) * inv2};
+    }
+
+
+private:
+
+    //---------------------------------------------------------------
+    value_type r_;
+    value_type e1_;
+    value_type e2_;
+    value_type e12_;
+
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class T, class = std::enable_if_t<
+    !is_hyper_dual<T>::value && is_number<T>::value>>
+inline constexpr auto
+make_hyper_dual(const T& x)
+{
+    return hyper_dual<T>{x};
+}
+
+//---------------------------------------------------------------
+template<class T1, class T2, class T3, class T4>
+inline constexpr auto
+make_hyper_dual(const T1& r, const T2& e1, const T3& e2, const T4& e1e2)
+{
+    using T = common_numeric_t<T1,T2,T3,T4>;
+    return hyper_dual<T>{T(r), T(e1), T(e2), T(e1e2)};
+}
+
+
+
+//-------------------------------------------------------------------
+// I/O
+//-------------------------------------------------------------------
+template<class Istream, class T>
+inline Istream&
+operator >> (Istream& is, hyper_dual<T>& x)
+{
+    T r, a, b, c;
+    is >> r >> a >> b >> c;
+    x = hyper_dual<T>{r, a, b, c};
+    return is;
+}
+
+//---------------------------------------------------------
+template<class Ostream, class T>
+inline Ostream&
+operator << (Ostream& os, const hyper_dual<T>& x)
+{
+    return (os << x.real() << " " << x.e1() << " " << x.e2() << " " << x.e1e2());
+}
+
+//---------------------------------------------------------
+template<class T, class Ostream>
+inline Ostream&
+print(Ostream& os, const hyper_dual<T>& x)
+{
+    return (os << "(" << x.real() << "," << x.e1() << ","
+                      << x.e2() << "," << x.e1e2() << ")" );
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ACCESS
+ *
+ *****************************************************************************/
+template<class T>
+inline constexpr decltype(auto)
+real(const hyper_dual<T>& x) noexcept
+{
+    return x.real();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ * @details == and != compare all parts; ordering only uses the real part
+ *
+ *****************************************************************************/
+template<class T1, class T2>
+inline constexpr bool
+operator == (const hyper_dual<T1>& a, const hyper_dual<T2>& b)
+{
+    return a.real() == b.real() && a.e1() == b.e1() &&
+           a.e2() == b.e2() && a.e1e2() == b.e1e2();
+}
+
+//---------------------------------------------------------
+template<class T1, class T2>
+inline constexpr bool
+operator != (const hyper_dual<T1>& a, const hyper_dual<T2>& b)
+{
+    return !(a == b);
+}
+
+//---------------------------------------------------------
+template<class T1, class T2>
+inline constexpr bool
+operator < (const hyper_dual<T1>& a, const hyper_dual<T2>& b) {
+    return a.real() < b.real();
+}
+template<class T1, class T2>
+inline constexpr bool
+operator > (const hyper_dual<T1>& a, const hyper_dual<T2>& b) {
+    return a.real() > b.real();
+}
+template<class T1, class T2>
+inline constexpr bool
+operator <= (const hyper_dual<T1>& a, const hyper_dual<T2>& b) {
+    return a.real() <= b.real();
+}
+template<class T1, class T2>
+inline constexpr bool
+operator >= (const hyper_dual<T1>& a, const hyper_dual<T2>& b) {
+    return a.real() >= b.real();
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator < (const hyper_dual<T1>& x, const T2& r) { return x.real() < r; }
+
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator < (const T2& r, const hyper_dual<T1>& x) { return r < x.real(); }
+
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator > (const hyper_dual<T1>& x, const T2& r) { return x.real() > r; }
+
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator > (const T2& r, const hyper_dual<T1>& x) { return r > x.real(); }
+
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator <= (const hyper_dual<T1>& x, const T2& r) { return x.real() <= r; }
+
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator <= (const T2& r, const hyper_dual<T1>& x) { return r <= x.real(); }
+
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator >= (const hyper_dual<T1>& x, const T2& r) { return x.real() >= r; }
+
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator >= (const T2& r, const hyper_dual<T1>& x) { return r >= x.real(); }
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+// ADDITION
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline constexpr auto
+operator + (const hyper_dual<T1>& x, const hyper_dual<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} += hyper_dual<T>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator + (const hyper_dual<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} += T(y);
+}
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator + (const T2& y, const hyper_dual<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} += T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+// SUBTRACTION
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline constexpr auto
+operator - (const hyper_dual<T1>& x, const hyper_dual<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} -= hyper_dual<T>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator - (const hyper_dual<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} -= T(y);
+}
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator - (const T2& y, const hyper_dual<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x}.negate() += T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+// MULTIPLICATION
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline constexpr auto
+operator * (const hyper_dual<T1>& x, const hyper_dual<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} *= hyper_dual<T>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator * (const hyper_dual<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} *= T(y);
+}
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator * (const T2& y, const hyper_dual<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} *= T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+// DIVISION
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline constexpr auto
+operator / (const hyper_dual<T1>& x, const hyper_dual<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} /= hyper_dual<T>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator / (const hyper_dual<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{x} /= T(y);
+}
+//---------------------------------------------------------
+template<class T1, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator / (const T2& y, const hyper_dual<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return hyper_dual<T>{T(y)} /= hyper_dual<T>{x};
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSION
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator - (hyper_dual<T> x)
+{
+    return x.negate();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * FUNCTIONS
+ *
+ * @note every function only supplies f(r), f'(r) and f''(r)
+ *       (and the partial derivatives for functions of two arguments)
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief second-order chain rule for f(x)
+template<class T>
+inline constexpr hyper_dual<T>
+chain2(const hyper_dual<T>& x, const T& f, const T& df, const T& d2f)
+{
+    return hyper_dual<T>{f, df * x.e1(), df * x.e2(),
+                         df * x.e1e2() + d2f * x.e1() * x.e2()};
+}
+
+//---------------------------------------------------------
+/// @brief second-order chain rule for f(x,y)
+/// @param fx,fy          first partial derivatives
+/// @param fxx,fxy,fyy    second partial derivatives
+template<class T>
+inline constexpr hyper_dual<T>
+chain2(const hyper_dual<T>& x, const hyper_dual<T>& y, const T& f,
+       const T& fx, const T& fy, const T& fxx, const T& fxy, const T& fyy)
+{
+    return hyper_dual<T>{f,
+        fx * x.e1() + fy * y.e1(),
+        fx * x.e2() + fy * y.e2(),
+        fx * x.e1e2() + fy * y.e1e2() +
+            fxx * x.e1() * x.e2() +
+            fxy * (x.e1() * y.e2() + y.e1() * x.e2()) +
+            fyy * y.e1() * y.e2() };
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+ceil(const hyper_dual<T>& x)
+{
+    using std::ceil;
+    return hyper_dual<T>{T(ceil(x.real()))};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+floor(const hyper_dual<T>& x)
+{
+    using std::floor;
+    return hyper_dual<T>{T(floor(x.real()))};
+}
+
+
+//-------------------------------------------------------------------
+// ABSOLUTE
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+abs(const hyper_dual<T>& x)
+{
+    return (x.real() < T(0)) ? -x : x;
+}
+
+//---------------------------------------------------------
+/// @brief magnitude squared
+template<class T>
+inline auto
+abs2(const hyper_dual<T>& x)
+{
+    return detail::chain2(x, x.real() * x.real(), T(2) * x.real(), T(2));
+}
+
+
+
+//-------------------------------------------------------------------
+// ROOTS
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+sqrt(const hyper_dual<T>& x)
+{
+    using std::sqrt;
+    const auto s = sqrt(x.real());
+    const auto d = T(1) / (T(2) * s);
+    return detail::chain2(x, s, d, -d / (T(2) * x.real()));
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+cbrt(const hyper_dual<T>& x)
+{
+    using std::cbrt;
+    const auto c = cbrt(x.real());
+    const auto d = T(1) / (T(3) * c * c);
+    return detail::chain2(x, c, d, T(-2) * d / (T(3) * x.real()));
+}
+
+
+
+//-------------------------------------------------------------------
+// EXPONENTIATION
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+pow(const hyper_dual<T>& b, const hyper_dual<T>& e)
+{
+    using std::pow;
+    using std::log;
+    const auto x = b.real(), y = e.real();
+    const auto lx = log(x);
+    const auto p1 = pow(x, y - T(1));
+    const auto p = p1 * x;
+    return detail::chain2(b, e, p,
+        y * p1, p * lx,
+        y * (y - T(1)) * p1 / x, p1 * (T(1) + y * lx), p * lx * lx);
+}
+
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline auto
+pow(const hyper_dual<T>& b, const T2& e)
+{
+    using std::pow;
+    const auto x = b.real();
+    const auto y = T(e);
+    //derivatives of x^0 and x^1 that vanish identically are set
+    //explicitly, so that x = 0 doesn't give 0 * inf
+    const auto d1 = (y == T(0)) ? T(0) : y * pow(x, y - T(1));
+    const auto d2 = (y == T(0) || y == T(1))
+                  ? T(0) : y * (y - T(1)) * pow(x, y - T(2));
+    return detail::chain2(b, pow(x, y), d1, d2);
+}
+
+//---------------------------------------------------------
+template<class T, class T2, class = std::enable_if_t<
+    !is_hyper_dual<T2>::value && is_number<T2>::value>>
+inline auto
+pow(const T2& b, const hyper_dual<T>& e)
+{
+    using std::pow;
+    using std::log;
+    const auto p = pow(T(b), e.real());
+    const auto lb = T(log(T(b)));
+    return detail::chain2(e, p, p * lb, p * lb * lb);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+exp(const hyper_dual<T>& x)
+{
+    using std::exp;
+    const auto e = exp(x.real());
+    return detail::chain2(x, e, e, e);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+exp2(const hyper_dual<T>& x)
+{
+    using std::exp2;
+    const auto ln2 = T(0.69314718055994530941723212145817656807550013436026);
+    const auto e = exp2(x.real());
+    return detail::chain2(x, e, e * ln2, e * ln2 * ln2);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+expm1(const hyper_dual<T>& x)
+{
+    using std::expm1;
+    const auto e = expm1(x.real());
+    return detail::chain2(x, e, e + T(1), e + T(1));
+}
+
+
+
+//-------------------------------------------------------------------
+// LOGARITHMS
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+log(const hyper_dual<T>& x)
+{
+    using std::log;
+    const auto d = T(1) / x.real();
+    return detail::chain2(x, log(x.real()), d, -d * d);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+log10(const hyper_dual<T>& x)
+{
+    using std::log10;
+    const auto d = T(1) / x.real();
+    const auto s = T(1) / T(2.3025850929940456840179914546843642076011014886288);
+    return detail::chain2(x, log10(x.real()), d * s, -d * d * s);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+log2(const hyper_dual<T>& x)
+{
+    using std::log2;
+    const auto d = T(1) / x.real();
+    const auto s = T(1) / T(0.69314718055994530941723212145817656807550013436026);
+    return detail::chain2(x, log2(x.real()), d * s, -d * d * s);
+}
+
+//---------------------------------------------------------
+/// @brief logarithm to floating-point basis (FLT_RADIX)
+template<class T>
+inline auto
+logb(const hyper_dual<T>& x)
+{
+    using std::logb;
+    using std::log;
+    const auto d = T(1) / x.real();
+    const auto s = T(1) / log(T(FLT_RADIX));
+    return detail::chain2(x, logb(x.real()), d * s, -d * d * s);
+}
+
+//---------------------------------------------------------
+/// @brief log(1 + x)
+template<class T>
+inline auto
+log1p(const hyper_dual<T>& x)
+{
+    using std::log1p;
+    const auto d = T(1) / (T(1) + x.real());
+    return detail::chain2(x, log1p(x.real()), d, -d * d);
+}
+
+//---------------------------------------------------------
+/// @brief logarithm to any base
+template<class T>
+inline auto
+log_base(const T& base, const hyper_dual<T>& x)
+{
+    using std::log;
+    const auto d = T(1) / x.real();
+    const auto s = T(1) / log(base);
+    return detail::chain2(x, log(x.real()) * s, d * s, -d * d * s);
+}
+
+
+
+//-------------------------------------------------------------------
+// TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+sin(const hyper_dual<T>& x)
+{
+    using std::sin;
+    using std::cos;
+    const auto s = sin(x.real());
+    return detail::chain2(x, s, cos(x.real()), -s);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+cos(const hyper_dual<T>& x)
+{
+    using std::sin;
+    using std::cos;
+    const auto c = cos(x.real());
+    return detail::chain2(x, c, -sin(x.real()), -c);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+tan(const hyper_dual<T>& x)
+{
+    using std::tan;
+    const auto t = tan(x.real());
+    const auto d = T(1) + t * t;
+    return detail::chain2(x, t, d, T(2) * t * d);
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE TRIGONOMETRIC
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+asin(const hyper_dual<T>& x)
+{
+    using std::asin;
+    using std::sqrt;
+    const auto q = T(1) / (T(1) - x.real() * x.real());
+    const auto d = sqrt(q);
+    return detail::chain2(x, asin(x.real()), d, x.real() * d * q);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+acos(const hyper_dual<T>& x)
+{
+    using std::acos;
+    using std::sqrt;
+    const auto q = T(1) / (T(1) - x.real() * x.real());
+    const auto d = sqrt(q);
+    return detail::chain2(x, acos(x.real()), -d, -x.real() * d * q);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+atan(const hyper_dual<T>& x)
+{
+    using std::atan;
+    const auto d = T(1) / (T(1) + x.real() * x.real());
+    return detail::chain2(x, atan(x.real()), d, T(-2) * x.real() * d * d);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+atan2(const hyper_dual<T>& y, const hyper_dual<T>& x)
+{
+    using std::atan2;
+    const auto a = y.real(), b = x.real();
+    const auto q = T(1) / (a * a + b * b);
+    const auto q2 = q * q;
+    return detail::chain2(y, x, atan2(a, b),
+        b * q, -a * q,
+        T(-2) * a * b * q2, (a * a - b * b) * q2, T(2) * a * b * q2);
+}
+
+
+
+//-------------------------------------------------------------------
+// HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+sinh(const hyper_dual<T>& x)
+{
+    using std::sinh;
+    using std::cosh;
+    const auto s = sinh(x.real());
+    return detail::chain2(x, s, cosh(x.real()), s);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+cosh(const hyper_dual<T>& x)
+{
+    using std::sinh;
+    using std::cosh;
+    const auto c = cosh(x.real());
+    return detail::chain2(x, c, sinh(x.real()), c);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+tanh(const hyper_dual<T>& x)
+{
+    using std::tanh;
+    const auto t = tanh(x.real());
+    const auto d = T(1) - t * t;
+    return detail::chain2(x, t, d, T(-2) * t * d);
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSE HYPERBOLIC
+//-------------------------------------------------------------------
+template<class T>
+inline auto
+asinh(const hyper_dual<T>& x)
+{
+    using std::asinh;
+    using std::sqrt;
+    const auto q = T(1) / (x.real() * x.real() + T(1));
+    const auto d = sqrt(q);
+    return detail::chain2(x, asinh(x.real()), d, -x.real() * d * q);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+acosh(const hyper_dual<T>& x)
+{
+    using std::acosh;
+    using std::sqrt;
+    const auto q = T(1) / (x.real() * x.real() - T(1));
+    const auto d = sqrt(q);
+    return detail::chain2(x, acosh(x.real()), d, -x.real() * d * q);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline auto
+atanh(const hyper_dual<T>& x)
+{
+    using std::atanh;
+    const auto d = T(1) / (T(1) - x.real() * x.real());
+    return detail::chain2(x, atanh(x.real()), d, T(2) * x.real() * d * d);
+}
+
+
+
+//-------------------------------------------------------------------
+//
+//-------------------------------------------------------------------
+///@brief  error function
+template<class T>
+inline auto
+erf(const hyper_dual<T>& x)
+{
+    using std::erf;
+    using std::exp;
+    const auto d = exp(-x.real() * x.real()) *
+        T(1.1283791670955125738961589031215451716881012586580);
+    return detail::chain2(x, erf(x.real()), d, T(-2) * x.real() * d);
+}
+
+//---------------------------------------------------------
+///@brief complementary error function
+template<class T>
+inline auto
+erfc(const hyper_dual<T>& x)
+{
+    using std::erfc;
+    using std::exp;
+    const auto d = exp(-x.real() * x.real()) *
+        T(1.1283791670955125738961589031215451716881012586580);
+    return detail::chain2(x, erfc(x.real()), -d, T(2) * x.real() * d);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline bool
+isfinite(const hyper_dual<T>& x)
+{
+    using std::isfinite;
+    return isfinite(x.real()) && isfinite(x.e1()) &&
+           isfinite(x.e2()) && isfinite(x.e1e2());
+}
+
+//---------------------------------------------------------
+template<class T>
+inline bool
+isinf(const hyper_dual<T>& x)
+{
+    using std::isinf;
+    return isinf(x.real()) || isinf(x.e1()) ||
+           isinf(x.e2()) || isinf(x.e1e2());
+}
+
+//---------------------------------------------------------
+template<class T>
+inline bool
+isnan(const hyper_dual<T>& x)
+{
+    using std::isnan;
+    return isnan(x.real()) || isnan(x.e1()) ||
+           isnan(x.e2()) || isnan(x.e1e2());
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  value, gradient and Hessian of a function of N variables
+ *         (multi-lane hyper-dual number)
+ *
+ * @details r + sum_i e_i g_i + sum_ij e_i e_j H_ij / 2 truncated after
+ *          second order; one evaluation with seeded variables yields
+ *          the full gradient and the full (symmetric) Hessian:
+ *            f(x) = {f(r), f'(r) g, f'(r) H + f''(r) g g^T}
+ *
+ *          the Hessian is stored as N full rows so that all updates are
+ *          SIMD row kernels (same storage as dual_vec<T,N> tangents);
+ *          hessian(i,j) and hessian(j,i) are equal up to rounding
+ *
+ *****************************************************************************/
+template<class NumberType, std::size_t N>
+class hyper_dual_vec
+{
+    static_assert(is_floating_point<NumberType>::value,
+        "hyper_dual_vec<T,N>: T must be a floating-point number type");
+
+    static_assert(N > 0 && N != dynamic_size,
+        "hyper_dual_vec<T,N>: N must be a (positive) compile-time constant");
+
+    using row_t = detail::tangent_storage<NumberType,N>;
+
+public:
+    //---------------------------------------------------------------
+    using value_type   = NumberType;
+    using numeric_type = value_type;
+    using size_type    = std::size_t;
+
+
+    //---------------------------------------------------------------
+    /// @brief zero
+    hyper_dual_vec():
+        r_{value_type(0)}, g_{}, h_{}
+    {}
+
+    /// @brief constant
+    explicit
+    hyper_dual_vec(const value_type& realPart):
+        r_{realPart}, g_{}, h_{}
+    {}
+
+    /// @brief independent variable number 'seed'
+    hyper_dual_vec(const value_type& realPart, size_type seed):
+        r_{realPart}, g_{}, h_{}
+    {
+        assert(seed < N);
+        g_.data()[seed] = value_type(1);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief {f, df * x', df * x'' + d2f * x' x'^T}
+    static hyper_dual_vec
+    chain(const hyper_dual_vec& x, const value_type& f,
+          const value_type& df, const value_type& d2f)
+    {
+        constexpr auto n = row_t::padded_size();
+        hyper_dual_vec y{f, detail::uninitialized_tag{}};
+        detail::tangent_scale(n, df, x.g_.data(), y.g_.data());
+        for(size_type i = 0; i < N; ++i) {
+            detail::tangent_combine(n, df, x.h_[i].data(),
+                d2f * x.g_.data()[i], x.g_.data(), y.h_[i].data());
+        }
+        return y;
+    }
+
+    //-----------------------------------------------------
+    /// @brief second-order chain rule for f(x,y)
+    static hyper_dual_vec
+    chain(const hyper_dual_vec& x, const hyper_dual_vec& y,
+          const value_type& f, const value_type& fx, const value_type& fy,
+          const value_type& fxx, const value_type& fxy, const value_type& fyy)
+    {
+        constexpr auto n = row_t::padded_size();
+        const auto gx = x.g_.data();
+        const auto gy = y.g_.data();
+
+        hyper_dual_vec z{f, detail::uninitialized_tag{}};
+        detail::tangent_combine(n, fx, gx, fy, gy, z.g_.data());
+        for(size_type i = 0; i < N; ++i) {
+            auto zi = z.h_[i].data();
+            detail::tangent_combine(n, fx, x.h_[i].data(), fy, y.h_[i].data(), zi);
+            detail::tangent_add_scaled(n, zi, fxx * gx[i] + fxy * gy[i], gx);
+            detail::tangent_add_scaled(n, zi, fxy * gx[i] + fyy * gy[i], gy);
+        }
+        return z;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr const value_type&
+    real() const noexcept {
+        return r_;
+    }
+    //-----------------------------------------------------
+    static constexpr size_type
+    size() noexcept {
+        return N;
+    }
+    //-----------------------------------------------------
+    /// @brief first derivative w.r.t. variable i
+    const value_type&
+    gradient(size_type i) const noexcept {
+        assert(i < N);
+        return g_.data()[i];
+    }
+    //-----------------------------------------------------
+    /// @brief second derivative w.r.t. variables i and j
+    const value_type&
+    hessian(size_type i, size_type j) const noexcept {
+        assert(i < N && j < N);
+        return h_[i].data()[j];
+    }
+
+
+    //---------------------------------------------------------------
+    hyper_dual_vec&
+    negate() noexcept {
+        return (*this *= value_type(-1));
+    }
+
+    //-----------------------------------------------------
+    hyper_dual_vec&
+    operator += (const value_type& v) noexcept {
+        r_ += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    hyper_dual_vec&
+    operator -= (const value_type& v) noexcept {
+        r_ -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    hyper_dual_vec&
+    operator *= (const value_type& v) noexcept {
+        constexpr auto n = row_t::padded_size();
+        r_ *= v;
+        detail::tangent_scale(n, v, g_.data(), g_.data());
+        for(auto& row : h_) detail::tangent_scale(n, v, row.data(), row.data());
+        return *this;
+    }
+    //-----------------------------------------------------
+    hyper_dual_vec&
+    operator /= (const value_type& v) noexcept {
+        return (*this *= (value_type(1) / v));
+    }
+
+    //-----------------------------------------------------
+    hyper_dual_vec&
+    operator += (const hyper_dual_vec& o) noexcept {
+        return add_scaled(value_type(1), o);
+    }
+    //-----------------------------------------------------
+    hyper_dual_vec&
+    operator -= (const hyper_dual_vec& o) noexcept {
+        return add_scaled(value_type(-1), o);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    hyper_dual_vec(const value_type& r, detail::uninitialized_tag t) noexcept:
+        r_{r}, g_{g_, t}, h_{}
+    {}
+
+    //---------------------------------------------------------------
+    hyper_dual_vec&
+    add_scaled(const value_type& s, const hyper_dual_vec& o) noexcept {
+        constexpr auto n = row_t::padded_size();
+        r_ += s * o.r_;
+        detail::tangent_add_scaled(n, g_.data(), s, o.g_.data());
+        for(size_type i = 0; i < N; ++i) {
+            detail::tangent_add_scaled(n, h_[i].data(), s, o.h_[i].data());
+        }
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    value_type r_;
+    row_t g_;
+    std::array<row_t,N> h_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * HYPER_DUAL_VEC ARITHMETIC AND FUNCTIONS
+ *
+ *****************************************************************************/
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+operator + (hyper_dual_vec<T,N> x, const hyper_dual_vec<T,N>& y) {
+    return (x += y);
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+operator - (hyper_dual_vec<T,N> x, const hyper_dual_vec<T,N>& y) {
+    return (x -= y);
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+operator - (hyper_dual_vec<T,N> x) {
+    return x.negate();
+}
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+operator * (const hyper_dual_vec<T,N>& x, const hyper_dual_vec<T,N>& y) {
+    return hyper_dual_vec<T,N>::chain(x, y, x.real() * y.real(),
+        y.real(), x.real(), T(0), T(1), T(0));
+}
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+operator / (const hyper_dual_vec<T,N>& x, const hyper_dual_vec<T,N>& y) {
+    const auto inv = T(1) / y.real();
+    const auto q = x.real() * inv;
+    return hyper_dual_vec<T,N>::chain(x, y, q,
+        inv, -q * inv, T(0), -inv * inv, T(2) * q * inv * inv);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator + (hyper_dual_vec<T,N> x, const T2& y) { return (x += T(y)); }
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator + (const T2& y, hyper_dual_vec<T,N> x) { return (x += T(y)); }
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator - (hyper_dual_vec<T,N> x, const T2& y) { return (x -= T(y)); }
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator - (const T2& y, hyper_dual_vec<T,N> x) { return (x.negate() += T(y)); }
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator * (hyper_dual_vec<T,N> x, const T2& y) { return (x *= T(y)); }
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator * (const T2& y, hyper_dual_vec<T,N> x) { return (x *= T(y)); }
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator / (hyper_dual_vec<T,N> x, const T2& y) { return (x /= T(y)); }
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+operator / (const T2& y, const hyper_dual_vec<T,N>& x) {
+    const auto inv = T(1) / x.real();
+    const auto q = T(y) * inv;
+    return hyper_dual_vec<T,N>::chain(x, q, -q * inv, T(2) * q * inv * inv);
+}
+
+
+//-------------------------------------------------------------------
+/// @brief applies a hyper_dual<T> function to a hyper_dual_vec:
+///        the scalar version supplies f, f' and f''
+///        (evaluated with seed {r,1,1,0})
+template<class T, std::size_t N, class F>
+inline hyper_dual_vec<T,N>
+apply(const hyper_dual_vec<T,N>& x, F&& f)
+{
+    const auto y = f(hyper_dual<T>{x.real(), T(1), T(1), T(0)});
+    return hyper_dual_vec<T,N>::chain(x, y.real(), y.e1(), y.e1e2());
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+sqrt(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return sqrt(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+cbrt(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return cbrt(a); });
+}
+template<class T, std::size_t N, class T2, class = std::enable_if_t<is_number<T2>::value>>
+inline hyper_dual_vec<T,N>
+pow(const hyper_dual_vec<T,N>& x, const T2& e) {
+    return apply(x, [&](const auto& a) { return pow(a, T(e)); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+exp(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return exp(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+exp2(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return exp2(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+expm1(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return expm1(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+log(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return log(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+log10(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return log10(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+log2(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return log2(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+log1p(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return log1p(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+sin(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return sin(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+cos(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return cos(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+tan(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return tan(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+asin(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return asin(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+acos(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return acos(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+atan(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return atan(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+sinh(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return sinh(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+cosh(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return cosh(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+tanh(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return tanh(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+asinh(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return asinh(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+acosh(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return acosh(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+atanh(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return atanh(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+erf(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return erf(a); });
+}
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+erfc(const hyper_dual_vec<T,N>& x) {
+    return apply(x, [](const auto& a) { return erfc(a); });
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+pow(const hyper_dual_vec<T,N>& b, const hyper_dual_vec<T,N>& e)
+{
+    using std::pow;
+    using std::log;
+    const auto x = b.real(), y = e.real();
+    const auto lx = log(x);
+    const auto p1 = pow(x, y - T(1));
+    const auto p = p1 * x;
+    return hyper_dual_vec<T,N>::chain(b, e, p,
+        y * p1, p * lx,
+        y * (y - T(1)) * p1 / x, p1 * (T(1) + y * lx), p * lx * lx);
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline hyper_dual_vec<T,N>
+atan2(const hyper_dual_vec<T,N>& y, const hyper_dual_vec<T,N>& x)
+{
+    using std::atan2;
+    const auto a = y.real(), b = x.real();
+    const auto q = T(1) / (a * a + b * b);
+    const auto q2 = q * q;
+    return hyper_dual_vec<T,N>::chain(y, x, atan2(a, b),
+        b * q, -a * q,
+        T(-2) * a * b * q2, (a * a - b * b) * q2, T(2) * a * b * q2);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T>
+struct is_number<hyper_dual<T>> : std::true_type {};
+
+template<class T>
+struct is_number<hyper_dual<T>&> : std::true_type {};
+
+template<class T>
+struct is_number<hyper_dual<T>&&> : std::true_type {};
+
+template<class T>
+struct is_number<const hyper_dual<T>&> : std::true_type {};
+
+template<class T>
+struct is_number<const hyper_dual<T>> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+struct is_floating_point<hyper_dual<T>> :
+    std::integral_constant<bool, is_floating_point<T>::value>
+{};
+
+
+
+//-------------------------------------------------------------------
+template<class T, class T2>
+struct common_numeric_type<hyper_dual<T>,T2>
+{
+    using type = hyper_dual<common_numeric_t<T,T2>>;
+};
+//---------------------------------------------------------
+template<class T, class T2>
+struct common_numeric_type<T2,hyper_dual<T>>
+{
+    using type = hyper_dual<common_numeric_t<T,T2>>;
+};
+//---------------------------------------------------------
+template<class T1, class T2>
+struct common_numeric_type<hyper_dual<T1>,hyper_dual<T2>>
+{
+    using type = hyper_dual<common_numeric_t<T1,T2>>;
+};
+
+
+}  // namespace num
+}  // namespace am
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "dual.h"
+#include "dual_vec.h"
+#include "parallel.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * FORWARD-MODE JACOBIAN DRIVER
+ *
+ * @details the user function is a functor (or generic lambda) templated
+ *          on the number type:
+ *
+ *              struct F {
+ *                  template<class D>
+ *                  void operator () (const D* x, D* y) const;
+ *              };
+ *
+ *          reading n inputs x and writing m outputs y;
+ *          it is evaluated with dual<T> (Lanes = 1) or dual_vec<T,Lanes>
+ *          numbers, each evaluation yields 'Lanes' columns of the
+ *          Jacobian (one seed batch)
+ *
+ *          seed batches are distributed dynamically over the threads;
+ *          every thread owns its input/output scratch buffers, so
+ *          there are no allocations per batch (unless f allocates);
+ *          f is called concurrently and must therefore be thread-safe
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+template<class T, std::size_t Lanes>
+struct jacobian_number
+{
+    using type = dual_vec<T,Lanes>;
+
+    static type constant(const T& x)                    { return type{x}; }
+    static type seeded(const T& x, std::size_t lane)    { return type{x, lane}; }
+    static const T& tangent(const type& y, std::size_t lane) { return y.tangent(lane); }
+};
+
+template<class T>
+struct jacobian_number<T,1>
+{
+    using type = dual<T>;
+
+    static type constant(const T& x)                    { return type{x}; }
+    static type seeded(const T& x, std::size_t)         { return type{x, T(1)}; }
+    static const T& tangent(const type& y, std::size_t) { return y.imag(); }
+};
+
+
+
+//-------------------------------------------------------------------
+template<std::size_t Lanes, class F, class T>
+inline void
+jacobian(F& f, std::size_t n, const T* x, std::size_t m,
+         T* fx, T* jac, std::size_t numThreads)
+{
+    static_assert(Lanes > 0, "jacobian: Lanes must be positive");
+
+    using num_t = jacobian_number<T,Lanes>;
+    using d_t   = typename num_t::type;
+    using buf_t = std::vector<d_t,simd::aligned_allocator<d_t>>;
+
+    //at least one evaluation (for the function values)
+    const auto numBatches = std::max(std::size_t(1), (n + Lanes - 1) / Lanes);
+
+    parallel_for_dynamic(numBatches, numThreads, 1, [&] {
+        //per-thread scratch
+        return [&f,n,x,m,fx,jac,in = buf_t(n), out = buf_t(m)]
+            (std::size_t bb, std::size_t be) mutable
+        {
+            for(auto batch = bb; batch < be; ++batch) {
+                const auto b = batch * Lanes;
+                const auto e = std::min(n, b + Lanes);
+
+                for(std::size_t j = 0; j < n; ++j) {
+                    in[j] = (j >= b && j < e) ? num_t::seeded(x[j], j - b)
+                                              : num_t::constant(x[j]);
+                }
+
+                f(static_cast<const d_t*>(in.data()), out.data());
+
+                for(std::size_t i = 0; i < m; ++i) {
+                    auto row = jac + i * n;
+                    for(auto j = b; j < e; ++j) {
+                        row[j] = num_t::tangent(out[i], j - b);
+                    }
+                }
+                if(fx && b == 0) {
+                    for(std::size_t i = 0; i < m; ++i) fx[i] = out[i].real();
+                }
+            }
+        };
+    });
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief dense Jacobian of f: R^n -> R^m at x
+/// @param jac  m x n row-major output: jac[i*n + j] = dy_i / dx_j
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+/// @tparam Lanes  number of Jacobian columns per evaluation of f
+template<std::size_t Lanes = 8, class F, class T>
+inline void
+jacobian(F&& f, std::size_t n, const T* x, std::size_t m, T* jac,
+         std::size_t numThreads = 1)
+{
+    detail::jacobian<Lanes>(f, n, x, m, static_cast<T*>(nullptr), jac, numThreads);
+}
+
+//---------------------------------------------------------
+/// @brief function values fx = f(x) (size m) and
+///        dense m x n row-major Jacobian of f at x
+template<std::size_t Lanes = 8, class F, class T>
+inline void
+value_and_jacobian(F&& f, std::size_t n, const T* x, std::size_t m,
+                   T* fx, T* jac, std::size_t numThreads = 1)
+{
+    detail::jacobian<Lanes>(f, n, x, m, fx, jac, numThreads);
+}
+
+
+}  // namespace num
+}  // namespace am
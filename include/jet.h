@@ -0,0 +1,856 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "traits.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class, std::size_t> class jet;
+
+template<class>
+struct is_jet :
+    std::false_type
+{};
+
+template<class T, std::size_t N>
+struct is_jet<jet<T,N>> :
+    std::true_type
+{};
+
+
+
+
+/*****************************************************************************
+ *
+ * CAUCHY PRODUCT
+ *
+ * @details c[k] = sum_{i=0}^{k} a[i] b[k-i]; all terms are expanded at
+ *          compile time (no loops), so that small orders compile to
+ *          straight-line code
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<std::size_t K, class T, std::size_t... I>
+inline constexpr T
+cauchy_term(const T* a, const T* b, std::index_sequence<I...>)
+{
+    T r = T(0);
+    using expand = int[];
+    (void)expand{0, ((r += a[I] * b[K-I]), 0)...};
+    return r;
+}
+
+//---------------------------------------------------------
+/// @brief c must not alias a or b
+template<class T, std::size_t... K>
+inline constexpr void
+cauchy_product(const T* a, const T* b, T* c, std::index_sequence<K...>)
+{
+    using expand = int[];
+    (void)expand{0,
+        ((c[K] = cauchy_term<K>(a, b, std::make_index_sequence<K+1>{})), 0)...};
+}
+
+}  // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * truncated Taylor polynomial x(t) = x_0 + x_1 t + ... + x_N t^N
+ * of order N
+ *
+ * @details seeding x = {x0, 1} (a jet of the variable t) makes
+ *          f(x)[k] = f^(k)(x0) / k! the Taylor coefficients of f at x0;
+ *          derivative(k) returns f^(k)(x0)
+ *
+ *          products and functions cost O(N^2) operations, compared to
+ *          O(2^N) for N nested duals; arithmetic is constexpr
+ *
+ *****************************************************************************/
+template<class NumberType, std::size_t Order>
+class jet
+{
+public:
+
+    static_assert(is_number<NumberType>::value,
+        "jet<T,N>: T must be a number type");
+
+    static_assert(!is_jet<NumberType>::value,
+        "jet<T,N>: T must not be a jet<> type itself");
+
+
+    //---------------------------------------------------------------
+    using value_type      = NumberType;
+    using numeric_type    = value_type;
+    using size_type       = std::size_t;
+
+
+    //---------------------------------------------------------------
+    /// @brief zero
+    constexpr
+    jet() noexcept: c_{} {}
+
+    /// @brief constant
+    explicit constexpr
+    jet(const value_type& x0):
+        c_{}
+    {
+        c_[0] = x0;
+    }
+
+    /// @brief x0 + x1 t
+    constexpr
+    jet(const value_type& x0, const value_type& x1):
+        c_{}
+    {
+        static_assert(Order > 0, "jet<T,0> has no first-order coefficient");
+        c_[0] = x0;
+        c_[1] = x1;
+    }
+
+    /// @brief from jet with different value_type
+    template<class T>
+    explicit constexpr
+    jet(const jet<T,Order>& x):
+        c_{}
+    {
+        for(size_type k = 0; k <= Order; ++k) c_[k] = value_type(x[k]);
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr
+    jet(const jet&) = default;
+
+    constexpr
+    jet(jet&&) = default;
+
+
+    //---------------------------------------------------------------
+    constexpr jet&
+    operator = (const jet&) = default;
+
+    constexpr jet&
+    operator = (jet&&) = default;
+
+
+    //-----------------------------------------------------
+    constexpr jet&
+    operator = (const value_type& x0)
+    {
+        c_[0] = x0;
+        for(size_type k = 1; k <= Order; ++k) c_[k] = value_type(0);
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    static constexpr size_type
+    order() noexcept { return Order; }
+
+    static constexpr size_type
+    size() noexcept { return Order + 1; }
+
+
+    //---------------------------------------------------------------
+    constexpr const value_type&
+    real() const noexcept {
+        return c_[0];
+    }
+
+    constexpr jet&
+    real(const value_type& v) noexcept {
+        c_[0] = v;
+        return *this;
+    }
+
+    /// @brief Taylor coefficient of t^k
+    constexpr const value_type&
+    operator [] (size_type k) const noexcept {
+        return c_[k];
+    }
+
+    constexpr value_type&
+    operator [] (size_type k) noexcept {
+        return c_[k];
+    }
+
+    /// @brief k-th derivative: k! * coefficient of t^k
+    constexpr value_type
+    derivative(size_type k) const {
+        auto d = c_[k];
+        for(size_type i = 2; i <= k; ++i) d *= value_type(i);
+        return d;
+    }
+
+
+    //---------------------------------------------------------------
+    constexpr jet&
+    negate() noexcept {
+        for(auto& c : c_) c = -c;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // jet (op)= number
+    //---------------------------------------------------------------
+    constexpr jet&
+    operator += (const value_type& v) {
+        c_[0] += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr jet&
+    operator -= (const value_type& v) {
+        c_[0] -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr jet&
+    operator *= (const value_type& v) {
+        for(auto& c : c_) c *= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr jet&
+    operator /= (const value_type& v) {
+        for(auto& c : c_) c /= v;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // jet (op)= jet
+    //---------------------------------------------------------------
+    constexpr jet&
+    operator += (const jet& o) {
+        for(size_type k = 0; k <= Order; ++k) c_[k] += o.c_[k];
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr jet&
+    operator -= (const jet& o) {
+        for(size_type k = 0; k <= Order; ++k) c_[k] -= o.c_[k];
+        return *this;
+    }
+    //-----------------------------------------------------
+    constexpr jet&
+    operator *= (const jet& o)
+    {
+        jet r;
+        detail::cauchy_product(c_, o.c_, r.c_,
+                               std::make_index_sequence<Order+1>{});
+        return *this = r;
+    }
+    //-----------------------------------------------------
+    /// @brief q = x / y  <=>  q[k] = (x[k] - sum_{j<k} q[j] y[k-j]) / y[0]
+    constexpr jet&
+    operator /= (const jet& o)
+    {
+        const jet y = o;  //o may alias *this
+        const auto inv = value_type(1) / y.c_[0];
+        for(size_type k = 0; k <= Order; ++k) {
+            auto s = c_[k];
+            for(size_type j = 0; j < k; ++j) s -= c_[j] * y.c_[k-j];
+            c_[k] = s * inv;
+        }
+        return *this;
+    }
+
+
+private:
+
+    //---------------------------------------------------------------
+    value_type c_[Order+1];
+
+};
+
+
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+/// @brief constant jet
+template<std::size_t N, class T, class = std::enable_if_t<
+    !is_jet<T>::value && is_number<T>::value>>
+inline constexpr auto
+make_jet(const T& x)
+{
+    return jet<T,N>{x};
+}
+
+//---------------------------------------------------------------
+/// @brief x0 + x1 t; make_jet<N>(x0, 1) seeds the variable
+template<std::size_t N, class T1, class T2>
+inline constexpr auto
+make_jet(const T1& x0, const T2& x1)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{T(x0), T(x1)};
+}
+
+
+
+//-------------------------------------------------------------------
+// I/O
+//-------------------------------------------------------------------
+template<class Istream, class T, std::size_t N>
+inline Istream&
+operator >> (Istream& is, jet<T,N>& x)
+{
+    for(std::size_t k = 0; k <= N; ++k) is >> x[k];
+    return is;
+}
+
+//---------------------------------------------------------
+template<class Ostream, class T, std::size_t N>
+inline Ostream&
+operator << (Ostream& os, const jet<T,N>& x)
+{
+    os << x[0];
+    for(std::size_t k = 1; k <= N; ++k) os << " " << x[k];
+    return os;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class Ostream>
+inline Ostream&
+print(Ostream& os, const jet<T,N>& x)
+{
+    os << "(" << x[0];
+    for(std::size_t k = 1; k <= N; ++k) os << "," << x[k];
+    return (os << ")");
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ACCESS
+ *
+ *****************************************************************************/
+template<class T, std::size_t N>
+inline constexpr decltype(auto)
+real(const jet<T,N>& x) noexcept
+{
+    return x.real();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ * @details == and != compare all coefficients;
+ *          ordering only uses the real part
+ *
+ *****************************************************************************/
+template<class T1, class T2, std::size_t N>
+inline constexpr bool
+operator == (const jet<T1,N>& a, const jet<T2,N>& b)
+{
+    for(std::size_t k = 0; k <= N; ++k) {
+        if(!(a[k] == b[k])) return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, std::size_t N>
+inline constexpr bool
+operator != (const jet<T1,N>& a, const jet<T2,N>& b)
+{
+    return !(a == b);
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, std::size_t N>
+inline constexpr bool
+operator < (const jet<T1,N>& a, const jet<T2,N>& b) {
+    return a.real() < b.real();
+}
+template<class T1, class T2, std::size_t N>
+inline constexpr bool
+operator > (const jet<T1,N>& a, const jet<T2,N>& b) {
+    return a.real() > b.real();
+}
+template<class T1, class T2, std::size_t N>
+inline constexpr bool
+operator <= (const jet<T1,N>& a, const jet<T2,N>& b) {
+    return a.real() <= b.real();
+}
+template<class T1, class T2, std::size_t N>
+inline constexpr bool
+operator >= (const jet<T1,N>& a, const jet<T2,N>& b) {
+    return a.real() >= b.real();
+}
+
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator < (const jet<T1,N>& x, const T2& r) { return x.real() < r; }
+
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator < (const T2& r, const jet<T1,N>& x) { return r < x.real(); }
+
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator > (const jet<T1,N>& x, const T2& r) { return x.real() > r; }
+
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator > (const T2& r, const jet<T1,N>& x) { return r > x.real(); }
+
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator <= (const jet<T1,N>& x, const T2& r) { return x.real() <= r; }
+
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator <= (const T2& r, const jet<T1,N>& x) { return r <= x.real(); }
+
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator >= (const jet<T1,N>& x, const T2& r) { return x.real() >= r; }
+
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr bool
+operator >= (const T2& r, const jet<T1,N>& x) { return r >= x.real(); }
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+// ADDITION
+//-------------------------------------------------------------------
+template<class T1, class T2, std::size_t N>
+inline constexpr auto
+operator + (const jet<T1,N>& x, const jet<T2,N>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} += jet<T,N>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator + (const jet<T1,N>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} += T(y);
+}
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator + (const T2& y, const jet<T1,N>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} += T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+// SUBTRACTION
+//-------------------------------------------------------------------
+template<class T1, class T2, std::size_t N>
+inline constexpr auto
+operator - (const jet<T1,N>& x, const jet<T2,N>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} -= jet<T,N>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator - (const jet<T1,N>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} -= T(y);
+}
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator - (const T2& y, const jet<T1,N>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x}.negate() += T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+// MULTIPLICATION
+//-------------------------------------------------------------------
+template<class T1, class T2, std::size_t N>
+inline constexpr auto
+operator * (const jet<T1,N>& x, const jet<T2,N>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} *= jet<T,N>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator * (const jet<T1,N>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} *= T(y);
+}
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator * (const T2& y, const jet<T1,N>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} *= T(y);
+}
+
+
+
+//-------------------------------------------------------------------
+// DIVISION
+//-------------------------------------------------------------------
+template<class T1, class T2, std::size_t N>
+inline constexpr auto
+operator / (const jet<T1,N>& x, const jet<T2,N>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} /= jet<T,N>{y};
+}
+
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator / (const jet<T1,N>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{x} /= T(y);
+}
+//---------------------------------------------------------
+template<class T1, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline constexpr auto
+operator / (const T2& y, const jet<T1,N>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return jet<T,N>{T(y)} /= jet<T,N>{x};
+}
+
+
+
+//-------------------------------------------------------------------
+// INVERSION
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline constexpr auto
+operator - (jet<T,N> x)
+{
+    return x.negate();
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * FUNCTIONS
+ *
+ * @details coefficients follow from the recurrences obtained by
+ *          differentiating the defining ODE of each function
+ *          (e.g. y = exp(x) => y' = x' y), so every function only needs
+ *          one scalar evaluation of f (and f') at the real part
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+// ABSOLUTE
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+inline constexpr auto
+abs(const jet<T,N>& x)
+{
+    return (x.real() < T(0)) ? -x : x;
+}
+
+
+
+//-------------------------------------------------------------------
+// EXPONENTIAL / LOGARITHM
+//-------------------------------------------------------------------
+/// @brief y = e^x:  y[k] = 1/k sum_{j=1}^{k} j x[j] y[k-j]
+template<class T, std::size_t N>
+inline auto
+exp(const jet<T,N>& x)
+{
+    using std::exp;
+    jet<T,N> y;
+    y[0] = exp(x[0]);
+    for(std::size_t k = 1; k <= N; ++k) {
+        auto s = T(0);
+        for(std::size_t j = 1; j <= k; ++j) s += T(j) * x[j] * y[k-j];
+        y[k] = s / T(k);
+    }
+    return y;
+}
+
+//---------------------------------------------------------
+/// @brief y = log(x):  y[k] = (x[k] - 1/k sum_{j=1}^{k-1} j y[j] x[k-j]) / x[0]
+template<class T, std::size_t N>
+inline auto
+log(const jet<T,N>& x)
+{
+    using std::log;
+    jet<T,N> y;
+    y[0] = log(x[0]);
+    const auto inv = T(1) / x[0];
+    for(std::size_t k = 1; k <= N; ++k) {
+        auto s = T(0);
+        for(std::size_t j = 1; j < k; ++j) s += T(j) * y[j] * x[k-j];
+        y[k] = (x[k] - s / T(k)) * inv;
+    }
+    return y;
+}
+
+
+
+//-------------------------------------------------------------------
+// ROOTS / POWERS
+//-------------------------------------------------------------------
+/// @brief y = sqrt(x):  y[k] = (x[k] - sum_{j=1}^{k-1} y[j] y[k-j]) / (2 y[0])
+template<class T, std::size_t N>
+inline auto
+sqrt(const jet<T,N>& x)
+{
+    using std::sqrt;
+    jet<T,N> y;
+    y[0] = sqrt(x[0]);
+    const auto inv = T(1) / (T(2) * y[0]);
+    for(std::size_t k = 1; k <= N; ++k) {
+        auto s = x[k];
+        for(std::size_t j = 1; j < k; ++j) s -= y[j] * y[k-j];
+        y[k] = s * inv;
+    }
+    return y;
+}
+
+//---------------------------------------------------------
+/// @brief y = x^p:  y[k] = 1/(k x[0]) sum_{j=1}^{k} ((p+1) j - k) x[j] y[k-j];
+///        for x[0] = 0 and non-negative integer p by binary powering
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+pow(const jet<T,N>& x, const T2& p)
+{
+    using std::pow;
+    using std::floor;
+
+    const auto tp = T(p);
+    if(x[0] == T(0) && tp >= T(0) && floor(tp) == tp) {
+        //lowest non-zero term of x^p has degree >= p
+        if(tp > T(N)) return jet<T,N>{};
+        auto n = static_cast<std::size_t>(tp);
+        auto b = x;
+        auto y = jet<T,N>{T(1)};
+        while(n > 0) {
+            if(n & 1) y = y * b;
+            n >>= 1;
+            if(n > 0) b = b * b;
+        }
+        return y;
+    }
+
+    jet<T,N> y;
+    y[0] = pow(x[0], tp);
+    const auto inv = T(1) / x[0];
+    const auto p1 = tp + T(1);
+    for(std::size_t k = 1; k <= N; ++k) {
+        auto s = T(0);
+        for(std::size_t j = 1; j <= k; ++j) s += (p1 * T(j) - T(k)) * x[j] * y[k-j];
+        y[k] = s * inv / T(k);
+    }
+    return y;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2, class = std::enable_if_t<
+    !is_jet<T2>::value && is_number<T2>::value>>
+inline auto
+pow(const T2& b, const jet<T,N>& e)
+{
+    using std::log;
+    return exp(e * T(log(T(b))));
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline auto
+pow(const jet<T,N>& b, const jet<T,N>& e)
+{
+    return exp(e * log(b));
+}
+
+
+
+//-------------------------------------------------------------------
+// TRIGONOMETRIC
+//-------------------------------------------------------------------
+/// @brief s = sin(x), c = cos(x):
+///        s[k] =  1/k sum_{j=1}^{k} j x[j] c[k-j]
+///        c[k] = -1/k sum_{j=1}^{k} j x[j] s[k-j]
+template<class T, std::size_t N>
+inline void
+sincos(const jet<T,N>& x, jet<T,N>* s, jet<T,N>* c)
+{
+    using std::sin;
+    using std::cos;
+    jet<T,N> sx, cx;
+    sx[0] = sin(x[0]);
+    cx[0] = cos(x[0]);
+    for(std::size_t k = 1; k <= N; ++k) {
+        auto ss = T(0);
+        auto cs = T(0);
+        for(std::size_t j = 1; j <= k; ++j) {
+            const auto jx = T(j) * x[j];
+            ss += jx * cx[k-j];
+            cs += jx * sx[k-j];
+        }
+        sx[k] =  ss / T(k);
+        cx[k] = -cs / T(k);
+    }
+    *s = sx;
+    *c = cx;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline auto
+sin(const jet<T,N>& x)
+{
+    jet<T,N> s, c;
+    sincos(x, &s, &c);
+    return s;
+}
+
+//---------------------------------------------------------
+template<class T, std::size_t N>
+inline auto
+cos(const jet<T,N>& x)
+{
+    jet<T,N> s, c;
+    sincos(x, &s, &c);
+    return c;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T, std::size_t N>
+struct is_number<jet<T,N>> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<jet<T,N>&> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<jet<T,N>&&> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<const jet<T,N>&> : std::true_type {};
+
+template<class T, std::size_t N>
+struct is_number<const jet<T,N>> : std::true_type {};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N>
+struct is_floating_point<jet<T,N>> :
+    std::integral_constant<bool, is_floating_point<T>::value>
+{};
+
+
+
+//-------------------------------------------------------------------
+template<class T, std::size_t N, class T2>
+struct common_numeric_type<jet<T,N>,T2>
+{
+    using type = jet<common_numeric_t<T,T2>,N>;
+};
+//---------------------------------------------------------
+template<class T, std::size_t N, class T2>
+struct common_numeric_type<T2,jet<T,N>>
+{
+    using type = jet<common_numeric_t<T,T2>,N>;
+};
+//---------------------------------------------------------
+template<class T1, class T2, std::size_t N>
+struct common_numeric_type<jet<T1,N>,jet<T2,N>>
+{
+    using type = jet<common_numeric_t<T1,T2>,N>;
+};
+
+
+}  // namespace num
+}  // namespace am
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief  splits [0,n) into contiguous chunks and calls f(begin,end)
+ *         for each chunk on its own thread;
+ *         the calling thread processes the first chunk
+ *
+ * @param  numThreads  upper limit on the number of threads;
+ *                     0 = std::thread::hardware_concurrency()
+ * @param  minChunk    chunks will not be smaller than this
+ *                     (avoids spawning threads for tiny workloads)
+ *
+ * @note   f must not throw
+ *
+ *****************************************************************************/
+template<class F>
+inline void
+parallel_for_chunks(std::size_t n, std::size_t numThreads,
+                    std::size_t minChunk, F&& f)
+{
+    if(n < 1) return;
+    if(numThreads < 1) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(minChunk < 1) minChunk = 1;
+
+    numThreads = std::min(numThreads, (n + minChunk - 1) / minChunk);
+
+    if(numThreads < 2) {
+        f(std::size_t(0), n);
+        return;
+    }
+
+    const auto chunk = (n + numThreads - 1) / numThreads;
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+
+    for(std::size_t b = chunk; b < n; b += chunk) {
+        const auto e = std::min(n, b + chunk);
+        threads.emplace_back([&f,b,e]() noexcept { f(b, e); });
+    }
+    f(std::size_t(0), std::min(n, chunk));
+
+    for(auto& t : threads) t.join();
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  hands out chunks [b,e) of [0,n) with size 'grain' to threads
+ *         on demand (threads that finish early take over remaining
+ *         chunks); each thread first creates its own worker with
+ *         makeWorker() and then calls worker(b,e) for every chunk it takes
+ *
+ * @details per-thread scratch memory can be owned by the worker,
+ *          so that no allocations happen inside the chunk loop;
+ *          the calling thread participates
+ *
+ * @param  numThreads  upper limit on the number of threads;
+ *                     0 = std::thread::hardware_concurrency()
+ *
+ * @note   neither makeWorker nor the workers must throw
+ *
+ *****************************************************************************/
+template<class MakeWorker>
+inline void
+parallel_for_dynamic(std::size_t n, std::size_t numThreads,
+                     std::size_t grain, MakeWorker&& makeWorker)
+{
+    if(n < 1) return;
+    if(numThreads < 1) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(grain < 1) grain = 1;
+
+    const auto numChunks = (n + grain - 1) / grain;
+    numThreads = std::min(numThreads, numChunks);
+
+    std::atomic<std::size_t> next{0};
+
+    const auto run = [&]() noexcept {
+        auto work = makeWorker();
+        for(auto c = next.fetch_add(1, std::memory_order_relaxed);
+            c < numChunks;
+            c = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            const auto b = c * grain;
+            work(b, std::min(n, b + grain));
+        }
+    };
+
+    if(numThreads < 2) {
+        run();
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for(std::size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(run);
+    }
+    run();
+
+    for(auto& t : threads) t.join();
+}
+
+
+}  // namespace num
+}  // namespace am
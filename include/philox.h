@@ -0,0 +1,169 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief  Philox4x32 counter-based random number generator
+ *         (J.K. Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+ *
+ * @details each 128-bit output block is a keyed bijection of a
+ *          128-bit counter: block(i) can be computed for any i without
+ *          generating the blocks before it, so work can be split across
+ *          threads with bit-identical results;
+ *
+ *          the counter consists of a 64-bit block index and a
+ *          64-bit stream id; different streams (or seeds) give
+ *          statistically independent sequences
+ *
+ *          satisfies the UniformRandomBitGenerator concept
+ *
+ *****************************************************************************/
+template<int Rounds = 10>
+class philox4x32
+{
+    static_assert(Rounds > 0, "philox4x32: needs at least one round");
+
+public:
+    //---------------------------------------------------------------
+    using result_type = std::uint32_t;
+    using block_type  = std::array<std::uint32_t,4>;
+    using key_type    = std::array<std::uint32_t,2>;
+
+
+    //---------------------------------------------------------------
+    explicit constexpr
+    philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0) noexcept :
+        key_{{std::uint32_t(seed), std::uint32_t(seed >> 32)}},
+        stream_{stream},
+        index_{0}, buf_{}, used_{4}
+    {}
+
+
+    //---------------------------------------------------------------
+    static constexpr result_type
+    min() noexcept {
+        return 0;
+    }
+    //-----------------------------------------------------
+    static constexpr result_type
+    max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+
+    //---------------------------------------------------------------
+    result_type
+    operator () () noexcept {
+        if(used_ > 3) {
+            buf_ = block(index_++);
+            used_ = 0;
+        }
+        return buf_[used_++];
+    }
+
+    //-----------------------------------------------------
+    void
+    discard(unsigned long long n) noexcept {
+        //rest of the current block
+        const auto left = static_cast<unsigned long long>(4 - used_);
+        if(n <= left) {
+            used_ += int(n);
+            return;
+        }
+        n -= left;
+        //skip whole blocks, then regenerate the partial one
+        index_ += n / 4;
+        used_ = int(n % 4);
+        if(used_ > 0) {
+            buf_ = block(index_++);
+        } else {
+            used_ = 4;
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief output block number 'index' of this engine's stream
+    block_type
+    block(std::uint64_t index) const noexcept {
+        return generate(block_type{{
+            std::uint32_t(index),   std::uint32_t(index >> 32),
+            std::uint32_t(stream_), std::uint32_t(stream_ >> 32) }}, key_);
+    }
+
+    //-----------------------------------------------------
+    const key_type&
+    key() const noexcept {
+        return key_;
+    }
+    //-----------------------------------------------------
+    std::uint64_t
+    stream() const noexcept {
+        return stream_;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief the raw bijection counter -> random block
+    static block_type
+    generate(block_type c, key_type k) noexcept
+    {
+        for(int r = 0; r < Rounds; ++r) {
+            if(r > 0) {
+                k[0] += 0x9E3779B9u;
+                k[1] += 0xBB67AE85u;
+            }
+            const auto p0 = std::uint64_t(0xD2511F53u) * c[0];
+            const auto p1 = std::uint64_t(0xCD9E8D57u) * c[2];
+            c = block_type{{
+                std::uint32_t(p1 >> 32) ^ c[1] ^ k[0], std::uint32_t(p1),
+                std::uint32_t(p0 >> 32) ^ c[3] ^ k[1], std::uint32_t(p0) }};
+        }
+        return c;
+    }
+
+
+    //---------------------------------------------------------------
+    friend bool
+    operator == (const philox4x32& a, const philox4x32& b) noexcept {
+        return a.key_ == b.key_ && a.stream_ == b.stream_ &&
+               a.index_ == b.index_ && a.used_ == b.used_;
+    }
+    //-----------------------------------------------------
+    friend bool
+    operator != (const philox4x32& a, const philox4x32& b) noexcept {
+        return !(a == b);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    key_type key_;
+    std::uint64_t stream_;
+    std::uint64_t index_;
+    block_type buf_;
+    int used_;
+};
+
+
+}  // namespace num
+}  // namespace am
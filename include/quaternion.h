@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cmath>
+#include <array>
 #include <random>
 #include <cstdint>
 #include <cassert>
@@ -19,6 +20,7 @@
 #include "limits.h"
 #include "equality.h"
 #include "conversion.h"
+#include "constexpr_math.h"
 
 
 namespace am {
@@ -94,14 +96,14 @@ public:
 
 
     //---------------------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator = (const quaternion&) = default;
 
-    quaternion&
+    constexpr quaternion&
     operator = (quaternion&&) = default;
     
     template<class T>
-    quaternion&
+    constexpr quaternion&
     operator = (const quaternion<T>& q) {
         w_ = q.real();
         x_ = q.imag_i();
@@ -111,7 +113,7 @@ public:
     }
    
     template<class T>
-    quaternion&
+    constexpr quaternion&
     operator = (quaternion<T>&& q) {
         w_ = std::move(q.real());
         x_ = std::move(q.imag_i());
@@ -144,25 +146,25 @@ public:
 
 
     //---------------------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     real(const value_type& w) {
         w_ = w;
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     imag_i(const value_type& x) {
         x_ = x;
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     imag_j(const value_type& y) {
         y_ = y;
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     imag_k(const value_type& z) {
         z_ = z;
         return *this;
@@ -179,7 +181,7 @@ public:
     //---------------------------------------------------------------
     // SPECIAL SETTERS
     //---------------------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     set_unit() {
         w_ = numeric_type(1);
         x_ = numeric_type(0);
@@ -189,7 +191,7 @@ public:
     }
 
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     conjugate() {
         x_ = -x_;
         y_ = -y_;
@@ -197,20 +199,18 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     invert() {
         conjugate();
         normalize();
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     normalize() {
-        using std::sqrt;
-
         auto norm = w_*w_ + x_*x_ + y_*y_ + z_*z_;
         if(!approx_1(norm)) {
-            norm = numeric_type(1) / sqrt(norm);
+            norm = numeric_type(1) / constexpr_sqrt(norm);
             w_ *= norm;
             x_ *= norm;
             y_ *= norm;
@@ -218,12 +218,29 @@ public:
         }
         return *this;
     }
+    //-----------------------------------------------------
+    /// @brief  cheap renormalization of nearly-unit quaternions
+    /// @details scales by the first-order approximation (3 - |q|^2) / 2
+    ///          of 1/|q| - no sqrt, no division;
+    ///          for |q|^2 = 1 + e the result has |q|^2 = 1 - 3/4 e^2 + O(e^3),
+    ///          e.g. |e| <= 1e-3 gives a norm error below 4e-7;
+    ///          use normalize() for arbitrary input
+    constexpr quaternion&
+    renormalize() {
+        const auto f = (numeric_type(3) - (w_*w_ + x_*x_ + y_*y_ + z_*z_)) /
+                       numeric_type(2);
+        w_ *= f;
+        x_ *= f;
+        y_ *= f;
+        z_ *= f;
+        return *this;
+    }
 
 
     //---------------------------------------------------------------
     // quaternion (op)= numeric_type
     //---------------------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator += (const value_type& v) {
         w_ += v;
         x_ += v;
@@ -232,7 +249,7 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator -= (const value_type& v) {
         w_ -= v;
         x_ -= v;
@@ -241,7 +258,7 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator *= (const value_type& v) {
         w_ *= v;
         x_ *= v;
@@ -250,7 +267,7 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator /= (const value_type& v) {
         w_ /= v;
         x_ /= v;
@@ -263,7 +280,7 @@ public:
     //---------------------------------------------------------------
     // quaternion (op)= quaternion
     //---------------------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator *= (const quaternion& q) {
         const auto p = *this;
 
@@ -276,7 +293,7 @@ public:
     }
 
     //---------------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     times_conj(const quaternion& q) {
         const auto p = *this;
 
@@ -288,7 +305,7 @@ public:
         return *this;
     }
     //---------------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     conj_times(const quaternion& q) {
         const auto p = *this;
 
@@ -301,7 +318,7 @@ public:
     }
 
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator += (const quaternion& q) {
         w_ += q.real();
         x_ += q.imag_i();
@@ -310,7 +327,7 @@ public:
         return *this;
     }
     //-----------------------------------------------------
-    quaternion&
+    constexpr quaternion&
     operator -= (const quaternion& q) {
         w_ -= q.real();
         x_ -= q.imag_i();
@@ -476,7 +493,7 @@ operator - (const quaternion<T1>& a, const quaternion<T2>& b)
 
 //---------------------------------------------------------
 template<class T1, class T2>
-inline quaternion<common_numeric_t<T1,T2>>
+inline constexpr quaternion<common_numeric_t<T1,T2>>
 times_inverse(const quaternion<T1>& p, quaternion<T2> q)
 {
     q.invert();
@@ -484,7 +501,7 @@ times_inverse(const quaternion<T1>& p, quaternion<T2> q)
 }
 //---------------------------------------------------------
 template<class T1, class T2>
-inline quaternion<common_numeric_t<T1,T2>>
+inline constexpr quaternion<common_numeric_t<T1,T2>>
 inverse_times(quaternion<T1> p, const quaternion<T2>& q)
 {
     p.invert();
@@ -528,7 +545,7 @@ conj_times(const quaternion<T1>& p, const quaternion<T2>& q)
 // INVERT
 //-------------------------------------------------------------------
 template<class T>
-inline quaternion<T>
+inline constexpr quaternion<T>
 inverse(quaternion<T> q)
 {
     q.invert();
@@ -553,13 +570,24 @@ conj(const quaternion<T>& q)
 // NORMALIZE
 //-------------------------------------------------------------------
 template<class T>
-inline quaternion<T>
+inline constexpr quaternion<T>
 normalized(quaternion<T> q)
 {
     q.normalize();
     return q;
 }
 
+//---------------------------------------------------------
+/// @brief cheap renormalization of nearly-unit quaternions
+/// @see   quaternion::renormalize
+template<class T>
+inline constexpr quaternion<T>
+renormalized(quaternion<T> q)
+{
+    q.renormalize();
+    return q;
+}
+
 
 
 /*****************************************************************************
@@ -579,11 +607,10 @@ norm2(const quaternion<T>& q)
 
 //---------------------------------------------------------
 template<class T>
-inline auto
+inline constexpr auto
 norm(const quaternion<T>& q)
 {
-    using std::sqrt;
-    return sqrt(norm2(q));
+    return constexpr_sqrt(norm2(q));
 }
 
 //---------------------------------------------------------
@@ -661,7 +688,7 @@ real_product(const quaternion<T1>& p, const quaternion<T2>& q)
 
 //---------------------------------------------------------
 template<class T1, class T2, class T3>
-inline void
+inline constexpr void
 real_product(
     const quaternion<T1>& p, const quaternion<T2>& q, quaternion<T3>& r)
 {
@@ -693,7 +720,7 @@ imag_product(const quaternion<T1>& p, const quaternion<T2>& q)
 
 //---------------------------------------------------------
 template<class T1, class T2, class T3>
-inline void
+inline constexpr void
 imag_product(
     const quaternion<T1>& p, const quaternion<T2>& q, quaternion<T3>& r)
 {
@@ -708,6 +735,38 @@ imag_product(
 
 
 
+/*****************************************************************************
+ *
+ * ROTATION
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief  rotates 3D vector v by unit quaternion q (= q * (0,v) * q^-1)
+/// @details uses the cross product form
+///          t = 2 * (q.xyz x v);  v' = v + w * t + q.xyz x t
+///          which needs 18 multiplications instead of two full
+///          Hamilton products
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline constexpr std::array<common_numeric_t<T1,T2>,3>
+rotate(const quaternion<T1>& q, const std::array<T2,3>& v)
+{
+    using T = common_numeric_t<T1,T2>;
+
+    const T tx = T(2) * (q.imag_j()*v[2] - q.imag_k()*v[1]);
+    const T ty = T(2) * (q.imag_k()*v[0] - q.imag_i()*v[2]);
+    const T tz = T(2) * (q.imag_i()*v[1] - q.imag_j()*v[0]);
+
+    return std::array<T,3>{{
+        v[0] + q.real()*tx + (q.imag_j()*tz - q.imag_k()*ty),
+        v[1] + q.real()*ty + (q.imag_k()*tx - q.imag_i()*tz),
+        v[2] + q.real()*tz + (q.imag_i()*ty - q.imag_j()*tx) }};
+}
+
+
+
+
 /*****************************************************************************
  *
  * GENERATION
@@ -806,6 +865,35 @@ lerp(const quaternion<T1>& qFrom, const quaternion<T2>& qTo, T3 t)
 
 
 
+//-------------------------------------------------------------------
+// normalized linear interpolation along the shortest path
+//-------------------------------------------------------------------
+template<class T1, class T2, class T3,
+    class = std::enable_if_t<is_number<T3>::value>
+>
+inline quaternion<common_numeric_t<T1,T2,T3>>
+nlerp(const quaternion<T1>& qFrom, const quaternion<T2>& qTo, T3 t)
+{
+    using q_t = common_numeric_t<T1,T2,T3>;
+
+    assert((t >= T3(0)) && (t <= T3(1)));
+
+    const auto t0 = q_t(1) - q_t(t);
+    const auto t1 = (dot(qFrom, qTo) < q_t(0)) ? q_t(-t) : q_t(t);
+
+    auto out = quaternion<q_t>{
+        qFrom.real()   * t0 + qTo.real()   * t1,
+        qFrom.imag_i() * t0 + qTo.imag_i() * t1,
+        qFrom.imag_j() * t0 + qTo.imag_j() * t1,
+        qFrom.imag_k() * t0 + qTo.imag_k() * t1};
+
+    out.normalize();
+
+    return out;
+}
+
+
+
 //-------------------------------------------------------------------
 // spherical linear interpolation
 //-------------------------------------------------------------------
@@ -879,75 +967,73 @@ squad(
 {
     assert((t >= T4(0)) && (t <= T4(1)));
 
-    return quat_slerp(
-                quat_slerp(q0,q3,t),
-                quat_slerp(q1,q2,t), T4(2)*t*(T4(1)-t));
+    return slerp(
+                slerp(q0,q3,t),
+                slerp(q1,q2,t), T4(2)*t*(T4(1)-t));
 }
 
 
 
 //-------------------------------------------------------------------
-// log function application
+/// @brief  log(q) = [log|q|, v/|v| * atan2(|v|,w)]
+///         where w is the real and v the vector part of q
 //-------------------------------------------------------------------
 template<class T>
 inline quaternion<T>
 log(const quaternion<T>& q)
 {
-    using std::sin;
-    using std::acos;
+    using std::sqrt;
+    using std::log;
+    using std::atan2;
 
-    const auto phi = acos(q.real());
-    const auto sinPhi = sin(phi);
+    const auto vnorm2 = q.imag_i()*q.imag_i() +
+                        q.imag_j()*q.imag_j() +
+                        q.imag_k()*q.imag_k();
 
-    if(sinPhi > T(0)) {
-        return quaternion<T>{
-            T(0),
-            phi * q.imag_i() / sinPhi,
-            phi * q.imag_j() / sinPhi,
-            phi * q.imag_k() / sinPhi};
-    }
+    const auto vnorm = sqrt(vnorm2);
+    const auto qnorm = sqrt(q.real()*q.real() + vnorm2);
+
+    //atan2 is accurate for small angles where acos(w/|q|) is not
+    const auto s = (vnorm > T(0)) ? (atan2(vnorm, q.real()) / vnorm) : T(0);
 
-    return quaternion<T>{T(0), T(0), T(0), T(0)};
+    return quaternion<T>{
+        log(qnorm), s * q.imag_i(), s * q.imag_j(), s * q.imag_k()};
 }
 
 
 //-------------------------------------------------------------------
-/// @brief e^quat = exp(v*phi) = [cos(phi),vsin(phi)]
+/// @brief  exp(q) = e^w * [cos|v|, v/|v| * sin|v|]
+///         where w is the real and v the vector part of q
 //-------------------------------------------------------------------
 template<class T>
 inline quaternion<T>
 exp(const quaternion<T>& q)
 {
+    using std::sqrt;
+    using std::exp;
     using std::sin;
     using std::cos;
 
-    const auto phi = q.imag_i()*q.imag_i() +
-                     q.imag_j()*q.imag_j() +
-                     q.imag_k()*q.imag_k();
-
-    const auto sinPhi = sin(phi);
-    const auto cosPhi = cos(phi);
+    const auto vnorm = sqrt(q.imag_i()*q.imag_i() +
+                            q.imag_j()*q.imag_j() +
+                            q.imag_k()*q.imag_k());
 
-    if(phi > T(0)) {
-        return quaternion<T>{
-            cosPhi,
-            sinPhi * q.imag_i() / phi,
-            sinPhi * q.imag_j() / phi,
-            sinPhi * q.imag_k() / phi};
-    }
+    const auto ew = exp(q.real());
+    const auto s = (vnorm > T(0)) ? (ew * sin(vnorm) / vnorm) : ew;
 
-    return quaternion<T>{cosPhi, T(0), T(0), T(0)};
+    return quaternion<T>{
+        ew * cos(vnorm), s * q.imag_i(), s * q.imag_j(), s * q.imag_k()};
 }
 
 
 //-------------------------------------------------------------------
-/// @brief e^quat = exp(v*phi) = [cos(phi),vsin(phi)]
+/// @brief q^e = exp(e * log(q))
 //-------------------------------------------------------------------
-template<class T1, class T2>
+template<class T1, class T2, class = std::enable_if_t<is_number<T2>::value>>
 inline quaternion<common_numeric_t<T1,T2>>
 pow(const quaternion<T1>& q, const T2& exponent)
 {
-    return exp(log(q) * exponent);
+    return exp(exponent * log(q));
 }
 
 
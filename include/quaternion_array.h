@@ -0,0 +1,628 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include "quaternion.h"
+#include "simd.h"
+#include "parallel.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief pointers to the 4 component lanes of a structure-of-arrays
+ *        quaternion sequence; T may be const-qualified
+ *
+ *****************************************************************************/
+template<class T>
+struct quaternion_lanes
+{
+    T* w;
+    T* x;
+    T* y;
+    T* z;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief pointers to the 3 coordinate lanes of a structure-of-arrays
+ *        sequence of 3D vectors (e.g. a point cloud); T may be const
+ *
+ *****************************************************************************/
+template<class T>
+struct vector3_lanes
+{
+    T* x;
+    T* y;
+    T* z;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  structure-of-arrays quaternion sequence
+ *
+ * @details each component (w,x,y,z) is stored in a separate, aligned lane
+ *          so that batch operations can process several quaternions
+ *          per vector instruction
+ *
+ *****************************************************************************/
+template<class NumberT>
+class quaternion_array
+{
+    static_assert(
+        is_floating_point<NumberT>::value,
+        "quaternion_array<T>: T must be a floating-point number type");
+
+    using lane_type = std::vector<NumberT,simd::aligned_allocator<NumberT>>;
+
+public:
+    //---------------------------------------------------------------
+    using numeric_type = NumberT;
+    using value_type   = quaternion<numeric_type>;
+    using size_type    = std::size_t;
+
+
+    //---------------------------------------------------------------
+    quaternion_array() = default;
+
+    /// @brief n unit quaternions
+    explicit
+    quaternion_array(size_type n):
+        w_(n, numeric_type(1)),
+        x_(n, numeric_type(0)),
+        y_(n, numeric_type(0)),
+        z_(n, numeric_type(0))
+    {}
+
+    /// @brief n copies of q
+    quaternion_array(size_type n, const value_type& q):
+        w_(n, q.real()),
+        x_(n, q.imag_i()),
+        y_(n, q.imag_j()),
+        z_(n, q.imag_k())
+    {}
+
+    /// @brief from range of quaternions (array-of-structures)
+    template<class InputIter>
+    quaternion_array(InputIter first, InputIter last)
+    {
+        for(; first != last; ++first) push_back(*first);
+    }
+
+    //-----------------------------------------------------
+    explicit
+    quaternion_array(const std::vector<value_type>& v):
+        w_(v.size()), x_(v.size()), y_(v.size()), z_(v.size())
+    {
+        for(size_type i = 0; i < v.size(); ++i) set(i, v[i]);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return w_.size();
+    }
+
+    bool
+    empty() const noexcept {
+        return w_.empty();
+    }
+
+    //-----------------------------------------------------
+    void
+    reserve(size_type n) {
+        w_.reserve(n);
+        x_.reserve(n);
+        y_.reserve(n);
+        z_.reserve(n);
+    }
+
+    void
+    resize(size_type n, const value_type& q = value_type{}) {
+        w_.resize(n, q.real());
+        x_.resize(n, q.imag_i());
+        y_.resize(n, q.imag_j());
+        z_.resize(n, q.imag_k());
+    }
+
+    void
+    clear() noexcept {
+        w_.clear();
+        x_.clear();
+        y_.clear();
+        z_.clear();
+    }
+
+    //-----------------------------------------------------
+    void
+    push_back(const value_type& q) {
+        w_.push_back(q.real());
+        x_.push_back(q.imag_i());
+        y_.push_back(q.imag_j());
+        z_.push_back(q.imag_k());
+    }
+
+
+    //---------------------------------------------------------------
+    // ELEMENT ACCESS
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        return value_type{w_[i], x_[i], y_[i], z_[i]};
+    }
+
+    //-----------------------------------------------------
+    quaternion_array&
+    set(size_type i, const value_type& q) noexcept {
+        w_[i] = q.real();
+        x_[i] = q.imag_i();
+        y_[i] = q.imag_j();
+        z_[i] = q.imag_k();
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // LANE ACCESS
+    //---------------------------------------------------------------
+    numeric_type*       w() noexcept       { return w_.data(); }
+    const numeric_type* w() const noexcept { return w_.data(); }
+    numeric_type*       x() noexcept       { return x_.data(); }
+    const numeric_type* x() const noexcept { return x_.data(); }
+    numeric_type*       y() noexcept       { return y_.data(); }
+    const numeric_type* y() const noexcept { return y_.data(); }
+    numeric_type*       z() noexcept       { return z_.data(); }
+    const numeric_type* z() const noexcept { return z_.data(); }
+
+    //-----------------------------------------------------
+    quaternion_lanes<numeric_type>
+    lanes() noexcept {
+        return {w_.data(), x_.data(), y_.data(), z_.data()};
+    }
+
+    quaternion_lanes<const numeric_type>
+    lanes() const noexcept {
+        return {w_.data(), x_.data(), y_.data(), z_.data()};
+    }
+
+
+private:
+    lane_type w_;
+    lane_type x_;
+    lane_type y_;
+    lane_type z_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * CONVENIENCE DEFINITIONS
+ *
+ *****************************************************************************/
+using quatf_array  = quaternion_array<float>;
+using quatd_array  = quaternion_array<double>;
+using quatld_array = quaternion_array<long double>;
+using quat_array   = quaternion_array<real_t>;
+
+
+
+
+/*****************************************************************************
+ *
+ * CONVERSION
+ *
+ *****************************************************************************/
+template<class T>
+inline quaternion_array<T>
+make_quaternion_array(const std::vector<quaternion<T>>& v)
+{
+    return quaternion_array<T>{v};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline std::vector<quaternion<T>>
+make_quaternion_vector(const quaternion_array<T>& a)
+{
+    auto v = std::vector<quaternion<T>>{};
+    v.reserve(a.size());
+    for(std::size_t i = 0; i < a.size(); ++i) v.push_back(a[i]);
+    return v;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * BATCH KERNELS
+ *
+ * @details all kernels allow the output to alias one of the inputs;
+ *          the output is resized to match the input size
+ *
+ *****************************************************************************/
+namespace detail {
+
+/// @brief loads 4 lanes at offset i into packs
+template<class P, class T>
+struct quat_pack
+{
+    P w, x, y, z;
+
+    static quat_pack
+    load(const quaternion_lanes<T>& q, std::size_t i) noexcept {
+        return {P::load(q.w+i), P::load(q.x+i), P::load(q.y+i), P::load(q.z+i)};
+    }
+
+    static quat_pack
+    broadcast(const quaternion<std::remove_const_t<T>>& q) noexcept {
+        return {P::broadcast(q.real()),   P::broadcast(q.imag_i()),
+                P::broadcast(q.imag_j()), P::broadcast(q.imag_k())};
+    }
+
+    void
+    store(const quaternion_lanes<std::remove_const_t<T>>& q, std::size_t i) const noexcept {
+        w.store(q.w+i); x.store(q.x+i); y.store(q.y+i); z.store(q.z+i);
+    }
+};
+
+
+//-------------------------------------------------------------------
+template<class Q>
+inline Q
+hamilton_product(const Q& p, const Q& q) noexcept
+{
+    return Q{
+        p.w*q.w - p.x*q.x - p.y*q.y - p.z*q.z,
+        p.w*q.x + p.x*q.w + p.y*q.z - p.z*q.y,
+        p.w*q.y - p.x*q.z + p.y*q.w + p.z*q.x,
+        p.w*q.z + p.x*q.y - p.y*q.x + p.z*q.w };
+}
+
+//---------------------------------------------------------
+template<class Q>
+inline Q
+times_conj_product(const Q& p, const Q& q) noexcept
+{
+    return Q{
+         p.w*q.w + p.x*q.x + p.y*q.y + p.z*q.z,
+        -p.w*q.x + p.x*q.w - p.y*q.z + p.z*q.y,
+        -p.w*q.y + p.x*q.z + p.y*q.w - p.z*q.x,
+        -p.w*q.z - p.x*q.y + p.y*q.x + p.z*q.w };
+}
+
+//---------------------------------------------------------
+template<class Q>
+inline Q
+conj_times_product(const Q& p, const Q& q) noexcept
+{
+    return Q{
+        p.w*q.w + p.x*q.x + p.y*q.y + p.z*q.z,
+        p.w*q.x - p.x*q.w - p.y*q.z + p.z*q.y,
+        p.w*q.y + p.x*q.z - p.y*q.w - p.z*q.x,
+        p.w*q.z - p.x*q.y + p.y*q.x - p.z*q.w };
+}
+
+
+//-------------------------------------------------------------------
+template<class T, class F>
+inline void
+binary_quat_kernel(
+    const quaternion_array<T>& a, const quaternion_array<T>& b,
+    quaternion_array<T>& out, F&& f)
+{
+    assert(a.size() == b.size());
+
+    const auto n = a.size();
+    out.resize(n);
+    const auto la = a.lanes();
+    const auto lb = b.lanes();
+    const auto lo = out.lanes();
+
+    simd::for_each_pack<T>(n, [&](auto tag, std::size_t i) {
+        using q_t = quat_pack<decltype(tag),const T>;
+        f(q_t::load(la,i), q_t::load(lb,i)).store(lo,i);
+    });
+}
+
+} // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = a[i] * b[i]
+template<class T>
+inline void
+multiply(const quaternion_array<T>& a, const quaternion_array<T>& b,
+         quaternion_array<T>& out)
+{
+    detail::binary_quat_kernel(a, b, out, [](const auto& p, const auto& q) {
+        return detail::hamilton_product(p, q);
+    });
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = q * a[i]
+template<class T>
+inline void
+multiply(const quaternion<T>& q, const quaternion_array<T>& a,
+         quaternion_array<T>& out)
+{
+    const auto n = a.size();
+    out.resize(n);
+    const auto la = a.lanes();
+    const auto lo = out.lanes();
+
+    simd::for_each_pack<T>(n, [&](auto tag, std::size_t i) {
+        using q_t = detail::quat_pack<decltype(tag),const T>;
+        detail::hamilton_product(q_t::broadcast(q), q_t::load(la,i)).store(lo,i);
+    });
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = a[i] * q
+template<class T>
+inline void
+multiply(const quaternion_array<T>& a, const quaternion<T>& q,
+         quaternion_array<T>& out)
+{
+    const auto n = a.size();
+    out.resize(n);
+    const auto la = a.lanes();
+    const auto lo = out.lanes();
+
+    simd::for_each_pack<T>(n, [&](auto tag, std::size_t i) {
+        using q_t = detail::quat_pack<decltype(tag),const T>;
+        detail::hamilton_product(q_t::load(la,i), q_t::broadcast(q)).store(lo,i);
+    });
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = a[i] * conj(b[i])
+template<class T>
+inline void
+times_conj(const quaternion_array<T>& a, const quaternion_array<T>& b,
+           quaternion_array<T>& out)
+{
+    detail::binary_quat_kernel(a, b, out, [](const auto& p, const auto& q) {
+        return detail::times_conj_product(p, q);
+    });
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = conj(a[i]) * b[i]
+template<class T>
+inline void
+conj_times(const quaternion_array<T>& a, const quaternion_array<T>& b,
+           quaternion_array<T>& out)
+{
+    detail::binary_quat_kernel(a, b, out, [](const auto& p, const auto& q) {
+        return detail::conj_times_product(p, q);
+    });
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = conj(a[i]) / norm2(a[i])
+/// @note  unlike quaternion::invert() this is the true inverse
+///        for non-unit quaternions as well
+template<class T>
+inline void
+inverse(const quaternion_array<T>& a, quaternion_array<T>& out)
+{
+    const auto n = a.size();
+    out.resize(n);
+    const auto la = a.lanes();
+    const auto lo = out.lanes();
+
+    simd::for_each_pack<T>(n, [&](auto tag, std::size_t i) {
+        using p_t = decltype(tag);
+        const auto q = detail::quat_pack<p_t,const T>::load(la,i);
+        const auto s = p_t::broadcast(T(1)) /
+                       (q.w*q.w + q.x*q.x + q.y*q.y + q.z*q.z);
+        const auto ns = -s;
+        detail::quat_pack<p_t,const T>{q.w*s, q.x*ns, q.y*ns, q.z*ns}.store(lo,i);
+    });
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief q[i] = q[i] / |q[i]|  (exact: sqrt + division)
+template<class T>
+inline void
+normalize(quaternion_array<T>& q)
+{
+    const auto lq = q.lanes();
+
+    simd::for_each_pack<T>(q.size(), [&](auto tag, std::size_t i) {
+        using p_t = decltype(tag);
+        using q_t = detail::quat_pack<p_t,T>;
+        const auto a = q_t::load(lq,i);
+        const auto s = p_t::broadcast(T(1)) /
+                       sqrt(a.w*a.w + a.x*a.x + a.y*a.y + a.z*a.z);
+        q_t{a.w*s, a.x*s, a.y*s, a.z*s}.store(lq,i);
+    });
+}
+
+//---------------------------------------------------------
+/// @brief  q[i] = q[i] / |q[i]| using a reciprocal square root estimate
+///         refined by Newton-Raphson steps (see simd::rsqrt)
+/// @details resulting norm error is below 1e-6 (float) / 1e-12 (double);
+///          for non-vectorized types this is identical to normalize
+template<class T>
+inline void
+normalize_fast(quaternion_array<T>& q)
+{
+    const auto lq = q.lanes();
+
+    simd::for_each_pack<T>(q.size(), [&](auto tag, std::size_t i) {
+        using p_t = decltype(tag);
+        using q_t = detail::quat_pack<p_t,T>;
+        const auto a = q_t::load(lq,i);
+        const auto s = rsqrt(a.w*a.w + a.x*a.x + a.y*a.y + a.z*a.z);
+        q_t{a.w*s, a.x*s, a.y*s, a.z*s}.store(lq,i);
+    });
+}
+
+//---------------------------------------------------------
+/// @brief  cheap renormalization of nearly-unit quaternions
+///         (first-order correction, no sqrt / division)
+/// @see    quaternion::renormalize for error bound
+template<class T>
+inline void
+renormalize(quaternion_array<T>& q)
+{
+    const auto lq = q.lanes();
+
+    simd::for_each_pack<T>(q.size(), [&](auto tag, std::size_t i) {
+        using p_t = decltype(tag);
+        using q_t = detail::quat_pack<p_t,T>;
+        const auto a = q_t::load(lq,i);
+        const auto f = (p_t::broadcast(T(3)) -
+                        (a.w*a.w + a.x*a.x + a.y*a.y + a.z*a.z)) *
+                       p_t::broadcast(T(0.5));
+        q_t{a.w*f, a.x*f, a.y*f, a.z*f}.store(lq,i);
+    });
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * BATCH ROTATION
+ *
+ * @details rotates n vectors stored in SoA lanes;
+ *          'out' may alias 'in'
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<class P>
+inline void
+rotate_packs(const P& qw, const P& qx, const P& qy, const P& qz,
+             P& x, P& y, P& z) noexcept
+{
+    const auto two = P::broadcast(typename P::value_type(2));
+
+    const auto tx = two * (qy*z - qz*y);
+    const auto ty = two * (qz*x - qx*z);
+    const auto tz = two * (qx*y - qy*x);
+
+    x = x + mul_add(qw, tx, qy*tz - qz*ty);
+    y = y + mul_add(qw, ty, qz*tx - qx*tz);
+    z = z + mul_add(qw, tz, qx*ty - qy*tx);
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+rotate_range(const quaternion<T>& q,
+             const vector3_lanes<const T>& in, const vector3_lanes<T>& out,
+             std::size_t first, std::size_t last) noexcept
+{
+    simd::for_each_pack<T>(last - first, [&](auto tag, std::size_t j) {
+        using p_t = decltype(tag);
+        const auto i = first + j;
+        const auto qw = p_t::broadcast(q.real());
+        const auto qx = p_t::broadcast(q.imag_i());
+        const auto qy = p_t::broadcast(q.imag_j());
+        const auto qz = p_t::broadcast(q.imag_k());
+        auto x = p_t::load(in.x+i);
+        auto y = p_t::load(in.y+i);
+        auto z = p_t::load(in.z+i);
+        rotate_packs(qw, qx, qy, qz, x, y, z);
+        x.store(out.x+i);
+        y.store(out.y+i);
+        z.store(out.z+i);
+    });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+rotate_range(const quaternion_lanes<const T>& q,
+             const vector3_lanes<const T>& in, const vector3_lanes<T>& out,
+             std::size_t first, std::size_t last) noexcept
+{
+    simd::for_each_pack<T>(last - first, [&](auto tag, std::size_t j) {
+        using p_t = decltype(tag);
+        const auto i = first + j;
+        auto x = p_t::load(in.x+i);
+        auto y = p_t::load(in.y+i);
+        auto z = p_t::load(in.z+i);
+        rotate_packs(p_t::load(q.w+i), p_t::load(q.x+i),
+                     p_t::load(q.y+i), p_t::load(q.z+i), x, y, z);
+        x.store(out.x+i);
+        y.store(out.y+i);
+        z.store(out.z+i);
+    });
+}
+
+} // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = rotate(q, in[i]) for i in [0,n); q must be a unit quaternion
+/// @param numThreads  number of threads to split the work across
+///                    (1 = run on calling thread, 0 = all hardware threads)
+//-------------------------------------------------------------------
+template<class T>
+inline void
+rotate(const quaternion<T>& q, std::size_t n,
+       const vector3_lanes<const T>& in, const vector3_lanes<T>& out,
+       std::size_t numThreads = 1)
+{
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::rotate_range(q, in, out, b, e);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = rotate(q[i], in[i]) for i in [0,q.size())
+template<class T>
+inline void
+rotate(const quaternion_array<T>& q,
+       const vector3_lanes<const T>& in, const vector3_lanes<T>& out,
+       std::size_t numThreads = 1)
+{
+    const auto lq = q.lanes();
+    parallel_for_chunks(q.size(), numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::rotate_range(lq, in, out, b, e);
+        });
+}
+
+
+}  // namespace num
+}  // namespace am
@@ -0,0 +1,253 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+#include "quaternion_array.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * PRODUCT CHAINS
+ *
+ * @details quaternion multiplication is associative (but not commutative),
+ *          so a chain q[0] * q[1] * ... * q[n-1] can be evaluated as an
+ *          order-preserving tree instead of a serial left fold:
+ *          this allows parallel evaluation and lets rounding errors grow
+ *          with O(log n) instead of O(n)
+ *
+ *****************************************************************************/
+namespace detail {
+
+/// @brief pairwise product of get(first), ..., get(first+n-1)
+template<class Get>
+inline auto
+compose_pairwise(const Get& get, std::size_t first, std::size_t n)
+{
+    using q_t = std::decay_t<decltype(get(first))>;
+
+    //serial fold below a small block size
+    if(n <= 8) {
+        auto q = q_t{};
+        for(std::size_t i = 0; i < n; ++i) q *= get(first + i);
+        return q;
+    }
+    const auto h = n / 2;
+    auto q = compose_pairwise(get, first, h);
+    q *= compose_pairwise(get, first + h, n - h);
+    return q;
+}
+
+//---------------------------------------------------------
+/// @brief number of chunks for parallel evaluation
+inline std::size_t
+compose_chunk_count(std::size_t n, std::size_t numThreads)
+{
+    if(numThreads < 1) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return std::max(std::size_t(1),
+                    std::min(numThreads, n / std::size_t(1 << 14)));
+}
+
+//---------------------------------------------------------
+/// @brief get(0) * ... * get(n-1)
+template<class Get>
+inline auto
+compose(const Get& get, std::size_t n, std::size_t numThreads)
+{
+    using q_t = std::decay_t<decltype(get(0))>;
+
+    const auto k = compose_chunk_count(n, numThreads);
+    if(k < 2) return compose_pairwise(get, 0, n);
+
+    //chunk products in parallel, then combine them in order
+    const auto chunk = (n + k - 1) / k;
+    std::vector<q_t> partial(k);
+
+    parallel_for_chunks(k, k, 1, [&](std::size_t b, std::size_t e) {
+        for(auto c = b; c < e; ++c) {
+            const auto cb = c * chunk;
+            const auto ce = std::min(n, cb + chunk);
+            partial[c] = compose_pairwise(get, cb, ce - cb);
+        }
+    });
+
+    return compose_pairwise(
+        [&partial](std::size_t i) -> const q_t& { return partial[i]; }, 0, k);
+}
+
+} // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief returns (*first) * (*(first+1)) * ... * (*(last-1));
+///        identity for an empty range
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+//-------------------------------------------------------------------
+template<class RandomAccessIter>
+inline auto
+compose(RandomAccessIter first, RandomAccessIter last,
+        std::size_t numThreads = 1)
+{
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    return detail::compose(
+        [first](std::size_t i) -> decltype(auto) { return first[i]; },
+        n, numThreads);
+}
+
+//---------------------------------------------------------
+/// @brief q[0] * ... * q[n-1], read directly from the lanes
+template<class T>
+inline quaternion<T>
+compose(const quaternion_array<T>& q, std::size_t numThreads = 1)
+{
+    return detail::compose(
+        [&q](std::size_t i) { return q[i]; }, q.size(), numThreads);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * PREFIX PRODUCTS
+ *
+ * @details out[i] = in[0] * in[1] * ... * in[i]  (every partial pose)
+ *
+ *          for chains of unit quaternions the accumulated product can
+ *          be normalized every 'renormInterval' steps which keeps the
+ *          norm error bounded independent of the chain length;
+ *          0 (default) disables normalization and must be used for
+ *          chains of non-unit quaternions
+ *
+ *          parallel evaluation uses 3 phases: chunk products,
+ *          serial scan over the chunk products, chunk-local scans
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<class Get, class Put, class Q>
+inline void
+partial_compose_serial(const Get& get, const Put& put,
+                       std::size_t first, std::size_t last,
+                       Q q, std::size_t renormInterval)
+{
+    std::size_t k = 0;
+    for(; first != last; ++first) {
+        q *= get(first);
+        if(++k == renormInterval) {
+            q.normalize();
+            k = 0;
+        }
+        put(first, q);
+    }
+}
+
+//---------------------------------------------------------
+/// @brief put(i, get(0) * ... * get(i)) for i in [0,n)
+template<class Get, class Put>
+inline void
+partial_compose(const Get& get, const Put& put, std::size_t n,
+                std::size_t renormInterval, std::size_t numThreads)
+{
+    using q_t = std::decay_t<decltype(get(0))>;
+
+    const auto k = compose_chunk_count(n, numThreads);
+    if(k < 2) {
+        partial_compose_serial(get, put, 0, n, q_t{}, renormInterval);
+        return;
+    }
+
+    const auto chunk = (n + k - 1) / k;
+    std::vector<q_t> offset(k);
+
+    //phase 1: products of all chunks but the last
+    parallel_for_chunks(k - 1, k - 1, 1, [&](std::size_t b, std::size_t e) {
+        for(auto c = b; c < e; ++c) {
+            offset[c+1] = compose_pairwise(get, c * chunk, chunk);
+        }
+    });
+
+    //phase 2: exclusive scan over chunk products
+    for(std::size_t c = 1; c < k; ++c) {
+        offset[c] = offset[c-1] * offset[c];
+        if(renormInterval > 0) offset[c].normalize();
+    }
+
+    //phase 3: local scans, starting at the chunk offsets
+    parallel_for_chunks(k, k, 1, [&](std::size_t b, std::size_t e) {
+        for(auto c = b; c < e; ++c) {
+            const auto cb = c * chunk;
+            const auto ce = std::min(n, cb + chunk);
+            partial_compose_serial(get, put, cb, ce, offset[c], renormInterval);
+        }
+    });
+}
+
+} // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = in[0] * ... * in[i] for all i in [0, last-first)
+/// @param renormInterval  normalize the running product every
+///                        n steps (0 = never); requires unit quaternions
+/// @param numThreads      1 = run on calling thread, 0 = all hardware threads
+/// @return end of the output range
+/// @note  'out' may be equal to 'first'
+//-------------------------------------------------------------------
+template<class RandomAccessIter, class RandomAccessOutIter, class =
+    typename std::iterator_traits<RandomAccessIter>::iterator_category>
+inline RandomAccessOutIter
+partial_compose(RandomAccessIter first, RandomAccessIter last,
+                RandomAccessOutIter out,
+                std::size_t renormInterval = 0,
+                std::size_t numThreads = 1)
+{
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    detail::partial_compose(
+        [first](std::size_t i) -> decltype(auto) { return first[i]; },
+        [out](std::size_t i, const auto& q) { out[i] = q; },
+        n, renormInterval, numThreads);
+    return out + n;
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = q[0] * ... * q[i], read from and written to the lanes;
+///        'out' is resized to match the input and may be 'q' itself
+template<class T>
+inline void
+partial_compose(const quaternion_array<T>& q, quaternion_array<T>& out,
+                std::size_t renormInterval = 0,
+                std::size_t numThreads = 1)
+{
+    out.resize(q.size());
+    detail::partial_compose(
+        [&q](std::size_t i) { return q[i]; },
+        [&out](std::size_t i, const quaternion<T>& x) { out.set(i, x); },
+        q.size(), renormInterval, numThreads);
+}
+
+
+}  // namespace num
+}  // namespace am
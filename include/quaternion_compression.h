@@ -0,0 +1,551 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "half.h"
+#include "quaternion_array.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief  unit quaternion packed into 32, 48 or 64 bits
+ *         ("smallest three" encoding)
+ *
+ * @details q and -q represent the same rotation, so the component with
+ *          the largest magnitude is made positive and dropped; the
+ *          other three lie in [-1/sqrt(2), 1/sqrt(2)] and are quantized
+ *          uniformly with b = (Bits-2)/3 bits each;
+ *          the 2 remaining bits hold the index of the dropped component
+ *
+ *            Bits   bytes   b    max. angular error (rad)
+ *             32      4    10    4.9e-3   (0.28 degrees)
+ *             48      6    15    1.6e-4
+ *             64      8    20    4.8e-6
+ *
+ *          the error bound is 5/(2^b-2) (see max_angle_error()):
+ *          quantization step d = sqrt(2)/(2^b-2), per-component error
+ *          <= d/2, the dropped component is >= 1/2 which at most doubles
+ *          the error on the unit sphere and the rotation angle is twice
+ *          the sphere distance: 2 * 2 * sqrt(3)/2 * d = 2 sqrt(6)/(2^b-2);
+ *
+ *          unpacked quaternions are unit quaternions (up to rounding);
+ *          the identity is represented exactly
+ *
+ *****************************************************************************/
+template<int Bits>
+class packed_quaternion
+{
+    static_assert(Bits == 32 || Bits == 48 || Bits == 64,
+        "packed_quaternion<Bits>: Bits must be 32, 48 or 64");
+
+public:
+    //---------------------------------------------------------------
+    using storage_type = std::conditional_t<Bits == 32, std::uint32_t,
+                         std::conditional_t<Bits == 48, std::array<std::uint16_t,3>,
+                                                        std::uint64_t>>;
+
+    /// @brief bits per stored component
+    static constexpr int component_bits = (Bits - 2) / 3;
+
+    /// @brief largest code; even, so that 0 is representable (code max/2)
+    static constexpr std::uint64_t max_code =
+        (std::uint64_t(1) << component_bits) - 2;
+
+
+    //---------------------------------------------------------------
+    /// @brief identity
+    constexpr
+    packed_quaternion() noexcept :
+        data_{}
+    {
+        assign((max_code/2 << (2*component_bits)) |
+               (max_code/2 << component_bits) | (max_code/2));
+    }
+
+    //-----------------------------------------------------
+    /// @brief packs q (which should be normalized)
+    template<class T>
+    explicit
+    packed_quaternion(const quaternion<T>& q) noexcept :
+        data_{}
+    {
+        using p_t = simd::pack<T,1>;
+        T f[4] = {q.real(), q.imag_i(), q.imag_j(), q.imag_k()};
+        for(auto& c : f) code_point(p_t{c}).store(&c);
+        assign(encode(q.real(), q.imag_i(), q.imag_j(), q.imag_k(), f));
+    }
+
+
+    //---------------------------------------------------------------
+    static packed_quaternion
+    from_data(const storage_type& data) noexcept {
+        packed_quaternion p;
+        p.data_ = data;
+        return p;
+    }
+
+    //-----------------------------------------------------
+    static packed_quaternion
+    from_value(std::uint64_t p) noexcept {
+        packed_quaternion q;
+        q.assign(p);
+        return q;
+    }
+
+    //-----------------------------------------------------
+    constexpr const storage_type&
+    data() const noexcept {
+        return data_;
+    }
+    //-----------------------------------------------------
+    /// @brief packed bits: [index:2][code:b][code:b][code:b]
+    constexpr std::uint64_t
+    value() const noexcept {
+        return value(data_);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief unpacks to a unit quaternion
+    template<class T>
+    explicit
+    operator quaternion<T> () const noexcept
+    {
+        using p_t = simd::pack<T,1>;
+
+        T v[3];
+        const int k = decode(value(), v);
+        for(auto& x : v) x = code_value(p_t{x}).v;
+        const auto l = length_of_dropped(p_t{v[0]}, p_t{v[1]}, p_t{v[2]}).v;
+
+        T c[4];
+        for(int i = 0, j = 0; i < 4; ++i) {
+            c[i] = (i == k) ? l : v[j++];
+        }
+        return quaternion<T>{c[0], c[1], c[2], c[3]};
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief upper bound of the rotation angle (in radians)
+    ///        between a unit quaternion and its packed representation
+    static constexpr double
+    max_angle_error() noexcept {
+        return 5.0 / double(max_code);
+    }
+
+
+    //---------------------------------------------------------------
+    friend bool
+    operator == (const packed_quaternion& a, const packed_quaternion& b) noexcept {
+        return a.data_ == b.data_;
+    }
+    //-----------------------------------------------------
+    friend bool
+    operator != (const packed_quaternion& a, const packed_quaternion& b) noexcept {
+        return !(a == b);
+    }
+
+
+    //---------------------------------------------------------------
+    // BATCH KERNEL BUILDING BLOCKS
+    //---------------------------------------------------------------
+    /// @brief code of each lane as floating-point number (not truncated)
+    template<class P>
+    static P
+    code_point(const P& x) noexcept
+    {
+        using T = typename P::value_type;
+        const auto m = T(max_code);
+        const auto scale = P::broadcast(m / sqrt2<T>);
+        const auto offset = P::broadcast(m / T(2) + T(0.5));
+        return min(max(mul_add(x, scale, offset), P::broadcast(T(0))),
+                   P::broadcast(m));
+    }
+
+    //-----------------------------------------------------
+    /// @brief value of each lane's code: (2u - max) / (max sqrt(2));
+    ///        exact zero for u = max/2 and odd symmetric around it
+    template<class P>
+    static P
+    code_value(const P& u) noexcept
+    {
+        using T = typename P::value_type;
+        const auto m = T(max_code);
+        return (u + u - P::broadcast(m)) * P::broadcast(T(1) / (m * sqrt2<T>));
+    }
+
+    //-----------------------------------------------------
+    template<class P>
+    static P
+    length_of_dropped(const P& a, const P& b, const P& c) noexcept
+    {
+        using T = typename P::value_type;
+        const auto one = P::broadcast(T(1));
+        return sqrt(max(one - mul_add(a, a, mul_add(b, b, c * c)),
+                        P::broadcast(T(0))));
+    }
+
+    //-----------------------------------------------------
+    /// @brief packed value from the components and their code points
+    template<class T>
+    static std::uint64_t
+    encode(const T& w, const T& x, const T& y, const T& z,
+           const T* codePoints) noexcept
+    {
+        using std::abs;
+        const T a[4] = {abs(w), abs(x), abs(y), abs(z)};
+        int k = 0;
+        for(int i = 1; i < 4; ++i) {
+            if(a[k] < a[i]) k = i;
+        }
+        const T c[4] = {w, x, y, z};
+        const bool flip = c[k] < T(0);
+
+        auto p = std::uint64_t(k);
+        for(int i = 0; i < 4; ++i) {
+            if(i == k) continue;
+            auto u = std::min(max_code, std::uint64_t(codePoints[i]));
+            if(flip) u = max_code - u;
+            p = (p << component_bits) | u;
+        }
+        return p;
+    }
+
+    //-----------------------------------------------------
+    /// @brief writes the 3 codes to u (as floating-point numbers)
+    ///        and returns the index of the dropped component
+    template<class T>
+    static int
+    decode(std::uint64_t p, T* u) noexcept
+    {
+        constexpr auto mask = (std::uint64_t(1) << component_bits) - 1;
+        u[0] = T((p >> (2*component_bits)) & mask);
+        u[1] = T((p >> component_bits) & mask);
+        u[2] = T(p & mask);
+        return int((p >> (3*component_bits)) & 3);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    static constexpr std::uint64_t
+    value(std::uint32_t d) noexcept { return d; }
+
+    static constexpr std::uint64_t
+    value(std::uint64_t d) noexcept { return d; }
+
+    static constexpr std::uint64_t
+    value(const std::array<std::uint16_t,3>& d) noexcept {
+        return (std::uint64_t(d[0]) << 32) | (std::uint64_t(d[1]) << 16) | d[2];
+    }
+
+    //-----------------------------------------------------
+    constexpr void
+    assign(std::uint64_t p) noexcept { assign(p, data_); }
+
+    static constexpr void
+    assign(std::uint64_t p, std::uint32_t& d) noexcept { d = std::uint32_t(p); }
+
+    static constexpr void
+    assign(std::uint64_t p, std::uint64_t& d) noexcept { d = p; }
+
+    static constexpr void
+    assign(std::uint64_t p, std::array<std::uint16_t,3>& d) noexcept {
+        d[0] = std::uint16_t(p >> 32);
+        d[1] = std::uint16_t(p >> 16);
+        d[2] = std::uint16_t(p);
+    }
+
+
+    //---------------------------------------------------------------
+    storage_type data_;
+};
+
+template<int Bits>
+constexpr int packed_quaternion<Bits>::component_bits;
+
+template<int Bits>
+constexpr std::uint64_t packed_quaternion<Bits>::max_code;
+
+
+//-------------------------------------------------------------------
+using packed_quat32 = packed_quaternion<32>;
+using packed_quat48 = packed_quaternion<48>;
+using packed_quat64 = packed_quaternion<64>;
+
+
+
+
+/*****************************************************************************
+ *
+ * HALF PRECISION QUATERNIONS
+ *
+ * @details quaternion<half> stores 4 binary16 numbers (8 bytes);
+ *          arithmetic on them is carried out in float
+ *
+ *          per-component rounding error is at most 2^-12 for components
+ *          in [-1,1], so the rotation angle between a unit quaternion q
+ *          and its half precision version is at most 2|q-q'| <= 2^-10
+ *
+ *****************************************************************************/
+using quath = quaternion<half>;
+
+
+//-------------------------------------------------------------------
+/// @brief upper bound of the rotation angle (in radians) between
+///        a unit quaternion and its half precision version
+inline constexpr double
+max_half_quaternion_angle_error() noexcept
+{
+    return 1.0 / 1024.0;
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * BATCH ENCODING / DECODING
+ *
+ * @details block-wise: the floating-point work runs as SIMD kernels on
+ *          structure-of-arrays blocks; bit packing and (de)interleaving
+ *          are done per element
+ *
+ *****************************************************************************/
+namespace detail {
+
+constexpr std::size_t compression_block_size = 64;
+
+
+//-------------------------------------------------------------------
+template<int Bits, class T>
+inline void
+compress_range(const quaternion_lanes<const T>& q,
+               packed_quaternion<Bits>* out,
+               std::size_t first, std::size_t last) noexcept
+{
+    using pq_t = packed_quaternion<Bits>;
+    constexpr auto bs = compression_block_size;
+
+    alignas(simd::max_alignment) T f[4][bs];
+
+    for(auto b = first; b < last; b += bs) {
+        const auto n = std::min(bs, last - b);
+
+        simd::for_each_pack<T>(n, [&](auto tag, std::size_t j) {
+            using p_t = decltype(tag);
+            pq_t::code_point(p_t::load(q.w+b+j)).store(f[0]+j);
+            pq_t::code_point(p_t::load(q.x+b+j)).store(f[1]+j);
+            pq_t::code_point(p_t::load(q.y+b+j)).store(f[2]+j);
+            pq_t::code_point(p_t::load(q.z+b+j)).store(f[3]+j);
+        });
+
+        for(std::size_t j = 0; j < n; ++j) {
+            const auto i = b + j;
+            const T c[4] = {f[0][j], f[1][j], f[2][j], f[3][j]};
+            out[i] = pq_t::from_value(
+                pq_t::encode(q.w[i], q.x[i], q.y[i], q.z[i], c));
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<int Bits, class T>
+inline void
+decompress_range(const packed_quaternion<Bits>* in,
+                 const quaternion_lanes<T>& q,
+                 std::size_t first, std::size_t last) noexcept
+{
+    using pq_t = packed_quaternion<Bits>;
+    constexpr auto bs = compression_block_size;
+
+    alignas(simd::max_alignment) T v[4][bs];
+    int drop[bs];
+
+    for(auto b = first; b < last; b += bs) {
+        const auto n = std::min(bs, last - b);
+
+        for(std::size_t j = 0; j < n; ++j) {
+            T u[3];
+            drop[j] = pq_t::decode(in[b+j].value(), u);
+            v[0][j] = u[0];
+            v[1][j] = u[1];
+            v[2][j] = u[2];
+        }
+
+        simd::for_each_pack<T>(n, [&](auto tag, std::size_t j) {
+            using p_t = decltype(tag);
+            const auto x = pq_t::code_value(p_t::load(v[0]+j));
+            const auto y = pq_t::code_value(p_t::load(v[1]+j));
+            const auto z = pq_t::code_value(p_t::load(v[2]+j));
+            x.store(v[0]+j);
+            y.store(v[1]+j);
+            z.store(v[2]+j);
+            pq_t::length_of_dropped(x, y, z).store(v[3]+j);
+        });
+
+        //v[3] goes to the dropped component, the others keep their order
+        for(std::size_t j = 0; j < n; ++j) {
+            const auto i = b + j;
+            const auto k = drop[j];
+            q.w[i] = (k == 0) ? v[3][j] : v[0][j];
+            q.x[i] = (k == 1) ? v[3][j] : v[k < 1 ? 0 : 1][j];
+            q.y[i] = (k == 2) ? v[3][j] : v[k < 2 ? 1 : 2][j];
+            q.z[i] = (k == 3) ? v[3][j] : v[2][j];
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline void
+compress_half_range(const quaternion_lanes<const T>& q, quaternion<half>* out,
+                    std::size_t first, std::size_t last) noexcept
+{
+    constexpr auto bs = compression_block_size;
+
+    alignas(simd::max_alignment) float f[bs];
+    half h[4][bs];
+    const T* lanes[4] = {q.w, q.x, q.y, q.z};
+
+    for(auto b = first; b < last; b += bs) {
+        const auto n = std::min(bs, last - b);
+
+        for(int c = 0; c < 4; ++c) {
+            //no double rounding for types wider than float
+            std::transform(lanes[c] + b, lanes[c] + b + n, f,
+                [](const T& x) { return detail::narrow_to_float(x); });
+            to_half(n, f, h[c]);
+        }
+        for(std::size_t j = 0; j < n; ++j) {
+            out[b+j] = quaternion<half>{h[0][j], h[1][j], h[2][j], h[3][j]};
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline void
+decompress_half_range(const quaternion<half>* in, const quaternion_lanes<T>& q,
+                      std::size_t first, std::size_t last) noexcept
+{
+    constexpr auto bs = compression_block_size;
+
+    alignas(simd::max_alignment) float f[bs];
+    half h[4][bs];
+    T* lanes[4] = {q.w, q.x, q.y, q.z};
+
+    for(auto b = first; b < last; b += bs) {
+        const auto n = std::min(bs, last - b);
+
+        for(std::size_t j = 0; j < n; ++j) {
+            h[0][j] = in[b+j].real();
+            h[1][j] = in[b+j].imag_i();
+            h[2][j] = in[b+j].imag_j();
+            h[3][j] = in[b+j].imag_k();
+        }
+        for(int c = 0; c < 4; ++c) {
+            to_float(n, h[c], f);
+            std::copy(f, f + n, lanes[c] + b);
+        }
+    }
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief packs all q[i] into out[0,q.size())
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+//-------------------------------------------------------------------
+template<class T, int Bits>
+inline void
+compress(const quaternion_array<T>& q, packed_quaternion<Bits>* out,
+         std::size_t numThreads = 1)
+{
+    const auto lq = q.lanes();
+
+    parallel_for_chunks(q.size(), numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::compress_range(lq, out, b, e);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief converts all q[i] to half precision
+template<class T>
+inline void
+compress(const quaternion_array<T>& q, quaternion<half>* out,
+         std::size_t numThreads = 1)
+{
+    const auto lq = q.lanes();
+
+    parallel_for_chunks(q.size(), numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::compress_half_range(lq, out, b, e);
+        });
+}
+
+
+//-------------------------------------------------------------------
+/// @brief unpacks in[0,n) into 'out' (resized to n)
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+//-------------------------------------------------------------------
+template<int Bits, class T>
+inline void
+decompress(std::size_t n, const packed_quaternion<Bits>* in,
+           quaternion_array<T>& out, std::size_t numThreads = 1)
+{
+    out.resize(n);
+    const auto lo = out.lanes();
+
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::decompress_range(in, lo, b, e);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief converts half precision quaternions in[0,n)
+///        into 'out' (resized to n)
+template<class T>
+inline void
+decompress(std::size_t n, const quaternion<half>* in,
+           quaternion_array<T>& out, std::size_t numThreads = 1)
+{
+    out.resize(n);
+    const auto lo = out.lanes();
+
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::decompress_half_range(in, lo, b, e);
+        });
+}
+
+
+}  // namespace num
+}  // namespace am
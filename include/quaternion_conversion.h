@@ -0,0 +1,439 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <array>
+#include <cstddef>
+
+#include "angle.h"
+#include "quaternion_array.h"
+#include "simd_math.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * TYPES
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief 3x3 matrix; m[row][col]; acts on column vectors (v' = m * v)
+template<class T>
+using rotation_matrix = std::array<std::array<T,3>,3>;
+
+
+//-------------------------------------------------------------------
+/// @brief intrinsic Z-Y'-X'' (yaw, pitch, roll) Euler angles;
+///        the rotation is Rz(yaw) * Ry(pitch) * Rx(roll)
+template<class T>
+struct euler_angles
+{
+    radians<T> yaw;
+    radians<T> pitch;
+    radians<T> roll;
+};
+
+//---------------------------------------------------------
+template<class U1, class U2, class U3,
+         class T = common_numeric_t<typename U1::type,
+                                    typename U2::type,
+                                    typename U3::type>>
+inline constexpr euler_angles<T>
+make_euler_angles(const angle<U1>& yaw, const angle<U2>& pitch,
+                  const angle<U3>& roll)
+{
+    return euler_angles<T>{
+        radians<T>{yaw}, radians<T>{pitch}, radians<T>{roll} };
+}
+
+
+
+/*************************************************************************//***
+ *
+ * @brief pointers to the 9 element lanes of a structure-of-arrays
+ *        sequence of 3x3 matrices; T may be const-qualified
+ *
+ *****************************************************************************/
+template<class T>
+struct matrix3_lanes
+{
+    T* m00; T* m01; T* m02;
+    T* m10; T* m11; T* m12;
+    T* m20; T* m21; T* m22;
+};
+
+
+
+/*************************************************************************//***
+ *
+ * @brief pointers to the 3 angle lanes of a structure-of-arrays
+ *        sequence of Euler angles (in radians); T may be const-qualified
+ *
+ *****************************************************************************/
+template<class T>
+struct euler_lanes
+{
+    T* yaw;
+    T* pitch;
+    T* roll;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * KERNELS
+ *
+ * @details written once for packs; the scalar matrix conversions use
+ *          the 1-lane pack, so their scalar and batch results are
+ *          identical; the scalar Euler angle conversions use the
+ *          standard library, the batch versions polynomial sin, cos and
+ *          atan2 approximations (results differ by a few ulps)
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<class P, class T>
+struct matrix3_pack
+{
+    P m00, m01, m02;
+    P m10, m11, m12;
+    P m20, m21, m22;
+
+    static matrix3_pack
+    load(const matrix3_lanes<T>& m, std::size_t i) noexcept {
+        return {P::load(m.m00+i), P::load(m.m01+i), P::load(m.m02+i),
+                P::load(m.m10+i), P::load(m.m11+i), P::load(m.m12+i),
+                P::load(m.m20+i), P::load(m.m21+i), P::load(m.m22+i)};
+    }
+
+    void
+    store(const matrix3_lanes<std::remove_const_t<T>>& m, std::size_t i) const noexcept {
+        m00.store(m.m00+i); m01.store(m.m01+i); m02.store(m.m02+i);
+        m10.store(m.m10+i); m11.store(m.m11+i); m12.store(m.m12+i);
+        m20.store(m.m20+i); m21.store(m.m21+i); m22.store(m.m22+i);
+    }
+};
+
+
+//-------------------------------------------------------------------
+/// @brief rotation matrix of a unit quaternion
+template<class P, class T>
+inline matrix3_pack<P,T>
+matrix_from_quat_packs(const quat_pack<P,T>& q) noexcept
+{
+    using V = typename P::value_type;
+
+    const auto one = P::broadcast(V(1));
+    const auto two = P::broadcast(V(2));
+
+    const auto x2 = two * q.x, y2 = two * q.y, z2 = two * q.z;
+    const auto wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+    const auto xx = q.x * x2, xy = q.x * y2, xz = q.x * z2;
+    const auto yy = q.y * y2, yz = q.y * z2, zz = q.z * z2;
+
+    return { one - (yy + zz), xy - wz,           xz + wy,
+             xy + wz,         one - (xx + zz),   yz - wx,
+             xz - wy,         yz + wx,           one - (xx + yy) };
+}
+
+
+//-------------------------------------------------------------------
+/// @brief branch-free Shepperd-style matrix -> unit quaternion (w >= 0)
+/// @details each of Shepperd's four candidate rows
+///            c_w = 4w * q,  c_x = 4x * q,  c_y = 4y * q,  c_z = 4z * q
+///          is a multiple of q; instead of picking the row with the
+///          largest diagonal entry with branches, the rows are sign-aligned
+///          and summed, which yields 4(|w|+|x|+|y|+|z|) * q.
+///          The sum is never shorter than the best Shepperd row, so the
+///          result is at least as well-conditioned and also averages out
+///          noise in slightly non-orthonormal matrices
+template<class P, class T>
+inline quat_pack<P,T>
+quat_from_matrix_packs(const matrix3_pack<P,T>& m) noexcept
+{
+    using V = typename P::value_type;
+
+    const auto one = P::broadcast(V(1));
+
+    const quat_pack<P,T> c[4] = {
+        { one + m.m00 + m.m11 + m.m22, m.m21 - m.m12, m.m02 - m.m20, m.m10 - m.m01 },
+        { m.m21 - m.m12, one + m.m00 - m.m11 - m.m22, m.m01 + m.m10, m.m02 + m.m20 },
+        { m.m02 - m.m20, m.m01 + m.m10, one - m.m00 + m.m11 - m.m22, m.m12 + m.m21 },
+        { m.m10 - m.m01, m.m02 + m.m20, m.m12 + m.m21, one - m.m00 - m.m11 + m.m22 } };
+
+    auto r = c[0];
+    for(int k = 1; k < 4; ++k) {
+        const auto s = copysign(one,
+            r.w*c[k].w + r.x*c[k].x + r.y*c[k].y + r.z*c[k].z);
+        r.w = mul_add(s, c[k].w, r.w);
+        r.x = mul_add(s, c[k].x, r.x);
+        r.y = mul_add(s, c[k].y, r.y);
+        r.z = mul_add(s, c[k].z, r.z);
+    }
+
+    const auto f = copysign(
+        one / sqrt(r.w*r.w + r.x*r.x + r.y*r.y + r.z*r.z), r.w);
+
+    return {r.w*f, r.x*f, r.y*f, r.z*f};
+}
+
+
+//-------------------------------------------------------------------
+/// @brief Z-Y-X Euler angles (radians) -> unit quaternion
+/// @details range-reduced sin/cos of the half angles
+/// @pre     |yaw|, |pitch|, |roll| <= 2e4 (float) or 2e9 (double)
+///          (see simd::sincos)
+template<class P, class T>
+inline quat_pack<P,T>
+quat_from_euler_packs(const P& yaw, const P& pitch, const P& roll) noexcept
+{
+    using V = typename P::value_type;
+
+    const auto h = P::broadcast(V(0.5));
+    P cy, sy, cp, sp, cr, sr;
+    simd::sincos(yaw * h,   &sy, &cy);
+    simd::sincos(pitch * h, &sp, &cp);
+    simd::sincos(roll * h,  &sr, &cr);
+
+    const auto cc = cp * cy, ss = sp * sy;
+    const auto cs = cp * sy, sc = sp * cy;
+
+    return { mul_add(cr, cc, sr * ss), mul_add(sr, cc, -(cr * ss)),
+             mul_add(cr, sc, sr * cs), mul_add(cr, cs, -(sr * sc)) };
+}
+
+
+//-------------------------------------------------------------------
+/// @brief unit quaternion -> Z-Y-X Euler angles (radians)
+/// @details yaw, roll in [-pi,pi], pitch in [-pi/2,pi/2];
+///          pitch is computed as atan2(sin, cos) instead of asin,
+///          which stays accurate close to +/- pi/2
+template<class P, class T>
+inline void
+euler_from_quat_packs(const quat_pack<P,T>& q,
+                      P& yaw, P& pitch, P& roll) noexcept
+{
+    const auto m = matrix_from_quat_packs(q);
+
+    yaw   = simd::atan2(m.m10, m.m00);
+    pitch = simd::atan2(-m.m20, sqrt(m.m00*m.m00 + m.m10*m.m10));
+    roll  = simd::atan2(m.m21, m.m22);
+}
+
+} // namespace detail
+
+
+
+
+/*****************************************************************************
+ *
+ * ROTATION MATRICES
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief rotation matrix R with R * v = rotate(q,v); q must be normalized
+//-------------------------------------------------------------------
+template<class T>
+inline rotation_matrix<T>
+to_rotation_matrix(const quaternion<T>& q) noexcept
+{
+    using p_t = simd::pack<T,1>;
+
+    const auto m = detail::matrix_from_quat_packs(
+        detail::quat_pack<p_t,const T>{
+            {q.real()}, {q.imag_i()}, {q.imag_j()}, {q.imag_k()} });
+
+    return rotation_matrix<T>{{ {{m.m00.v, m.m01.v, m.m02.v}},
+                                {{m.m10.v, m.m11.v, m.m12.v}},
+                                {{m.m20.v, m.m21.v, m.m22.v}} }};
+}
+
+//---------------------------------------------------------
+/// @brief unit quaternion (with real part >= 0) of a rotation matrix
+template<class T>
+inline quaternion<T>
+from_rotation_matrix(const rotation_matrix<T>& m) noexcept
+{
+    using p_t = simd::pack<T,1>;
+
+    const auto q = detail::quat_from_matrix_packs(
+        detail::matrix3_pack<p_t,const T>{
+            {m[0][0]}, {m[0][1]}, {m[0][2]},
+            {m[1][0]}, {m[1][1]}, {m[1][2]},
+            {m[2][0]}, {m[2][1]}, {m[2][2]} });
+
+    return quaternion<T>{q.w.v, q.x.v, q.y.v, q.z.v};
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = to_rotation_matrix(q[i])
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+//-------------------------------------------------------------------
+template<class T>
+inline void
+to_rotation_matrix(const quaternion_array<T>& q, const matrix3_lanes<T>& out,
+                   std::size_t numThreads = 1)
+{
+    const auto lq = q.lanes();
+    parallel_for_chunks(q.size(), numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                detail::matrix_from_quat_packs(
+                    detail::quat_pack<p_t,const T>::load(lq,i)).store(out,i);
+            });
+        });
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = from_rotation_matrix(m[i]) for i in [0,n)
+template<class T>
+inline void
+from_rotation_matrix(std::size_t n, const matrix3_lanes<const T>& m,
+                     quaternion_array<T>& out, std::size_t numThreads = 1)
+{
+    out.resize(n);
+    const auto lo = out.lanes();
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                detail::quat_from_matrix_packs(
+                    detail::matrix3_pack<p_t,const T>::load(m,i)).store(lo,i);
+            });
+        });
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * EULER ANGLES
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief Z-Y-X Euler angles of a unit quaternion
+/// @details yaw, roll in [-pi,pi], pitch in [-pi/2,pi/2];
+///          at pitch = +/- pi/2 (gimbal lock) only yaw -/+ roll is
+///          determined and the split between the two is arbitrary
+//-------------------------------------------------------------------
+template<class T>
+inline euler_angles<T>
+to_euler_angles(const quaternion<T>& q)
+{
+    using std::atan2;
+    using std::sqrt;
+
+    const auto w = q.real(),   x = q.imag_i();
+    const auto y = q.imag_j(), z = q.imag_k();
+
+    const auto m00 = T(1) - T(2) * (y*y + z*z);
+    const auto m10 = T(2) * (x*y + w*z);
+
+    return euler_angles<T>{
+        radians<T>{atan2(m10, m00)},
+        radians<T>{atan2(T(2) * (w*y - x*z), sqrt(m00*m00 + m10*m10))},
+        radians<T>{atan2(T(2) * (w*x + y*z), T(1) - T(2) * (x*x + y*y))} };
+}
+
+//---------------------------------------------------------
+/// @brief unit quaternion Rz(yaw) * Ry(pitch) * Rx(roll)
+template<class T>
+inline quaternion<T>
+from_euler_angles(const euler_angles<T>& e)
+{
+    using std::sin;
+    using std::cos;
+
+    const auto hy = radians_cast<T>(e.yaw)   / T(2);
+    const auto hp = radians_cast<T>(e.pitch) / T(2);
+    const auto hr = radians_cast<T>(e.roll)  / T(2);
+
+    const auto cy = cos(hy), sy = sin(hy);
+    const auto cp = cos(hp), sp = sin(hp);
+    const auto cr = cos(hr), sr = sin(hr);
+
+    return quaternion<T>{
+        cr*cp*cy + sr*sp*sy,
+        sr*cp*cy - cr*sp*sy,
+        cr*sp*cy + sr*cp*sy,
+        cr*cp*sy - sr*sp*cy };
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief out[i] = to_euler_angles(q[i]) (in radians);
+///        may differ from the scalar to_euler_angles by a few ulps
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+//-------------------------------------------------------------------
+template<class T>
+inline void
+to_euler_angles(const quaternion_array<T>& q, const euler_lanes<T>& out,
+                std::size_t numThreads = 1)
+{
+    const auto lq = q.lanes();
+    parallel_for_chunks(q.size(), numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                p_t yaw, pitch, roll;
+                detail::euler_from_quat_packs(
+                    detail::quat_pack<p_t,const T>::load(lq,i), yaw, pitch, roll);
+                yaw.store(out.yaw+i);
+                pitch.store(out.pitch+i);
+                roll.store(out.roll+i);
+            });
+        });
+}
+
+//---------------------------------------------------------
+/// @brief out[i] = from_euler_angles(a[i]) for i in [0,n)
+///        (angles in radians)
+/// @pre   |angle| <= 2e4 (float) or 2e9 (double); the result may differ
+///        from the scalar from_euler_angles by a few ulps
+template<class T>
+inline void
+from_euler_angles(std::size_t n, const euler_lanes<const T>& a,
+                  quaternion_array<T>& out, std::size_t numThreads = 1)
+{
+    out.resize(n);
+    const auto lo = out.lanes();
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                detail::quat_from_euler_packs<p_t,const T>(
+                    p_t::load(a.yaw+i), p_t::load(a.pitch+i),
+                    p_t::load(a.roll+i)).store(lo,i);
+            });
+        });
+}
+
+
+}  // namespace num
+}  // namespace am
@@ -0,0 +1,374 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <type_traits>
+
+#include "quaternion.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * QUATERNION EXPRESSIONS (opt-in)
+ *
+ * @details lazy(q) wraps a quaternion (incl. dual quaternions and
+ *          biquaternions) into an expression leaf; products, sums,
+ *          conj() and inverse() of expressions build a tree that is
+ *          evaluated in one go when converted to a quaternion:
+ *
+ *            quatd r = lazy(a) * lazy(b) * conj(lazy(c)) * inverse(lazy(d));
+ *
+ *          products are mapped to fused kernels:
+ *            x * conj(y)       ->  times_conj(x,y)
+ *            conj(x) * y       ->  conj_times(x,y)
+ *            conj(x) * conj(y) ->  conj(y * x)
+ *            x * inverse(y)    ->  times_conj(x, normalized(y))
+ *            inverse(x) * y    ->  conj_times(normalized(x), y)
+ *          so no conjugated or inverted intermediate is ever formed;
+ *          inverse has the same semantics as the eager inverse(q) /
+ *          q.invert(), i.e. conj(normalized(q)), which is the true
+ *          inverse only for unit quaternions
+ *
+ * @note    leaves hold references: expressions must be evaluated within
+ *          the full-expression that created them (do not store them
+ *          in 'auto' variables)
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+template<class E>
+struct quaternion_expression
+{
+    constexpr const E&
+    self() const noexcept { return static_cast<const E&>(*this); }
+};
+
+//---------------------------------------------------------
+template<class T>
+struct is_quaternion_expression :
+    std::is_base_of<quaternion_expression<T>, T>
+{};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+class quat_leaf :
+    public quaternion_expression<quat_leaf<T>>
+{
+public:
+    using value_type = quaternion<T>;
+
+    explicit constexpr
+    quat_leaf(const value_type& q) noexcept : q_(q) {}
+
+    constexpr const value_type&
+    eval() const noexcept { return q_; }
+
+    constexpr operator value_type() const { return q_; }
+
+private:
+    const value_type& q_;
+};
+
+
+//-------------------------------------------------------------------
+template<class E>
+struct quat_conj :
+    public quaternion_expression<quat_conj<E>>
+{
+    using value_type = typename E::value_type;
+
+    E arg;
+
+    explicit constexpr
+    quat_conj(const E& e) : arg(e) {}
+
+    constexpr value_type
+    eval() const { return conj(value_type(arg.eval())); }
+
+    constexpr operator value_type() const { return eval(); }
+};
+
+
+//-------------------------------------------------------------------
+template<class E>
+struct quat_inverse :
+    public quaternion_expression<quat_inverse<E>>
+{
+    using value_type = typename E::value_type;
+    using numeric_type = typename value_type::numeric_type;
+
+    E arg;
+
+    explicit constexpr
+    quat_inverse(const E& e) : arg(e) {}
+
+    constexpr value_type
+    eval() const { return inverse(value_type(arg.eval())); }
+
+    constexpr operator value_type() const { return eval(); }
+};
+
+
+//-------------------------------------------------------------------
+/// @brief fused products; selected by overload resolution on the
+///        operand node types
+template<class L, class R>
+constexpr auto
+fused_product(const L& l, const R& r)
+{
+    return l.eval() * r.eval();
+}
+
+//---------------------------------------------------------
+template<class L, class E>
+constexpr auto
+fused_product(const L& l, const quat_conj<E>& r)
+{
+    return times_conj(l.eval(), r.arg.eval());
+}
+
+//---------------------------------------------------------
+template<class E, class R>
+constexpr auto
+fused_product(const quat_conj<E>& l, const R& r)
+{
+    return conj_times(l.arg.eval(), r.eval());
+}
+
+//---------------------------------------------------------
+template<class E1, class E2>
+constexpr auto
+fused_product(const quat_conj<E1>& l, const quat_conj<E2>& r)
+{
+    return conj(r.arg.eval() * l.arg.eval());
+}
+
+//---------------------------------------------------------
+template<class L, class E>
+constexpr auto
+fused_product(const L& l, const quat_inverse<E>& r)
+{
+    return times_conj(l.eval(), normalized(r.arg.eval()));
+}
+
+//---------------------------------------------------------
+template<class E, class R>
+constexpr auto
+fused_product(const quat_inverse<E>& l, const R& r)
+{
+    return conj_times(normalized(l.arg.eval()), r.eval());
+}
+
+//---------------------------------------------------------
+template<class E1, class E2>
+constexpr auto
+fused_product(const quat_conj<E1>& l, const quat_inverse<E2>& r)
+{
+    return fused_product(l, quat_leaf<typename E2::value_type::numeric_type>{r.eval()});
+}
+
+//---------------------------------------------------------
+template<class E1, class E2>
+constexpr auto
+fused_product(const quat_inverse<E1>& l, const quat_conj<E2>& r)
+{
+    return fused_product(quat_leaf<typename E1::value_type::numeric_type>{l.eval()}, r);
+}
+
+//---------------------------------------------------------
+template<class E1, class E2>
+constexpr auto
+fused_product(const quat_inverse<E1>& l, const quat_inverse<E2>& r)
+{
+    return fused_product(l, quat_leaf<typename E2::value_type::numeric_type>{r.eval()});
+}
+
+
+
+//-------------------------------------------------------------------
+template<class L, class R>
+struct quat_product :
+    public quaternion_expression<quat_product<L,R>>
+{
+    using value_type = std::decay_t<decltype(
+        fused_product(std::declval<const L&>(), std::declval<const R&>()))>;
+
+    L lhs;
+    R rhs;
+
+    constexpr
+    quat_product(const L& l, const R& r) : lhs(l), rhs(r) {}
+
+    constexpr value_type
+    eval() const { return fused_product(lhs, rhs); }
+
+    constexpr operator value_type() const { return eval(); }
+};
+
+
+//-------------------------------------------------------------------
+template<class L, class R, int sign>
+struct quat_sum :
+    public quaternion_expression<quat_sum<L,R,sign>>
+{
+    using value_type = std::decay_t<decltype(
+        std::declval<const L&>().eval() + std::declval<const R&>().eval())>;
+
+    L lhs;
+    R rhs;
+
+    constexpr
+    quat_sum(const L& l, const R& r) : lhs(l), rhs(r) {}
+
+    constexpr value_type
+    eval() const {
+        return (sign > 0) ? value_type(lhs.eval() + rhs.eval())
+                          : value_type(lhs.eval() - rhs.eval());
+    }
+
+    constexpr operator value_type() const { return eval(); }
+};
+
+
+//-------------------------------------------------------------------
+template<class S, class E>
+struct quat_scaled :
+    public quaternion_expression<quat_scaled<S,E>>
+{
+    using value_type = std::decay_t<decltype(
+        std::declval<const S&>() * std::declval<const E&>().eval())>;
+
+    S factor;
+    E arg;
+
+    constexpr
+    quat_scaled(const S& s, const E& e) : factor(s), arg(e) {}
+
+    constexpr value_type
+    eval() const { return factor * arg.eval(); }
+
+    constexpr operator value_type() const { return eval(); }
+};
+
+
+
+//-------------------------------------------------------------------
+// OPERATIONS ON EXPRESSIONS (found by argument-dependent lookup)
+//-------------------------------------------------------------------
+template<class E>
+constexpr quat_conj<E>
+conj(const quaternion_expression<E>& e)
+{
+    return quat_conj<E>{e.self()};
+}
+//---------------------------------------------------------
+template<class E>
+constexpr E
+conj(const quat_conj<E>& e)
+{
+    return e.arg;
+}
+
+//---------------------------------------------------------
+template<class E>
+constexpr quat_inverse<E>
+inverse(const quaternion_expression<E>& e)
+{
+    return quat_inverse<E>{e.self()};
+}
+
+//---------------------------------------------------------
+template<class E>
+constexpr auto
+eval(const quaternion_expression<E>& e)
+{
+    return typename E::value_type(e.self().eval());
+}
+
+
+//---------------------------------------------------------
+template<class L, class R>
+constexpr quat_product<L,R>
+operator * (const quaternion_expression<L>& l, const quaternion_expression<R>& r)
+{
+    return quat_product<L,R>{l.self(), r.self()};
+}
+//---------------------------------------------------------
+template<class L, class T>
+constexpr quat_product<L,quat_leaf<T>>
+operator * (const quaternion_expression<L>& l, const quaternion<T>& r)
+{
+    return quat_product<L,quat_leaf<T>>{l.self(), quat_leaf<T>{r}};
+}
+//---------------------------------------------------------
+template<class T, class R>
+constexpr quat_product<quat_leaf<T>,R>
+operator * (const quaternion<T>& l, const quaternion_expression<R>& r)
+{
+    return quat_product<quat_leaf<T>,R>{quat_leaf<T>{l}, r.self()};
+}
+
+//---------------------------------------------------------
+template<class S, class E, class = std::enable_if_t<is_number<S>::value>>
+constexpr quat_scaled<S,E>
+operator * (const S& s, const quaternion_expression<E>& e)
+{
+    return quat_scaled<S,E>{s, e.self()};
+}
+//---------------------------------------------------------
+template<class E, class S, class = std::enable_if_t<is_number<S>::value>>
+constexpr quat_scaled<S,E>
+operator * (const quaternion_expression<E>& e, const S& s)
+{
+    return quat_scaled<S,E>{s, e.self()};
+}
+
+
+//---------------------------------------------------------
+template<class L, class R>
+constexpr quat_sum<L,R,1>
+operator + (const quaternion_expression<L>& l, const quaternion_expression<R>& r)
+{
+    return quat_sum<L,R,1>{l.self(), r.self()};
+}
+//---------------------------------------------------------
+template<class L, class R>
+constexpr quat_sum<L,R,-1>
+operator - (const quaternion_expression<L>& l, const quaternion_expression<R>& r)
+{
+    return quat_sum<L,R,-1>{l.self(), r.self()};
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief wraps q into a quaternion expression leaf
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr detail::quat_leaf<T>
+lazy(const quaternion<T>& q) noexcept
+{
+    return detail::quat_leaf<T>{q};
+}
+
+
+}  // namespace num
+}  // namespace am
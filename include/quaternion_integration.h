@@ -0,0 +1,123 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include "quaternion_array.h"
+#include "simd_math.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * ANGULAR VELOCITY INTEGRATION
+ *
+ * @details advances unit orientations q[i] by angular velocities w[i]
+ *          over a time step dt using the exponential map
+ *            dq = exp([0, w*dt/2]) = [cos|w dt/2|, w dt/2 * sinc|w dt/2|]
+ *          evaluated with range-reduced sine and cosine, so any step
+ *          size is valid; sinc uses its Taylor polynomial for small
+ *          angles (no 0/0)
+ *
+ *          instead of a full renormalization (sqrt + division) the result
+ *          is scaled by the first-order correction (3 - |q|^2) / 2;
+ *          for |q|^2 = 1 + e this leaves a norm error of O(e^2),
+ *          so the rounding drift of repeated steps cannot accumulate
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<bool bodyFrame, class T>
+inline void
+integrate_range(const quaternion_lanes<T>& q,
+                const vector3_lanes<const T>& w, T dt,
+                std::size_t first, std::size_t last) noexcept
+{
+    simd::for_each_pack<T>(last - first, [&](auto tag, std::size_t j) {
+        using p_t = decltype(tag);
+        using q_t = quat_pack<p_t,const T>;
+
+        const auto i = first + j;
+        const auto h = p_t::broadcast(dt / T(2));
+
+        const auto ax = p_t::load(w.x+i) * h;
+        const auto ay = p_t::load(w.y+i) * h;
+        const auto az = p_t::load(w.z+i) * h;
+        const auto phi = sqrt(ax*ax + ay*ay + az*az);
+        p_t sphi, cphi;
+        simd::sincos(phi, &sphi, &cphi);
+
+        //sin(phi)/phi; polynomial below phi = 1/2
+        const auto t = p_t::broadcast(T(0.5));
+        const auto sp = simd::sinc(min(phi, t));
+        const auto s = mul_add(simd::detail::step(phi - t),
+                               sphi / max(phi, t) - sp, sp);
+
+        const auto dq = q_t{cphi, ax*s, ay*s, az*s};
+        const auto q0 = quat_pack<p_t,T>::load(q,i);
+        const auto qi = q_t{q0.w, q0.x, q0.y, q0.z};
+
+        const auto r = bodyFrame ? hamilton_product(qi, dq)
+                                 : hamilton_product(dq, qi);
+
+        const auto f = (p_t::broadcast(T(3)) -
+                        (r.w*r.w + r.x*r.x + r.y*r.y + r.z*r.z)) *
+                       p_t::broadcast(T(0.5));
+
+        q_t{r.w*f, r.x*f, r.y*f, r.z*f}.store(q,i);
+    });
+}
+
+} // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief q[i] = exp([0, w[i]*dt/2]) * q[i]
+///        (angular velocities w given in the world frame)
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+//-------------------------------------------------------------------
+template<class T>
+inline void
+integrate_angular_velocity(
+    quaternion_array<T>& q, const vector3_lanes<const T>& w, T dt,
+    std::size_t numThreads = 1)
+{
+    const auto lq = q.lanes();
+    parallel_for_chunks(q.size(), numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::integrate_range<false>(lq, w, dt, b, e);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief q[i] = q[i] * exp([0, w[i]*dt/2])
+///        (angular velocities w given in the body frame)
+template<class T>
+inline void
+integrate_body_angular_velocity(
+    quaternion_array<T>& q, const vector3_lanes<const T>& w, T dt,
+    std::size_t numThreads = 1)
+{
+    const auto lq = q.lanes();
+    parallel_for_chunks(q.size(), numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            detail::integrate_range<true>(lq, w, dt, b, e);
+        });
+}
+
+
+}  // namespace num
+}  // namespace am
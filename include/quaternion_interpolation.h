@@ -0,0 +1,263 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include "quaternion_array.h"
+#include "simd_math.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief  spherical linear interpolation between many pairs of
+ *         unit quaternion keys
+ *
+ * @details per-pair constants (shortest-path sign, angle, 1/sinc(angle))
+ *          are computed once when keys are added;
+ *          evaluation is then trig-free:
+ *            slerp(a,b,t) = (1-t) * sinc((1-t)phi)/sinc(phi) * a +
+ *                              t  * sinc(t*phi)/sinc(phi)    * b
+ *          sinc is evaluated with a polynomial which also covers the
+ *          small-angle case without any branches
+ *
+ *****************************************************************************/
+template<class NumberT>
+class slerp_table
+{
+    static_assert(
+        is_floating_point<NumberT>::value,
+        "slerp_table<T>: T must be a floating-point number type");
+
+    using lane_type = std::vector<NumberT,simd::aligned_allocator<NumberT>>;
+
+public:
+    //---------------------------------------------------------------
+    using numeric_type = NumberT;
+    using value_type   = quaternion<numeric_type>;
+    using size_type    = std::size_t;
+
+
+    //---------------------------------------------------------------
+    slerp_table() = default;
+
+    //-----------------------------------------------------
+    slerp_table(const quaternion_array<numeric_type>& from,
+                const quaternion_array<numeric_type>& to)
+    {
+        assign(from, to);
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return from_.size();
+    }
+
+    //-----------------------------------------------------
+    void
+    reserve(size_type n) {
+        from_.reserve(n);
+        to_.reserve(n);
+        phi_.reserve(n);
+        invSinc_.reserve(n);
+    }
+
+    //-----------------------------------------------------
+    void
+    clear() noexcept {
+        from_.clear();
+        to_.clear();
+        phi_.clear();
+        invSinc_.clear();
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief replaces all keys
+    void
+    assign(const quaternion_array<numeric_type>& from,
+           const quaternion_array<numeric_type>& to)
+    {
+        assert(from.size() == to.size());
+
+        clear();
+        reserve(from.size());
+        for(size_type i = 0; i < from.size(); ++i) {
+            push_back(from[i], to[i]);
+        }
+    }
+
+    //-----------------------------------------------------
+    /// @brief adds a key pair; both keys must be unit quaternions
+    void
+    push_back(const value_type& from, value_type to)
+    {
+        using std::atan2;
+
+        //shortest path
+        if(dot(from, to) < numeric_type(0)) to *= numeric_type(-1);
+
+        //more accurate than acos(dot) for small angles
+        const auto phi = numeric_type(2) *
+            atan2(norm(from - to), norm(from + to));
+
+        from_.push_back(from);
+        to_.push_back(to);
+        phi_.push_back(phi);
+        invSinc_.push_back(numeric_type(1) /
+            simd::sinc(simd::pack<numeric_type,1>{phi}).v);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief interpolates key pair i at t in [0,1]
+    value_type
+    operator () (size_type i, numeric_type t) const noexcept
+    {
+        using p_t = simd::pack<numeric_type,1>;
+
+        const auto r = interpolate_packs(p_t{t}, load<p_t>(i));
+        return value_type{r.w.v, r.x.v, r.y.v, r.z.v};
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief out[i] = slerp(from[i], to[i], t[i])
+    void
+    interpolate(const numeric_type* t, quaternion_array<numeric_type>& out) const
+    {
+        const auto n = size();
+        out.resize(n);
+        const auto lo = out.lanes();
+
+        simd::for_each_pack<numeric_type>(n, [&](auto tag, std::size_t i) {
+            using p_t = decltype(tag);
+            interpolate_packs(p_t::load(t+i), this->load<p_t>(i)).store(lo,i);
+        });
+    }
+
+    //-----------------------------------------------------
+    /// @brief out[i] = slerp(from[i], to[i], t)
+    void
+    interpolate(numeric_type t, quaternion_array<numeric_type>& out) const
+    {
+        const auto n = size();
+        out.resize(n);
+        const auto lo = out.lanes();
+
+        simd::for_each_pack<numeric_type>(n, [&](auto tag, std::size_t i) {
+            using p_t = decltype(tag);
+            interpolate_packs(p_t::broadcast(t), this->load<p_t>(i)).store(lo,i);
+        });
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    template<class P>
+    struct key_packs {
+        detail::quat_pack<P,const numeric_type> a;
+        detail::quat_pack<P,const numeric_type> b;
+        P phi;
+        P invSinc;
+    };
+
+    //---------------------------------------------------------
+    template<class P>
+    key_packs<P>
+    load(size_type i) const noexcept {
+        using q_t = detail::quat_pack<P,const numeric_type>;
+        return key_packs<P>{
+            q_t::load(from_.lanes(), i), q_t::load(to_.lanes(), i),
+            P::load(phi_.data()+i), P::load(invSinc_.data()+i) };
+    }
+
+    //---------------------------------------------------------
+    template<class P>
+    static auto
+    interpolate_packs(const P& t, const key_packs<P>& k) noexcept
+    {
+        const auto u  = P::broadcast(numeric_type(1)) - t;
+        const auto wa = u * simd::sinc(u * k.phi) * k.invSinc;
+        const auto wb = t * simd::sinc(t * k.phi) * k.invSinc;
+
+        return detail::quat_pack<P,const numeric_type>{
+            mul_add(wa, k.a.w, wb * k.b.w),
+            mul_add(wa, k.a.x, wb * k.b.x),
+            mul_add(wa, k.a.y, wb * k.b.y),
+            mul_add(wa, k.a.z, wb * k.b.z) };
+    }
+
+
+    //---------------------------------------------------------------
+    quaternion_array<numeric_type> from_;
+    quaternion_array<numeric_type> to_;
+    lane_type phi_;
+    lane_type invSinc_;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief out[i] = nlerp(from[i], to[i], t[i])
+ *        (shortest-path normalized linear interpolation)
+ *
+ *****************************************************************************/
+template<class T>
+inline void
+nlerp(const quaternion_array<T>& from, const quaternion_array<T>& to,
+      const T* t, quaternion_array<T>& out)
+{
+    assert(from.size() == to.size());
+
+    const auto n = from.size();
+    out.resize(n);
+    const auto la = from.lanes();
+    const auto lb = to.lanes();
+    const auto lo = out.lanes();
+
+    simd::for_each_pack<T>(n, [&](auto tag, std::size_t i) {
+        using p_t = decltype(tag);
+        using q_t = detail::quat_pack<p_t,const T>;
+
+        const auto a = q_t::load(la,i);
+        const auto b = q_t::load(lb,i);
+        const auto tb = p_t::load(t+i);
+        const auto wa = p_t::broadcast(T(1)) - tb;
+        const auto wb = copysign(tb, a.w*b.w + a.x*b.x + a.y*b.y + a.z*b.z);
+
+        const auto r = q_t{
+            mul_add(wa, a.w, wb * b.w),
+            mul_add(wa, a.x, wb * b.x),
+            mul_add(wa, a.y, wb * b.y),
+            mul_add(wa, a.z, wb * b.z) };
+
+        const auto s = p_t::broadcast(T(1)) /
+                       sqrt(r.w*r.w + r.x*r.x + r.y*r.y + r.z*r.z);
+
+        q_t{r.w*s, r.x*s, r.y*s, r.z*s}.store(lo,i);
+    });
+}
+
+
+}  // namespace num
+}  // namespace am
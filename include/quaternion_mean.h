@@ -0,0 +1,347 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+#include "quaternion_array.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * SYMMETRIC 4x4 EIGENVECTORS
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief eigenvector of the largest eigenvalue of a symmetric 4x4 matrix
+/// @details cyclic Jacobi rotations; converges quadratically and is
+///          accurate even for (nearly) repeated eigenvalues
+template<class T>
+inline std::array<T,4>
+dominant_eigenvector_4x4(std::array<std::array<T,4>,4> a)
+{
+    using std::abs;
+    using std::sqrt;
+    using std::copysign;
+
+    std::array<std::array<T,4>,4> v {{
+        {{1,0,0,0}}, {{0,1,0,0}}, {{0,0,1,0}}, {{0,0,0,1}} }};
+
+    for(int sweep = 0; sweep < 32; ++sweep) {
+        T off = 0, diag = 0;
+        for(int p = 0; p < 4; ++p) {
+            diag += a[p][p] * a[p][p];
+            for(int q = p+1; q < 4; ++q) off += a[p][q] * a[p][q];
+        }
+        if(!(off > std::numeric_limits<T>::epsilon() *
+                   std::numeric_limits<T>::epsilon() * diag)) break;
+
+        for(int p = 0; p < 3; ++p) {
+            for(int q = p+1; q < 4; ++q) {
+                const auto apq = a[p][q];
+                if(apq == T(0)) continue;
+
+                //rotation angle that annihilates a[p][q]
+                const auto theta = (a[q][q] - a[p][p]) / (T(2) * apq);
+                const auto t = copysign(T(1), theta) /
+                               (abs(theta) + sqrt(theta*theta + T(1)));
+                const auto c = T(1) / sqrt(t*t + T(1));
+                const auto s = t * c;
+
+                for(int k = 0; k < 4; ++k) {
+                    const auto akp = a[k][p], akq = a[k][q];
+                    a[k][p] = c*akp - s*akq;
+                    a[k][q] = s*akp + c*akq;
+                }
+                for(int k = 0; k < 4; ++k) {
+                    const auto apk = a[p][k], aqk = a[q][k];
+                    a[p][k] = c*apk - s*aqk;
+                    a[q][k] = s*apk + c*aqk;
+                }
+                for(int k = 0; k < 4; ++k) {
+                    const auto vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c*vkp - s*vkq;
+                    v[k][q] = s*vkp + c*vkq;
+                }
+            }
+        }
+    }
+
+    int imax = 0;
+    for(int k = 1; k < 4; ++k) {
+        if(a[k][k] > a[imax][imax]) imax = k;
+    }
+    return std::array<T,4>{{v[0][imax], v[1][imax], v[2][imax], v[3][imax]}};
+}
+
+
+//-------------------------------------------------------------------
+/// @brief s += wt * (q q^T) (upper triangle, row-major: ww wx wy wz xx ...)
+template<class P, class Q>
+inline void
+add_outer_product(const Q& q, const P& wt, P* s) noexcept
+{
+    const auto w = wt * q.w, x = wt * q.x, y = wt * q.y, z = wt * q.z;
+    s[0] = mul_add(w, q.w, s[0]);
+    s[1] = mul_add(w, q.x, s[1]);
+    s[2] = mul_add(w, q.y, s[2]);
+    s[3] = mul_add(w, q.z, s[3]);
+    s[4] = mul_add(x, q.x, s[4]);
+    s[5] = mul_add(x, q.y, s[5]);
+    s[6] = mul_add(x, q.z, s[6]);
+    s[7] = mul_add(y, q.y, s[7]);
+    s[8] = mul_add(y, q.z, s[8]);
+    s[9] = mul_add(z, q.z, s[9]);
+}
+
+} // namespace detail
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  streaming weighted average of unit quaternions
+ *
+ * @details eigenvector method (F.L. Markley et al.):
+ *          the mean is the eigenvector of the largest eigenvalue of
+ *            M = sum_i w_i q_i q_i^T
+ *          which is insensitive to the sign of each q_i (q and -q
+ *          represent the same rotation) and minimizes the weighted sum
+ *          of squared chordal distances of the rotation matrices
+ *
+ *          only the 10 unique entries of M and the total weight are
+ *          stored; partial states (e.g. from different threads)
+ *          can be merged with +=
+ *
+ *****************************************************************************/
+template<class NumberT>
+class quaternion_mean_accumulator
+{
+    static_assert(
+        is_floating_point<NumberT>::value,
+        "quaternion_mean_accumulator<T>: T must be a floating-point number type");
+
+public:
+    //---------------------------------------------------------------
+    using numeric_type = NumberT;
+    using value_type   = quaternion<numeric_type>;
+
+
+    //---------------------------------------------------------------
+    quaternion_mean_accumulator() noexcept :
+        m_{}, weight_{0}
+    {}
+
+
+    //---------------------------------------------------------------
+    /// @brief adds sample q (with weight wt >= 0)
+    void
+    add(const value_type& q, numeric_type wt = numeric_type(1)) noexcept
+    {
+        using p_t = simd::pack<numeric_type,1>;
+
+        p_t s[10];
+        for(int k = 0; k < 10; ++k) s[k] = p_t{m_[k]};
+
+        detail::add_outer_product(
+            detail::quat_pack<p_t,const numeric_type>{
+                {q.real()}, {q.imag_i()}, {q.imag_j()}, {q.imag_k()} },
+            p_t{wt}, s);
+
+        for(int k = 0; k < 10; ++k) m_[k] = s[k].v;
+        weight_ += wt;
+    }
+
+    //-----------------------------------------------------
+    /// @brief adds all samples q[i] with weights wt[i]
+    /// @param wt          per-sample weights; nullptr = all weights 1
+    /// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+    void
+    add(const quaternion_array<numeric_type>& q,
+        const numeric_type* wt = nullptr, std::size_t numThreads = 1)
+    {
+        const auto n = q.size();
+        const auto lq = q.lanes();
+
+        //one partial state per thread, merged afterwards
+        const auto maxThreads = (numThreads > 0) ? numThreads :
+            std::max(std::size_t(1),
+                     std::size_t(std::thread::hardware_concurrency()));
+        std::vector<quaternion_mean_accumulator> partial(
+            std::min(maxThreads, std::max(std::size_t(1), n / (1 << 14))));
+
+        parallel_for_chunks(partial.size(), partial.size(), 1,
+            [&](std::size_t b, std::size_t e) {
+                const auto chunk = (n + partial.size() - 1) / partial.size();
+                for(auto c = b; c < e; ++c) {
+                    const auto cb = std::min(n, c * chunk);
+                    const auto ce = std::min(n, cb + chunk);
+                    if(wt) {
+                        partial[c].template accumulate<true>(lq, wt, cb, ce);
+                    } else {
+                        partial[c].template accumulate<false>(lq, wt, cb, ce);
+                    }
+                }
+            });
+
+        for(const auto& p : partial) *this += p;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief merges another partial state
+    quaternion_mean_accumulator&
+    operator += (const quaternion_mean_accumulator& o) noexcept
+    {
+        for(int k = 0; k < 10; ++k) m_[k] += o.m_[k];
+        weight_ += o.weight_;
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    inline friend quaternion_mean_accumulator
+    operator + (quaternion_mean_accumulator a,
+                const quaternion_mean_accumulator& b) noexcept
+    {
+        a += b;
+        return a;
+    }
+
+
+    //---------------------------------------------------------------
+    numeric_type
+    weight() const noexcept {
+        return weight_;
+    }
+
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return !(weight_ > numeric_type(0));
+    }
+
+    //-----------------------------------------------------
+    void
+    clear() noexcept {
+        m_ = std::array<numeric_type,10>{};
+        weight_ = numeric_type(0);
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief unit quaternion (real part >= 0) that represents the
+    ///        average rotation; identity if no samples were added
+    value_type
+    mean() const
+    {
+        if(empty()) return value_type{};
+
+        const auto& m = m_;
+        const auto e = detail::dominant_eigenvector_4x4(
+            std::array<std::array<numeric_type,4>,4>{{
+                {{m[0], m[1], m[2], m[3]}},
+                {{m[1], m[4], m[5], m[6]}},
+                {{m[2], m[5], m[7], m[8]}},
+                {{m[3], m[6], m[8], m[9]}} }});
+
+        const auto q = value_type{e[0], e[1], e[2], e[3]};
+        return normalized((e[0] < numeric_type(0)) ? numeric_type(-1) * q : q);
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    template<bool weighted>
+    void
+    accumulate(const quaternion_lanes<const numeric_type>& q,
+               const numeric_type* wt, std::size_t first, std::size_t last)
+    {
+        using wide_t = simd::pack<numeric_type>;
+        using tail_t = simd::pack<numeric_type,1>;
+
+        constexpr auto w = std::size_t(wide_t::size());
+
+        //lane-wise sums; reduced once at the end
+        wide_t s[10];
+        for(auto& x : s) x = wide_t::broadcast(numeric_type(0));
+
+        auto i = first;
+        for(; (i + w) <= last; i += w) {
+            detail::add_outer_product(
+                detail::quat_pack<wide_t,const numeric_type>::load(q,i),
+                weighted ? wide_t::load(wt+i)
+                         : wide_t::broadcast(numeric_type(1)), s);
+        }
+
+        alignas(wide_t) numeric_type buf[w];
+        for(int k = 0; k < 10; ++k) {
+            s[k].store(buf);
+            for(std::size_t j = 0; j < w; ++j) m_[k] += buf[j];
+        }
+
+        tail_t t[10];
+        for(int k = 0; k < 10; ++k) t[k] = tail_t{m_[k]};
+        for(; i < last; ++i) {
+            detail::add_outer_product(
+                detail::quat_pack<tail_t,const numeric_type>::load(q,i),
+                tail_t{weighted ? wt[i] : numeric_type(1)}, t);
+        }
+        for(int k = 0; k < 10; ++k) m_[k] = t[k].v;
+
+        if(weighted) {
+            for(auto j = first; j < last; ++j) weight_ += wt[j];
+        } else {
+            weight_ += numeric_type(last - first);
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    std::array<numeric_type,10> m_;
+    numeric_type weight_;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief average rotation of all q[i] (eigenvector method)
+ * @param wt  per-sample weights; nullptr = all weights 1
+ *
+ *****************************************************************************/
+template<class T>
+inline quaternion<T>
+mean(const quaternion_array<T>& q,
+     const typename quaternion_array<T>::numeric_type* wt = nullptr,
+     std::size_t numThreads = 1)
+{
+    quaternion_mean_accumulator<T> acc;
+    acc.add(q, wt, numThreads);
+    return acc.mean();
+}
+
+
+}  // namespace num
+}  // namespace am
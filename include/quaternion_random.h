@@ -0,0 +1,242 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include "philox.h"
+#include "quaternion_array.h"
+#include "simd_math.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * BULK RANDOM UNIT QUATERNIONS
+ *
+ * @details uniformly distributed rotations (Shoemake's method):
+ *            q = [sqrt(1-u0) sin(a), sqrt(1-u0) cos(a),
+ *                 sqrt(u0)   sin(b), sqrt(u0)   cos(b)]
+ *          with u0 uniform in [0,1) and a, b uniform in [0,2pi);
+ *
+ *          instead of full-circle trig the angles are drawn from
+ *          [0,pi/2) and both sines and cosines get independent random
+ *          signs, which gives the same distribution and allows
+ *          branch-free polynomial sin/cos on packs
+ *
+ *          random bits come from a Philox4x32 counter-based generator:
+ *          quaternion i only depends on (seed, stream, i); threads
+ *          always start at multiples of the block size, so only the
+ *          global tail takes the scalar path and results are
+ *          identical for any number of threads
+ *
+ *****************************************************************************/
+namespace detail {
+
+/// @brief number of Philox blocks per quaternion
+template<class T>
+constexpr std::size_t philox_blocks_per_quat =
+    (std::numeric_limits<T>::digits <= 24) ? 1 : 2;
+
+
+//-------------------------------------------------------------------
+/// @brief uniform number in [0,1) from 32 random bits
+template<class T>
+inline T
+uniform_from_bits(std::uint32_t bits) noexcept
+{
+    return T(bits >> 8) / T(std::uint32_t(1) << 24);
+}
+
+/// @brief uniform number in [0,1) from 64 random bits
+template<class T>
+inline T
+uniform_from_bits(std::uint64_t bits) noexcept
+{
+    constexpr int digits = std::min(std::numeric_limits<T>::digits, 64);
+    return T(bits >> (64 - digits)) /
+           T(std::uint64_t(1) << (digits - 1)) / T(2);
+}
+
+//---------------------------------------------------------
+inline std::uint64_t
+join_bits(std::uint32_t hi, std::uint32_t lo) noexcept
+{
+    return (std::uint64_t(hi) << 32) | lo;
+}
+
+
+//-------------------------------------------------------------------
+template<class T>
+struct random_quat_block
+{
+    static constexpr std::size_t size = 64;
+
+    alignas(simd::max_alignment) T u0[size];
+    alignas(simd::max_alignment) T u1[size];
+    alignas(simd::max_alignment) T u2[size];
+    alignas(simd::max_alignment) T sign[4][size];
+
+    /// @brief draws random numbers for quaternions [first, first+n)
+    void
+    fill(const philox4x32<>& rng, std::uint64_t first, std::size_t n) noexcept
+    {
+        constexpr auto nb = philox_blocks_per_quat<T>;
+
+        for(std::size_t j = 0; j < n; ++j) {
+            const auto c = (first + j) * nb;
+            const auto b0 = rng.block(c);
+            std::uint32_t sbits;
+            if(nb < 2) {
+                u0[j] = uniform_from_bits<T>(b0[0]);
+                u1[j] = uniform_from_bits<T>(b0[1]);
+                u2[j] = uniform_from_bits<T>(b0[2]);
+                sbits = b0[3];
+            } else {
+                const auto b1 = rng.block(c + 1);
+                u0[j] = uniform_from_bits<T>(join_bits(b0[0], b0[1]));
+                u1[j] = uniform_from_bits<T>(join_bits(b0[2], b0[3]));
+                u2[j] = uniform_from_bits<T>(join_bits(b1[0], b1[1]));
+                sbits = b1[2];
+            }
+            for(int k = 0; k < 4; ++k) {
+                sign[k][j] = ((sbits >> k) & 1u) ? T(-1) : T(1);
+            }
+        }
+    }
+};
+
+template<class T>
+constexpr std::size_t random_quat_block<T>::size;
+
+
+//-------------------------------------------------------------------
+/// @brief writes quaternions number [first,last) to out[0,last-first)
+template<class T>
+inline void
+random_unit_range(const philox4x32<>& rng,
+                  const quaternion_lanes<T>& out,
+                  std::size_t first, std::size_t last) noexcept
+{
+    using block_t = random_quat_block<T>;
+
+    block_t r;
+    for(auto b = first; b < last; b += block_t::size) {
+        const auto n = std::min(block_t::size, last - b);
+        r.fill(rng, b, n);
+
+        simd::for_each_pack<T>(n, [&](auto tag, std::size_t j) {
+            using p_t = decltype(tag);
+
+            const auto one = p_t::broadcast(T(1));
+            const auto hpi = p_t::broadcast(T(simd::detail::half_pi));
+
+            const auto u0 = p_t::load(r.u0+j);
+            const auto sa = sqrt(one - u0);
+            const auto sb = sqrt(u0);
+            const auto a = p_t::load(r.u1+j) * hpi;
+            const auto c = p_t::load(r.u2+j) * hpi;
+
+            const auto i = b - first + j;
+            (sa * simd::sin_pi2(a) * p_t::load(r.sign[0]+j)).store(out.w+i);
+            (sa * simd::cos_pi2(a) * p_t::load(r.sign[1]+j)).store(out.x+i);
+            (sb * simd::sin_pi2(c) * p_t::load(r.sign[2]+j)).store(out.y+i);
+            (sb * simd::cos_pi2(c) * p_t::load(r.sign[3]+j)).store(out.z+i);
+        });
+    }
+}
+
+} // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief fills 'out' with n uniformly distributed unit quaternions
+/// @param seed, stream  select the Philox sequence; different streams
+///                      are independent
+/// @param numThreads    1 = run on calling thread, 0 = all hardware threads
+/// @details the result only depends on (seed, stream, n)
+//-------------------------------------------------------------------
+template<class T>
+inline void
+random_unit_quaternions(quaternion_array<T>& out, std::size_t n,
+                        std::uint64_t seed, std::uint64_t stream = 0,
+                        std::size_t numThreads = 1)
+{
+    static_assert(
+        is_floating_point<T>::value,
+        "random_unit_quaternions: T must be a floating-point number type");
+
+    using block_t = detail::random_quat_block<T>;
+
+    out.resize(n);
+    const auto lo = out.lanes();
+    const auto rng = philox4x32<>{seed, stream};
+
+    //chunks are whole blocks so the pack/tail split is thread-independent
+    const auto nblocks = (n + block_t::size - 1) / block_t::size;
+
+    parallel_for_chunks(nblocks, numThreads, (1 << 14) / block_t::size,
+        [&](std::size_t bb, std::size_t be) {
+            const auto b = bb * block_t::size;
+            const auto e = std::min(n, be * block_t::size);
+            detail::random_unit_range(rng,
+                quaternion_lanes<T>{lo.w+b, lo.x+b, lo.y+b, lo.z+b}, b, e);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief fills buffer [first,last) with uniformly distributed
+///        unit quaternions; same values as the quaternion_array version
+template<class T>
+inline void
+random_unit_quaternions(quaternion<T>* first, quaternion<T>* last,
+                        std::uint64_t seed, std::uint64_t stream = 0,
+                        std::size_t numThreads = 1)
+{
+    static_assert(
+        is_floating_point<T>::value,
+        "random_unit_quaternions: T must be a floating-point number type");
+
+    using block_t = detail::random_quat_block<T>;
+
+    const auto n = static_cast<std::size_t>(last - first);
+    const auto rng = philox4x32<>{seed, stream};
+
+    //chunks are whole blocks so the pack/tail split is thread-independent
+    const auto nblocks = (n + block_t::size - 1) / block_t::size;
+
+    parallel_for_chunks(nblocks, numThreads, (1 << 14) / block_t::size,
+        [&](std::size_t bb, std::size_t be) {
+            auto b = bb * block_t::size;
+            const auto e = std::min(n, be * block_t::size);
+            //generate SoA blocks, then scatter into the buffer
+            alignas(simd::max_alignment) T l[4][block_t::size];
+            for(; b < e; b += block_t::size) {
+                const auto m = std::min(block_t::size, e - b);
+                detail::random_unit_range(rng,
+                    quaternion_lanes<T>{l[0], l[1], l[2], l[3]}, b, b + m);
+                for(std::size_t j = 0; j < m; ++j) {
+                    first[b+j] = quaternion<T>{l[0][j], l[1][j], l[2][j], l[3][j]};
+                }
+            }
+        });
+}
+
+
+}  // namespace num
+}  // namespace am
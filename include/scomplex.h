@@ -664,10 +664,31 @@ conj_times(const scomplex<T1>& x, const scomplex<T2>& y)
  *
  * FUNCTIONS
  *
- * @note f(r + e*d) = f(r) + d*f'(r) * e
- *       where e is the scomplex unit, r the real part and d the scomplex part
+ * @note analytic functions are evaluated in the null basis
+ *         e1 = (1 + j)/2,  e2 = (1 - j)/2   (e1*e1 = e1, e2*e2 = e2, e1*e2 = 0)
+ *       where r + j*i = (r+i) e1 + (r-i) e2, so that
+ *         f(r + j*i) = f(r+i) e1 + f(r-i) e2
+ *                    = (f(r+i) + f(r-i))/2 + j * (f(r+i) - f(r-i))/2
+ *       i.e. two independent real function calls;
+ *       results are real only if both r+i and r-i are in the domain of the
+ *       real function (e.g. |i| < r for sqrt and log)
  *
  *****************************************************************************/
+namespace detail {
+
+template<class T, class F>
+inline scomplex<T>
+apply_null_basis(const scomplex<T>& x, F&& f)
+{
+    const T fu = f(x.real() + x.imag());
+    const T fv = f(x.real() - x.imag());
+    return scomplex<T>{T(0.5) * (fu + fv), T(0.5) * (fu - fv)};
+}
+
+}  // namespace detail
+
+
+
 template<class T>
 inline
 scomplex<T>
@@ -713,72 +734,94 @@ abs2(const scomplex<T>& x)
 //-------------------------------------------------------------------
 // ROOTS
 //-------------------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//sqrt(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+sqrt(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::sqrt;
+        return sqrt(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//cbrt(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+cbrt(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::cbrt;
+        return cbrt(a);
+    });
+}
 
 
 
 //-------------------------------------------------------------------
 // EXPONENTIATION
 //-------------------------------------------------------------------
-//template<class T1, class T2>
-//inline
-//scomplex<T>
-//pow(const scomplex<T1> b, const scomplex<T2>& e)
-//{
-//
-//    //TODO
-//}
+template<class T1, class T2>
+inline auto
+pow(const scomplex<T1>& b, const scomplex<T2>& e)
+{
+    using std::pow;
+    using T = common_numeric_t<T1,T2>;
+
+    const auto fu = pow(T(b.real()) + T(b.imag()), T(e.real()) + T(e.imag()));
+    const auto fv = pow(T(b.real()) - T(b.imag()), T(e.real()) - T(e.imag()));
+    return scomplex<T>{T(0.5) * (fu + fv), T(0.5) * (fu - fv)};
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//pow(const scomplex<T> b, const T& e)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+pow(const scomplex<T>& b, const T& e)
+{
+    return detail::apply_null_basis(b, [&e](const T& a) {
+        using std::pow;
+        return pow(a, e);
+    });
+}
+
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//exp(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+exp(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::exp;
+        return exp(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//exp2(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+exp2(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::exp2;
+        return exp2(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//expm1(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+expm1(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::expm1;
+        return expm1(a);
+    });
+}
 
 //---------------------------------------------------------
 //template<class T>
@@ -812,31 +855,40 @@ abs2(const scomplex<T>& x)
 //-------------------------------------------------------------------
 // LOGARITHMS
 //-------------------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//log(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+log(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::log;
+        return log(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//log10(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+log10(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::log10;
+        return log10(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//log2(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+log2(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::log2;
+        return log2(a);
+    });
+}
 
 //---------------------------------------------------------
 /// @brief logarithm to floating-point basis (FLT_RADIX)
@@ -848,59 +900,70 @@ abs2(const scomplex<T>& x)
 //    //TODO
 //}
 
+
 //---------------------------------------------------------
 /// @brief logarithm + 1
-//template<class T>
-//inline
-//scomplex<T>
-//log1p(const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+log1p(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::log1p;
+        return log1p(a);
+    });
+}
 
 //---------------------------------------------------------
 /// @brief logarithm to any base
-//template<class T>
-//inline
-//scomplex<T>
-//log_base(const T& base, const scomplex<T>& x)
-//{
-//    //TODO
-//}
+template<class T>
+inline
+scomplex<T>
+log_base(const T& base, const scomplex<T>& x)
+{
+    using std::log;
+    return log(x) / log(base);
+}
 
 
 
 //-------------------------------------------------------------------
 // TRIGONOMETRIC
 //-------------------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//sin(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+sin(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::sin;
+        return sin(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//cos(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+cos(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::cos;
+        return cos(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//tan(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+tan(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::tan;
+        return tan(a);
+    });
+}
 
 
 
@@ -908,68 +971,80 @@ abs2(const scomplex<T>& x)
 //-------------------------------------------------------------------
 // INVERSE TRIGONOMETRIC
 //-------------------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//asin(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+asin(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::asin;
+        return asin(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//acos(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+acos(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::acos;
+        return acos(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//atan(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+atan(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::atan;
+        return atan(a);
+    });
+}
 
 
 
 //-------------------------------------------------------------------
 // HYPERBOLIC
 //-------------------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//sinh(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+sinh(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::sinh;
+        return sinh(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//cosh(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+cosh(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::cosh;
+        return cosh(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//tanh(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+tanh(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::tanh;
+        return tanh(a);
+    });
+}
 
 
 
@@ -977,34 +1052,40 @@ abs2(const scomplex<T>& x)
 //-------------------------------------------------------------------
 // INVERSE HYPERBOLIC
 //-------------------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//asinh(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+asinh(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::asinh;
+        return asinh(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//acosh(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+acosh(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::acosh;
+        return acosh(a);
+    });
+}
 
 //---------------------------------------------------------
-//template<class T>
-//inline
-//scomplex<T>
-//atanh(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+atanh(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::atanh;
+        return atanh(a);
+    });
+}
 
 
 
@@ -1012,23 +1093,29 @@ abs2(const scomplex<T>& x)
 //
 //-------------------------------------------------------------------
 ///@brief  error function
-//template<class T>
-//inline scomplex<T>
-//erf(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+erf(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::erf;
+        return erf(a);
+    });
+}
 
 //---------------------------------------------------------
 ///@brief complementary error function
-//template<class T>
-//inline scomplex<T>
-//erfc(const scomplex<T>& x)
-//{
-//    //TODO
-//    return scomplex<T>{};
-//}
+template<class T>
+inline
+scomplex<T>
+erfc(const scomplex<T>& x)
+{
+    return detail::apply_null_basis(x, [](const T& a) {
+        using std::erfc;
+        return erfc(a);
+    });
+}
 
 
 
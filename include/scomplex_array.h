@@ -0,0 +1,203 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "scomplex.h"
+#include "parallel.h"
+#include "simd.h"
+#include "simd_math.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief pointers to the real and imaginary lanes of a
+ *        structure-of-arrays sequence of split complex numbers;
+ *        T may be const-qualified
+ *
+ *****************************************************************************/
+template<class T>
+struct scomplex_lanes
+{
+    T* real;
+    T* imag;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * BATCH KERNELS
+ *
+ * @details out[i] = f(x[i]) for i in [0,n) with split complex numbers
+ *          x[i] = {x.real[i], x.imag[i]};
+ *          f is evaluated in the null basis (see scomplex.h), i.e. as
+ *          the real function f on packs of u = r+i and v = r-i;
+ *          full packs use the polynomial approximations from simd_math.h,
+ *          the tail elements (and all long double elements) use the
+ *          standard library;
+ *          the output may alias the input
+ *
+ *****************************************************************************/
+namespace detail {
+
+/// @brief f(p) is called with packs of null basis coordinates
+template<class T, class F>
+inline void
+unary_scomplex_kernel(std::size_t n, const scomplex_lanes<const T>& x,
+                      const scomplex_lanes<T>& out, std::size_t numThreads,
+                      F&& f)
+{
+    parallel_for_chunks(n, numThreads, 1 << 14,
+        [&](std::size_t b, std::size_t e) {
+            simd::for_each_pack<T>(e - b, [&](auto tag, std::size_t j) {
+                using p_t = decltype(tag);
+                const auto i = b + j;
+                const auto r = p_t::load(x.real+i);
+                const auto d = p_t::load(x.imag+i);
+                const auto fu = f(r + d);
+                const auto fv = f(r - d);
+                const auto half = p_t::broadcast(T(0.5));
+                (half * (fu + fv)).store(out.real+i);
+                (half * (fu - fv)).store(out.imag+i);
+            });
+        });
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline void
+exp(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) { return simd::exp(a); });
+}
+
+//---------------------------------------------------------
+/// @brief natural logarithm; requires |imag| < real
+template<class T>
+inline void
+log(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) { return simd::log(a); });
+}
+
+//---------------------------------------------------------
+/// @brief square root; requires |imag| <= real
+template<class T>
+inline void
+sqrt(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+     std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) { return simd::sqrt(a); });
+}
+
+//---------------------------------------------------------
+/// @brief x^p = e^(p log(x)); requires |imag| < real
+template<class T>
+inline void
+pow(std::size_t n, const scomplex_lanes<const T>& x, const T& p,
+    const scomplex_lanes<T>& out, std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [&p](const auto& a) {
+            using p_t = std::decay_t<decltype(a)>;
+            return simd::exp(p_t::broadcast(p) * simd::log(a));
+        });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+sin(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) { return simd::sin(a); });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+cos(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) { return simd::cos(a); });
+}
+
+//---------------------------------------------------------
+/// @brief (e^a - e^-a) / 2 per null basis coordinate;
+///        Taylor series for |a| < 1/2 where the difference would cancel
+template<class T>
+inline void
+sinh(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+     std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) {
+            using p_t = std::decay_t<decltype(a)>;
+            namespace sd = simd::detail;
+            const auto t = p_t::broadcast(T(0.5));
+            const auto e = simd::exp(a);
+            const auto large = t * (e - p_t::broadcast(T(1)) / e);
+            //sinh(s)/s = sinc(i s): sin Taylor coefficients at -s^2
+            const auto s = min(max(a, -t), t);
+            const auto small = s * sd::horner<sd::taylor_terms<T>>(
+                                       -(s*s), sd::sinc_coeffs);
+            return mul_add(sd::step(abs(a) - t), large - small, small);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief (e^a + e^-a) / 2 per null basis coordinate
+template<class T>
+inline void
+cosh(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+     std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) {
+            using p_t = std::decay_t<decltype(a)>;
+            const auto e = simd::exp(a);
+            return p_t::broadcast(T(0.5)) * (e + p_t::broadcast(T(1)) / e);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief error function
+template<class T>
+inline void
+erf(std::size_t n, const scomplex_lanes<const T>& x, const scomplex_lanes<T>& out,
+    std::size_t numThreads = 1)
+{
+    detail::unary_scomplex_kernel(n, x, out, numThreads,
+        [](const auto& a) { return simd::erf(a); });
+}
+
+
+}  // namespace num
+}  // namespace am
@@ -0,0 +1,755 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "scomplex.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ *
+ *
+ *****************************************************************************/
+template<class> class scomplex_diag;
+
+template<class>
+struct is_scomplex_diag :
+    std::false_type
+{};
+
+template<class T>
+struct is_scomplex_diag<scomplex_diag<T>> :
+    std::true_type
+{};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief
+ * split complex number in the null (diagonal) basis
+ *   x = a * e1 + b * e2   with e1 = (1 + j)/2, e2 = (1 - j)/2
+ * where e1*e1 = e1, e2*e2 = e2 and e1*e2 = 0;
+ * the scomplex r + j*i has a = r + i and b = r - i
+ *
+ * @details products, quotients and powers act on a and b independently
+ *          (2 real multiplications per product instead of 4);
+ *          use it for long products / powers and convert back at the end
+ *
+ *****************************************************************************/
+template<class NumberType>
+class scomplex_diag
+{
+public:
+
+    static_assert(is_number<NumberType>::value,
+        "scomplex_diag<T>: T must be a number type");
+
+    static_assert(!is_scomplex<NumberType>::value &&
+                  !is_scomplex_diag<NumberType>::value,
+        "scomplex_diag<T>: T must not be a split complex type itself");
+
+
+    //---------------------------------------------------------------
+    using value_type    = NumberType;
+    using numeric_type  = value_type;
+
+
+    //---------------------------------------------------------------
+    /// @brief default constructor
+    constexpr
+    scomplex_diag() = default;
+
+    /// @brief real number a = a e1 + a e2
+    explicit constexpr
+    scomplex_diag(const value_type& a):
+        a_{a}, b_{a}
+    {}
+
+    /// @brief from null basis coordinates
+    constexpr
+    scomplex_diag(const value_type& e1Part, const value_type& e2Part):
+        a_{e1Part}, b_{e2Part}
+    {}
+
+    /// @brief from (real,imag) representation
+    explicit constexpr
+    scomplex_diag(const scomplex<value_type>& x):
+        a_{x.real() + x.imag()}, b_{x.real() - x.imag()}
+    {}
+
+
+    constexpr
+    scomplex_diag(const scomplex_diag&) = default;
+
+    constexpr
+    scomplex_diag(scomplex_diag&&) = default;
+
+
+    //---------------------------------------------------------------
+    scomplex_diag&
+    operator = (const scomplex_diag&) = default;
+
+    scomplex_diag&
+    operator = (scomplex_diag&&) = default;
+
+
+    scomplex_diag&
+    operator = (const value_type& num)
+    {
+        a_ = num;
+        b_ = num;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief to (real,imag) representation
+    explicit constexpr
+    operator scomplex<value_type> () const {
+        return scomplex<value_type>{real(), imag()};
+    }
+
+
+    //---------------------------------------------------------------
+    // ELEMENT ACCESS
+    //---------------------------------------------------------------
+    constexpr const value_type&
+    e1() const noexcept {
+        return a_;
+    }
+
+    //-----------------------------------------------------
+    constexpr const value_type&
+    e2() const noexcept {
+        return b_;
+    }
+
+    //-----------------------------------------------------
+    constexpr value_type
+    real() const {
+        return value_type(0.5) * (a_ + b_);
+    }
+
+    //-----------------------------------------------------
+    constexpr value_type
+    imag() const {
+        return value_type(0.5) * (a_ - b_);
+    }
+
+
+    //---------------------------------------------------------------
+    scomplex_diag&
+    conjugate()
+    {
+        using std::swap;
+        swap(a_, b_);
+        return *this;
+    }
+
+    //---------------------------------------------------------
+    scomplex_diag&
+    negate() noexcept
+    {
+        a_ = -a_;
+        b_ = -b_;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // scomplex_diag (op)= number
+    //---------------------------------------------------------------
+    scomplex_diag&
+    operator += (const value_type& v) {
+        a_ += v;
+        b_ += v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    scomplex_diag&
+    operator -= (const value_type& v) {
+        a_ -= v;
+        b_ -= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    scomplex_diag&
+    operator *= (const value_type& v) {
+        a_ *= v;
+        b_ *= v;
+        return *this;
+    }
+    //-----------------------------------------------------
+    scomplex_diag&
+    operator /= (const value_type& v)
+    {
+        a_ /= v;
+        b_ /= v;
+        return *this;
+    }
+
+
+    //---------------------------------------------------------------
+    // scomplex_diag (op)= scomplex_diag
+    //---------------------------------------------------------------
+    scomplex_diag&
+    operator += (const scomplex_diag& o)
+    {
+        a_ += o.a_;
+        b_ += o.b_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    scomplex_diag&
+    operator -= (const scomplex_diag& o)
+    {
+        a_ -= o.a_;
+        b_ -= o.b_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    scomplex_diag&
+    operator *= (const scomplex_diag& o)
+    {
+        a_ *= o.a_;
+        b_ *= o.b_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    scomplex_diag&
+    operator /= (const scomplex_diag& o)
+    {
+        a_ /= o.a_;
+        b_ /= o.b_;
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    scomplex_diag&
+    times_conj(const scomplex_diag& o)
+    {
+        a_ *= o.b_;
+        b_ *= o.a_;
+        return *this;
+    }
+    //-----------------------------------------------------
+    scomplex_diag&
+    conj_times(const scomplex_diag& o)
+    {
+        const auto a = a_;
+        a_ = b_ * o.a_;
+        b_ = a  * o.b_;
+        return *this;
+    }
+
+
+private:
+    value_type a_;
+    value_type b_;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * CONVERSION
+ *
+ *****************************************************************************/
+template<class T>
+inline constexpr scomplex_diag<T>
+make_scomplex_diag(const scomplex<T>& x)
+{
+    return scomplex_diag<T>{x};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr scomplex<T>
+make_scomplex(const scomplex_diag<T>& x)
+{
+    return scomplex<T>{x.real(), x.imag()};
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * I/O
+ *
+ *****************************************************************************/
+template<class Ostream, class T>
+inline Ostream&
+operator << (Ostream& os, const scomplex_diag<T>& x)
+{
+    return (os << x.real() << " " << x.imag() );
+}
+
+//---------------------------------------------------------
+template<class T, class Ostream>
+inline Ostream&
+print(Ostream& os, const scomplex_diag<T>& d)
+{
+    return (os << "(" << d.real() << "," << d.imag() << ")" );
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ACCESS
+ *
+ *****************************************************************************/
+template<class T>
+inline constexpr auto
+real(const scomplex_diag<T>& d)
+{
+    return d.real();
+}
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+imag(const scomplex_diag<T>& d)
+{
+    return d.imag();
+}
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+conj(const scomplex_diag<T>& x)
+{
+    return scomplex_diag<T>{x.e2(), x.e1()};
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPARISON
+ *
+ *****************************************************************************/
+template<class T1, class T2>
+inline bool
+operator == (const scomplex_diag<T1>& a, const scomplex_diag<T2>& b)
+{
+    return ((a.e1() == b.e1()) && (a.e2() == b.e2()));
+}
+
+//---------------------------------------------------------
+template<class T1, class T2>
+inline bool
+operator != (const scomplex_diag<T1>& a, const scomplex_diag<T2>& b)
+{
+    return ((a.e1() != b.e1()) || (a.e2() != b.e2()));
+}
+
+
+//-------------------------------------------------------------------
+template<class T1, class T2, class T3 = common_numeric_t<T1,T2>>
+inline constexpr bool
+approx_equal(
+    const scomplex_diag<T1>& a, const scomplex_diag<T2>& b,
+    const T3& tol = tolerance<T3>)
+{
+    return (approx_equal(a.e1(), b.e1(), tol) &&
+            approx_equal(a.e2(), b.e2(), tol) );
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * ARITHMETIC
+ *
+ *****************************************************************************/
+template<class T1, class T2>
+inline constexpr auto
+operator + (const scomplex_diag<T1>& x, const scomplex_diag<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) + T(y.e1()), T(x.e2()) + T(y.e2()) };
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator + (const scomplex_diag<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) + T(y), T(x.e2()) + T(y) };
+}
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator + (const T2& y, const scomplex_diag<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(y) + T(x.e1()), T(y) + T(x.e2()) };
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline constexpr auto
+operator - (const scomplex_diag<T1>& x, const scomplex_diag<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) - T(y.e1()), T(x.e2()) - T(y.e2()) };
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator - (const scomplex_diag<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) - T(y), T(x.e2()) - T(y) };
+}
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator - (const T2& y, const scomplex_diag<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(y) - T(x.e1()), T(y) - T(x.e2()) };
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline constexpr auto
+operator * (const scomplex_diag<T1>& x, const scomplex_diag<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) * T(y.e1()), T(x.e2()) * T(y.e2()) };
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator * (const scomplex_diag<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) * T(y), T(x.e2()) * T(y) };
+}
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator * (const T2& y, const scomplex_diag<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(y) * T(x.e1()), T(y) * T(x.e2()) };
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief requires y to be invertible (both null coordinates != 0)
+template<class T1, class T2>
+inline constexpr auto
+operator / (const scomplex_diag<T1>& x, const scomplex_diag<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) / T(y.e1()), T(x.e2()) / T(y.e2()) };
+}
+
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator / (const scomplex_diag<T1>& x, const T2& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) / T(y), T(x.e2()) / T(y) };
+}
+//---------------------------------------------------------
+template<class T1, class T2, class =
+    std::enable_if_t<!is_scomplex_diag<T2>::value && !is_scomplex<T2>::value &&
+                     is_number<T2>::value>>
+inline constexpr auto
+operator / (const T2& y, const scomplex_diag<T1>& x)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(y) / T(x.e1()), T(y) / T(x.e2()) };
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline constexpr auto
+operator - (const scomplex_diag<T>& x)
+{
+    return scomplex_diag<T>{-x.e1(), -x.e2()};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline auto
+times_conj(const scomplex_diag<T1>& x, const scomplex_diag<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e1()) * T(y.e2()), T(x.e2()) * T(y.e1()) };
+}
+
+//---------------------------------------------------------
+template<class T1, class T2>
+inline auto
+conj_times(const scomplex_diag<T1>& x, const scomplex_diag<T2>& y)
+{
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{ T(x.e2()) * T(y.e1()), T(x.e1()) * T(y.e2()) };
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * FUNCTIONS
+ *
+ * @note f(a e1 + b e2) = f(a) e1 + f(b) e2
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief absolute value sqrt(r^2 - i^2) = sqrt(a b)
+template<class T>
+inline auto
+abs(const scomplex_diag<T>& x)
+{
+    using std::sqrt;
+    return sqrt(x.e1() * x.e2());
+}
+
+//---------------------------------------------------------
+/// @brief magnitude squared r^2 - i^2 = a b
+template<class T>
+inline auto
+abs2(const scomplex_diag<T>& x)
+{
+    return (x.e1() * x.e2());
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+sqrt(const scomplex_diag<T>& x)
+{
+    using std::sqrt;
+    return scomplex_diag<T>{sqrt(x.e1()), sqrt(x.e2())};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+cbrt(const scomplex_diag<T>& x)
+{
+    using std::cbrt;
+    return scomplex_diag<T>{cbrt(x.e1()), cbrt(x.e2())};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T1, class T2>
+inline auto
+pow(const scomplex_diag<T1>& b, const scomplex_diag<T2>& e)
+{
+    using std::pow;
+    using T = common_numeric_t<T1,T2>;
+    return scomplex_diag<T>{pow(T(b.e1()), T(e.e1())), pow(T(b.e2()), T(e.e2()))};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+pow(const scomplex_diag<T>& b, const T& e)
+{
+    using std::pow;
+    return scomplex_diag<T>{pow(b.e1(), e), pow(b.e2(), e)};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+exp(const scomplex_diag<T>& x)
+{
+    using std::exp;
+    return scomplex_diag<T>{exp(x.e1()), exp(x.e2())};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+log(const scomplex_diag<T>& x)
+{
+    using std::log;
+    return scomplex_diag<T>{log(x.e1()), log(x.e2())};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+sin(const scomplex_diag<T>& x)
+{
+    using std::sin;
+    return scomplex_diag<T>{sin(x.e1()), sin(x.e2())};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+cos(const scomplex_diag<T>& x)
+{
+    using std::cos;
+    return scomplex_diag<T>{cos(x.e1()), cos(x.e2())};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+sinh(const scomplex_diag<T>& x)
+{
+    using std::sinh;
+    return scomplex_diag<T>{sinh(x.e1()), sinh(x.e2())};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+cosh(const scomplex_diag<T>& x)
+{
+    using std::cosh;
+    return scomplex_diag<T>{cosh(x.e1()), cosh(x.e2())};
+}
+
+//---------------------------------------------------------
+template<class T>
+inline scomplex_diag<T>
+tanh(const scomplex_diag<T>& x)
+{
+    using std::tanh;
+    return scomplex_diag<T>{tanh(x.e1()), tanh(x.e2())};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+inline bool
+isfinite(const scomplex_diag<T>& x)
+{
+    using std::isfinite;
+    return (isfinite(x.e1()) && isfinite(x.e2()));
+}
+
+//---------------------------------------------------------
+template<class T>
+inline bool
+isnan(const scomplex_diag<T>& x)
+{
+    using std::isnan;
+    return (isnan(x.e1()) || isnan(x.e2()));
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * TRAITS SPECIALIZATIONS
+ *
+ *****************************************************************************/
+template<class T>
+struct is_number<scomplex_diag<T>> : std::true_type {};
+
+template<class T>
+struct is_number<scomplex_diag<T>&> : std::true_type {};
+
+template<class T>
+struct is_number<scomplex_diag<T>&&> : std::true_type {};
+
+template<class T>
+struct is_number<const scomplex_diag<T>&> : std::true_type {};
+
+template<class T>
+struct is_number<const scomplex_diag<T>> : std::true_type {};
+
+
+//-------------------------------------------------------------------
+template<class T>
+struct is_floating_point<scomplex_diag<T>> :
+    std::integral_constant<bool, is_floating_point<T>::value>
+{};
+
+
+
+//-------------------------------------------------------------------
+template<class T, class T2>
+struct common_numeric_type<scomplex_diag<T>,T2>
+{
+    using type = scomplex_diag<common_numeric_t<T,T2>>;
+};
+//---------------------------------------------------------
+template<class T, class T2>
+struct common_numeric_type<T2,scomplex_diag<T>>
+{
+    using type = scomplex_diag<common_numeric_t<T,T2>>;
+};
+//---------------------------------------------------------
+template<class T1, class T2>
+struct common_numeric_type<scomplex_diag<T1>,scomplex_diag<T2>>
+{
+    using type = scomplex_diag<common_numeric_t<T1,T2>>;
+};
+
+
+}  // namespace num
+}  // namespace am
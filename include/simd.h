@@ -0,0 +1,712 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <limits>
+#include <type_traits>
+
+#if !defined(AM_NUMERIC_NO_SIMD)
+    #if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+        #include <immintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #include <arm_neon.h>
+    #endif
+#endif
+
+
+namespace am {
+namespace num {
+namespace simd {
+
+
+/*****************************************************************************
+ *
+ * @brief number of lanes of the widest vector register available
+ *        for a given scalar type (1 = no vectorization)
+ *
+ * @details define AM_NUMERIC_NO_SIMD to force scalar code
+ *
+ *****************************************************************************/
+template<class T>
+struct native_width : std::integral_constant<int,1> {};
+
+#if !defined(AM_NUMERIC_NO_SIMD)
+    #if defined(__AVX512F__)
+        #define AM_NUMERIC_SIMD_AVX512
+        template<> struct native_width<float>  : std::integral_constant<int,16> {};
+        template<> struct native_width<double> : std::integral_constant<int,8> {};
+    #elif defined(__AVX__)
+        #define AM_NUMERIC_SIMD_AVX
+        template<> struct native_width<float>  : std::integral_constant<int,8> {};
+        template<> struct native_width<double> : std::integral_constant<int,4> {};
+    #elif defined(__SSE2__) || defined(_M_X64)
+        #define AM_NUMERIC_SIMD_SSE2
+        template<> struct native_width<float>  : std::integral_constant<int,4> {};
+        template<> struct native_width<double> : std::integral_constant<int,2> {};
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define AM_NUMERIC_SIMD_NEON
+        template<> struct native_width<float>  : std::integral_constant<int,4> {};
+        template<> struct native_width<double> : std::integral_constant<int,2> {};
+    #endif
+#endif
+
+
+/// @brief alignment (in bytes) that suits all vector loads/stores
+constexpr std::size_t max_alignment = 64;
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief fixed-width pack of scalars that maps to one vector register
+ *
+ * @details the primary template is the scalar fallback (1 lane);
+ *          all packs share the same interface so that kernels can be
+ *          written once as templates on the pack type:
+ *            P::load(ptr), P::broadcast(x), p.store(ptr),
+ *            + - * /, unary -, sqrt, rsqrt, mul_add, min, max, abs, copysign,
+ *            ldexp, frexp
+ *
+ *          rsqrt(x) ~ 1/sqrt(x) uses the hardware estimate refined by
+ *          Newton-Raphson steps where available; relative error is below
+ *          5e-7 for float packs and below 1e-13 for double packs
+ *          (the scalar fallback is exact; double estimates on SSE/AVX
+ *          are computed via float, so inputs must lie within float range)
+ *
+ *          ldexp(x,k) expects integral-valued k with 2^k being a normal
+ *          number, frexp(x,&e) expects a normal x; unlike the scalar
+ *          fallback, vector packs do not handle zeros, subnormals,
+ *          infinities or NaNs
+ *
+ *****************************************************************************/
+template<class T, int n = native_width<T>::value>
+struct pack
+{
+    static_assert(n == 1, "pack<T,n>: no vector type available for T and n");
+
+    using value_type  = T;
+    using native_type = T;
+
+    static constexpr int
+    size() noexcept { return 1; }
+
+    static pack
+    load(const T* p) noexcept { return pack{*p}; }
+
+    static pack
+    broadcast(const T& x) noexcept { return pack{x}; }
+
+    void
+    store(T* p) const noexcept { *p = v; }
+
+    native_type v;
+};
+
+//---------------------------------------------------------
+template<class T>
+inline pack<T,1> operator + (pack<T,1> a, pack<T,1> b) noexcept { return {a.v + b.v}; }
+template<class T>
+inline pack<T,1> operator - (pack<T,1> a, pack<T,1> b) noexcept { return {a.v - b.v}; }
+template<class T>
+inline pack<T,1> operator * (pack<T,1> a, pack<T,1> b) noexcept { return {a.v * b.v}; }
+template<class T>
+inline pack<T,1> operator / (pack<T,1> a, pack<T,1> b) noexcept { return {a.v / b.v}; }
+template<class T>
+inline pack<T,1> operator - (pack<T,1> a) noexcept { return {-a.v}; }
+
+template<class T>
+inline pack<T,1> sqrt(pack<T,1> a) noexcept { using std::sqrt; return {sqrt(a.v)}; }
+template<class T>
+inline pack<T,1> rsqrt(pack<T,1> a) noexcept { using std::sqrt; return {T(1) / sqrt(a.v)}; }
+template<class T>
+inline pack<T,1> mul_add(pack<T,1> a, pack<T,1> b, pack<T,1> c) noexcept { return {a.v * b.v + c.v}; }
+template<class T>
+inline pack<T,1> min(pack<T,1> a, pack<T,1> b) noexcept { return {(b.v < a.v) ? b.v : a.v}; }
+template<class T>
+inline pack<T,1> max(pack<T,1> a, pack<T,1> b) noexcept { return {(a.v < b.v) ? b.v : a.v}; }
+template<class T>
+inline pack<T,1> abs(pack<T,1> a) noexcept { using std::abs; return {abs(a.v)}; }
+/// @brief magnitude of a with sign of s
+template<class T>
+inline pack<T,1> copysign(pack<T,1> a, pack<T,1> s) noexcept { using std::copysign; return {copysign(a.v, s.v)}; }
+/// @brief a * 2^k with integral-valued k
+template<class T>
+inline pack<T,1> ldexp(pack<T,1> a, pack<T,1> k) noexcept { using std::ldexp; return {ldexp(a.v, int(k.v))}; }
+/// @brief mantissa m in [0.5,1) and exponent e with a = m * 2^e
+template<class T>
+inline pack<T,1> frexp(pack<T,1> a, pack<T,1>* e) noexcept {
+    using std::frexp;
+    int i = 0;
+    const auto m = frexp(a.v, &i);
+    e->v = T(i);
+    return {m};
+}
+
+
+//---------------------------------------------------------
+namespace detail {
+
+/// @brief one Newton-Raphson step refining y ~ 1/sqrt(x)
+template<class P>
+inline P
+rsqrt_step(const P& x, const P& y) noexcept
+{
+    using T = typename P::value_type;
+    return y * (P::broadcast(T(1.5)) - (P::broadcast(T(0.5)) * x) * (y * y));
+}
+
+}  // namespace detail
+
+
+
+
+#if defined(AM_NUMERIC_SIMD_SSE2) || defined(AM_NUMERIC_SIMD_AVX)
+namespace detail {
+
+//---------------------------------------------------------
+// exponent manipulation on 128-bit registers
+// (also used for the 256-bit packs if AVX2 is not available)
+//---------------------------------------------------------
+inline __m128 ldexp_ps(__m128 a, __m128 k) noexcept {
+    const auto e = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(k), _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(a, _mm_castsi128_ps(e));
+}
+inline __m128 frexp_ps(__m128 a, __m128* e) noexcept {
+    const auto b = _mm_castps_si128(a);
+    const auto x = _mm_srli_epi32(_mm_and_si128(b, _mm_set1_epi32(0x7f800000)), 23);
+    *e = _mm_cvtepi32_ps(_mm_sub_epi32(x, _mm_set1_epi32(126)));
+    return _mm_castsi128_ps(_mm_or_si128(
+        _mm_and_si128(b, _mm_set1_epi32(std::int32_t(0x807fffffu))),
+        _mm_set1_epi32(0x3f000000)));
+}
+
+//---------------------------------------------------------
+// 64-bit integer <-> double conversions via 2^52 + i
+// (exact for 0 <= i < 2^52)
+inline __m128d ldexp_pd(__m128d a, __m128d k) noexcept {
+    //exponent bits k + 1023 end up in the low mantissa bits
+    const auto t = _mm_add_pd(k, _mm_set1_pd(4503599627371519.0));
+    return _mm_mul_pd(a, _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(t), 52)));
+}
+inline __m128d frexp_pd(__m128d a, __m128d* e) noexcept {
+    const auto b = _mm_castpd_si128(a);
+    const auto x = _mm_srli_epi64(_mm_and_si128(b, _mm_set1_epi64x(0x7ff0000000000000)), 52);
+    *e = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(x, _mm_set1_epi64x(0x4330000000000000))),
+                    _mm_set1_pd(4503599627371518.0));
+    return _mm_castsi128_pd(_mm_or_si128(
+        _mm_and_si128(b, _mm_set1_epi64x(std::int64_t(0x800fffffffffffffull))),
+        _mm_set1_epi64x(0x3fe0000000000000)));
+}
+
+}  // namespace detail
+#endif
+
+
+
+
+#if defined(AM_NUMERIC_SIMD_SSE2)
+/*****************************************************************************
+ *
+ * SSE2
+ *
+ *****************************************************************************/
+template<>
+struct pack<float,4>
+{
+    using value_type  = float;
+    using native_type = __m128;
+    static constexpr int size() noexcept { return 4; }
+    static pack load(const float* p) noexcept { return {_mm_loadu_ps(p)}; }
+    static pack broadcast(float x) noexcept { return {_mm_set1_ps(x)}; }
+    void store(float* p) const noexcept { _mm_storeu_ps(p, v); }
+    native_type v;
+};
+
+inline pack<float,4> operator + (pack<float,4> a, pack<float,4> b) noexcept { return {_mm_add_ps(a.v, b.v)}; }
+inline pack<float,4> operator - (pack<float,4> a, pack<float,4> b) noexcept { return {_mm_sub_ps(a.v, b.v)}; }
+inline pack<float,4> operator * (pack<float,4> a, pack<float,4> b) noexcept { return {_mm_mul_ps(a.v, b.v)}; }
+inline pack<float,4> operator / (pack<float,4> a, pack<float,4> b) noexcept { return {_mm_div_ps(a.v, b.v)}; }
+inline pack<float,4> operator - (pack<float,4> a) noexcept { return {_mm_xor_ps(a.v, _mm_set1_ps(-0.0f))}; }
+inline pack<float,4> sqrt(pack<float,4> a) noexcept { return {_mm_sqrt_ps(a.v)}; }
+inline pack<float,4> rsqrt(pack<float,4> a) noexcept {
+    return detail::rsqrt_step(a, pack<float,4>{_mm_rsqrt_ps(a.v)});
+}
+inline pack<float,4> min(pack<float,4> a, pack<float,4> b) noexcept { return {_mm_min_ps(a.v, b.v)}; }
+inline pack<float,4> max(pack<float,4> a, pack<float,4> b) noexcept { return {_mm_max_ps(a.v, b.v)}; }
+inline pack<float,4> abs(pack<float,4> a) noexcept { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+inline pack<float,4> copysign(pack<float,4> a, pack<float,4> s) noexcept {
+    const auto m = _mm_set1_ps(-0.0f);
+    return {_mm_or_ps(_mm_andnot_ps(m, a.v), _mm_and_ps(m, s.v))};
+}
+inline pack<float,4> mul_add(pack<float,4> a, pack<float,4> b, pack<float,4> c) noexcept {
+    return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)};
+}
+inline pack<float,4> ldexp(pack<float,4> a, pack<float,4> k) noexcept { return {detail::ldexp_ps(a.v, k.v)}; }
+inline pack<float,4> frexp(pack<float,4> a, pack<float,4>* e) noexcept { return {detail::frexp_ps(a.v, &e->v)}; }
+
+//---------------------------------------------------------
+template<>
+struct pack<double,2>
+{
+    using value_type  = double;
+    using native_type = __m128d;
+    static constexpr int size() noexcept { return 2; }
+    static pack load(const double* p) noexcept { return {_mm_loadu_pd(p)}; }
+    static pack broadcast(double x) noexcept { return {_mm_set1_pd(x)}; }
+    void store(double* p) const noexcept { _mm_storeu_pd(p, v); }
+    native_type v;
+};
+
+inline pack<double,2> operator + (pack<double,2> a, pack<double,2> b) noexcept { return {_mm_add_pd(a.v, b.v)}; }
+inline pack<double,2> operator - (pack<double,2> a, pack<double,2> b) noexcept { return {_mm_sub_pd(a.v, b.v)}; }
+inline pack<double,2> operator * (pack<double,2> a, pack<double,2> b) noexcept { return {_mm_mul_pd(a.v, b.v)}; }
+inline pack<double,2> operator / (pack<double,2> a, pack<double,2> b) noexcept { return {_mm_div_pd(a.v, b.v)}; }
+inline pack<double,2> operator - (pack<double,2> a) noexcept { return {_mm_xor_pd(a.v, _mm_set1_pd(-0.0))}; }
+inline pack<double,2> sqrt(pack<double,2> a) noexcept { return {_mm_sqrt_pd(a.v)}; }
+inline pack<double,2> rsqrt(pack<double,2> a) noexcept {
+    const auto y = pack<double,2>{_mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(a.v)))};
+    return detail::rsqrt_step(a, detail::rsqrt_step(a, y));
+}
+inline pack<double,2> min(pack<double,2> a, pack<double,2> b) noexcept { return {_mm_min_pd(a.v, b.v)}; }
+inline pack<double,2> max(pack<double,2> a, pack<double,2> b) noexcept { return {_mm_max_pd(a.v, b.v)}; }
+inline pack<double,2> abs(pack<double,2> a) noexcept { return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)}; }
+inline pack<double,2> copysign(pack<double,2> a, pack<double,2> s) noexcept {
+    const auto m = _mm_set1_pd(-0.0);
+    return {_mm_or_pd(_mm_andnot_pd(m, a.v), _mm_and_pd(m, s.v))};
+}
+inline pack<double,2> mul_add(pack<double,2> a, pack<double,2> b, pack<double,2> c) noexcept {
+    return {_mm_add_pd(_mm_mul_pd(a.v, b.v), c.v)};
+}
+inline pack<double,2> ldexp(pack<double,2> a, pack<double,2> k) noexcept { return {detail::ldexp_pd(a.v, k.v)}; }
+inline pack<double,2> frexp(pack<double,2> a, pack<double,2>* e) noexcept { return {detail::frexp_pd(a.v, &e->v)}; }
+
+#endif
+
+
+
+
+#if defined(AM_NUMERIC_SIMD_AVX)
+/*****************************************************************************
+ *
+ * AVX / AVX2 (+FMA)
+ *
+ *****************************************************************************/
+template<>
+struct pack<float,8>
+{
+    using value_type  = float;
+    using native_type = __m256;
+    static constexpr int size() noexcept { return 8; }
+    static pack load(const float* p) noexcept { return {_mm256_loadu_ps(p)}; }
+    static pack broadcast(float x) noexcept { return {_mm256_set1_ps(x)}; }
+    void store(float* p) const noexcept { _mm256_storeu_ps(p, v); }
+    native_type v;
+};
+
+inline pack<float,8> operator + (pack<float,8> a, pack<float,8> b) noexcept { return {_mm256_add_ps(a.v, b.v)}; }
+inline pack<float,8> operator - (pack<float,8> a, pack<float,8> b) noexcept { return {_mm256_sub_ps(a.v, b.v)}; }
+inline pack<float,8> operator * (pack<float,8> a, pack<float,8> b) noexcept { return {_mm256_mul_ps(a.v, b.v)}; }
+inline pack<float,8> operator / (pack<float,8> a, pack<float,8> b) noexcept { return {_mm256_div_ps(a.v, b.v)}; }
+inline pack<float,8> operator - (pack<float,8> a) noexcept { return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+inline pack<float,8> sqrt(pack<float,8> a) noexcept { return {_mm256_sqrt_ps(a.v)}; }
+inline pack<float,8> rsqrt(pack<float,8> a) noexcept {
+    return detail::rsqrt_step(a, pack<float,8>{_mm256_rsqrt_ps(a.v)});
+}
+inline pack<float,8> min(pack<float,8> a, pack<float,8> b) noexcept { return {_mm256_min_ps(a.v, b.v)}; }
+inline pack<float,8> max(pack<float,8> a, pack<float,8> b) noexcept { return {_mm256_max_ps(a.v, b.v)}; }
+inline pack<float,8> abs(pack<float,8> a) noexcept { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+inline pack<float,8> copysign(pack<float,8> a, pack<float,8> s) noexcept {
+    const auto m = _mm256_set1_ps(-0.0f);
+    return {_mm256_or_ps(_mm256_andnot_ps(m, a.v), _mm256_and_ps(m, s.v))};
+}
+inline pack<float,8> mul_add(pack<float,8> a, pack<float,8> b, pack<float,8> c) noexcept {
+#if defined(__FMA__)
+    return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+#else
+    return {_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+inline pack<float,8> ldexp(pack<float,8> a, pack<float,8> k) noexcept {
+#if defined(__AVX2__)
+    const auto e = _mm256_slli_epi32(
+        _mm256_add_epi32(_mm256_cvtps_epi32(k.v), _mm256_set1_epi32(127)), 23);
+    return {_mm256_mul_ps(a.v, _mm256_castsi256_ps(e))};
+#else
+    const auto lo = detail::ldexp_ps(_mm256_castps256_ps128(a.v), _mm256_castps256_ps128(k.v));
+    const auto hi = detail::ldexp_ps(_mm256_extractf128_ps(a.v, 1), _mm256_extractf128_ps(k.v, 1));
+    return {_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1)};
+#endif
+}
+inline pack<float,8> frexp(pack<float,8> a, pack<float,8>* e) noexcept {
+#if defined(__AVX2__)
+    const auto b = _mm256_castps_si256(a.v);
+    const auto x = _mm256_srli_epi32(_mm256_and_si256(b, _mm256_set1_epi32(0x7f800000)), 23);
+    e->v = _mm256_cvtepi32_ps(_mm256_sub_epi32(x, _mm256_set1_epi32(126)));
+    return {_mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_and_si256(b, _mm256_set1_epi32(std::int32_t(0x807fffffu))),
+        _mm256_set1_epi32(0x3f000000)))};
+#else
+    __m128 elo, ehi;
+    const auto lo = detail::frexp_ps(_mm256_castps256_ps128(a.v), &elo);
+    const auto hi = detail::frexp_ps(_mm256_extractf128_ps(a.v, 1), &ehi);
+    e->v = _mm256_insertf128_ps(_mm256_castps128_ps256(elo), ehi, 1);
+    return {_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1)};
+#endif
+}
+
+//---------------------------------------------------------
+template<>
+struct pack<double,4>
+{
+    using value_type  = double;
+    using native_type = __m256d;
+    static constexpr int size() noexcept { return 4; }
+    static pack load(const double* p) noexcept { return {_mm256_loadu_pd(p)}; }
+    static pack broadcast(double x) noexcept { return {_mm256_set1_pd(x)}; }
+    void store(double* p) const noexcept { _mm256_storeu_pd(p, v); }
+    native_type v;
+};
+
+inline pack<double,4> operator + (pack<double,4> a, pack<double,4> b) noexcept { return {_mm256_add_pd(a.v, b.v)}; }
+inline pack<double,4> operator - (pack<double,4> a, pack<double,4> b) noexcept { return {_mm256_sub_pd(a.v, b.v)}; }
+inline pack<double,4> operator * (pack<double,4> a, pack<double,4> b) noexcept { return {_mm256_mul_pd(a.v, b.v)}; }
+inline pack<double,4> operator / (pack<double,4> a, pack<double,4> b) noexcept { return {_mm256_div_pd(a.v, b.v)}; }
+inline pack<double,4> operator - (pack<double,4> a) noexcept { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+inline pack<double,4> sqrt(pack<double,4> a) noexcept { return {_mm256_sqrt_pd(a.v)}; }
+inline pack<double,4> rsqrt(pack<double,4> a) noexcept {
+    const auto y = pack<double,4>{_mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(a.v)))};
+    return detail::rsqrt_step(a, detail::rsqrt_step(a, y));
+}
+inline pack<double,4> min(pack<double,4> a, pack<double,4> b) noexcept { return {_mm256_min_pd(a.v, b.v)}; }
+inline pack<double,4> max(pack<double,4> a, pack<double,4> b) noexcept { return {_mm256_max_pd(a.v, b.v)}; }
+inline pack<double,4> abs(pack<double,4> a) noexcept { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+inline pack<double,4> copysign(pack<double,4> a, pack<double,4> s) noexcept {
+    const auto m = _mm256_set1_pd(-0.0);
+    return {_mm256_or_pd(_mm256_andnot_pd(m, a.v), _mm256_and_pd(m, s.v))};
+}
+inline pack<double,4> mul_add(pack<double,4> a, pack<double,4> b, pack<double,4> c) noexcept {
+#if defined(__FMA__)
+    return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+#else
+    return {_mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v)};
+#endif
+}
+inline pack<double,4> ldexp(pack<double,4> a, pack<double,4> k) noexcept {
+#if defined(__AVX2__)
+    const auto t = _mm256_add_pd(k.v, _mm256_set1_pd(4503599627371519.0));
+    const auto e = _mm256_slli_epi64(_mm256_castpd_si256(t), 52);
+    return {_mm256_mul_pd(a.v, _mm256_castsi256_pd(e))};
+#else
+    const auto lo = detail::ldexp_pd(_mm256_castpd256_pd128(a.v), _mm256_castpd256_pd128(k.v));
+    const auto hi = detail::ldexp_pd(_mm256_extractf128_pd(a.v, 1), _mm256_extractf128_pd(k.v, 1));
+    return {_mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1)};
+#endif
+}
+inline pack<double,4> frexp(pack<double,4> a, pack<double,4>* e) noexcept {
+#if defined(__AVX2__)
+    const auto b = _mm256_castpd_si256(a.v);
+    const auto x = _mm256_srli_epi64(_mm256_and_si256(b, _mm256_set1_epi64x(0x7ff0000000000000)), 52);
+    e->v = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(x, _mm256_set1_epi64x(0x4330000000000000))),
+        _mm256_set1_pd(4503599627371518.0));
+    return {_mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(b, _mm256_set1_epi64x(std::int64_t(0x800fffffffffffffull))),
+        _mm256_set1_epi64x(0x3fe0000000000000)))};
+#else
+    __m128d elo, ehi;
+    const auto lo = detail::frexp_pd(_mm256_castpd256_pd128(a.v), &elo);
+    const auto hi = detail::frexp_pd(_mm256_extractf128_pd(a.v, 1), &ehi);
+    e->v = _mm256_insertf128_pd(_mm256_castpd128_pd256(elo), ehi, 1);
+    return {_mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1)};
+#endif
+}
+
+#endif
+
+
+
+
+#if defined(AM_NUMERIC_SIMD_AVX512)
+/*****************************************************************************
+ *
+ * AVX-512F
+ *
+ *****************************************************************************/
+template<>
+struct pack<float,16>
+{
+    using value_type  = float;
+    using native_type = __m512;
+    static constexpr int size() noexcept { return 16; }
+    static pack load(const float* p) noexcept { return {_mm512_loadu_ps(p)}; }
+    static pack broadcast(float x) noexcept { return {_mm512_set1_ps(x)}; }
+    void store(float* p) const noexcept { _mm512_storeu_ps(p, v); }
+    native_type v;
+};
+
+inline pack<float,16> operator + (pack<float,16> a, pack<float,16> b) noexcept { return {_mm512_add_ps(a.v, b.v)}; }
+inline pack<float,16> operator - (pack<float,16> a, pack<float,16> b) noexcept { return {_mm512_sub_ps(a.v, b.v)}; }
+inline pack<float,16> operator * (pack<float,16> a, pack<float,16> b) noexcept { return {_mm512_mul_ps(a.v, b.v)}; }
+inline pack<float,16> operator / (pack<float,16> a, pack<float,16> b) noexcept { return {_mm512_div_ps(a.v, b.v)}; }
+inline pack<float,16> operator - (pack<float,16> a) noexcept { return {_mm512_sub_ps(_mm512_setzero_ps(), a.v)}; }
+inline pack<float,16> sqrt(pack<float,16> a) noexcept { return {_mm512_sqrt_ps(a.v)}; }
+inline pack<float,16> rsqrt(pack<float,16> a) noexcept {
+    return detail::rsqrt_step(a, pack<float,16>{_mm512_rsqrt14_ps(a.v)});
+}
+inline pack<float,16> min(pack<float,16> a, pack<float,16> b) noexcept { return {_mm512_min_ps(a.v, b.v)}; }
+inline pack<float,16> max(pack<float,16> a, pack<float,16> b) noexcept { return {_mm512_max_ps(a.v, b.v)}; }
+inline pack<float,16> abs(pack<float,16> a) noexcept { return {_mm512_abs_ps(a.v)}; }
+inline pack<float,16> copysign(pack<float,16> a, pack<float,16> s) noexcept {
+    const auto m = _mm512_set1_epi32(0x7fffffff);
+    return {_mm512_castsi512_ps(_mm512_ternarylogic_epi32(
+        m, _mm512_castps_si512(a.v), _mm512_castps_si512(s.v), 0xca))};
+}
+inline pack<float,16> mul_add(pack<float,16> a, pack<float,16> b, pack<float,16> c) noexcept {
+    return {_mm512_fmadd_ps(a.v, b.v, c.v)};
+}
+inline pack<float,16> ldexp(pack<float,16> a, pack<float,16> k) noexcept { return {_mm512_scalef_ps(a.v, k.v)}; }
+inline pack<float,16> frexp(pack<float,16> a, pack<float,16>* e) noexcept {
+    e->v = _mm512_add_ps(_mm512_getexp_ps(a.v), _mm512_set1_ps(1.0f));
+    return {_mm512_getmant_ps(a.v, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src)};
+}
+
+//---------------------------------------------------------
+template<>
+struct pack<double,8>
+{
+    using value_type  = double;
+    using native_type = __m512d;
+    static constexpr int size() noexcept { return 8; }
+    static pack load(const double* p) noexcept { return {_mm512_loadu_pd(p)}; }
+    static pack broadcast(double x) noexcept { return {_mm512_set1_pd(x)}; }
+    void store(double* p) const noexcept { _mm512_storeu_pd(p, v); }
+    native_type v;
+};
+
+inline pack<double,8> operator + (pack<double,8> a, pack<double,8> b) noexcept { return {_mm512_add_pd(a.v, b.v)}; }
+inline pack<double,8> operator - (pack<double,8> a, pack<double,8> b) noexcept { return {_mm512_sub_pd(a.v, b.v)}; }
+inline pack<double,8> operator * (pack<double,8> a, pack<double,8> b) noexcept { return {_mm512_mul_pd(a.v, b.v)}; }
+inline pack<double,8> operator / (pack<double,8> a, pack<double,8> b) noexcept { return {_mm512_div_pd(a.v, b.v)}; }
+inline pack<double,8> operator - (pack<double,8> a) noexcept { return {_mm512_sub_pd(_mm512_setzero_pd(), a.v)}; }
+inline pack<double,8> sqrt(pack<double,8> a) noexcept { return {_mm512_sqrt_pd(a.v)}; }
+inline pack<double,8> rsqrt(pack<double,8> a) noexcept {
+    const auto y = pack<double,8>{_mm512_rsqrt14_pd(a.v)};
+    return detail::rsqrt_step(a, detail::rsqrt_step(a, y));
+}
+inline pack<double,8> min(pack<double,8> a, pack<double,8> b) noexcept { return {_mm512_min_pd(a.v, b.v)}; }
+inline pack<double,8> max(pack<double,8> a, pack<double,8> b) noexcept { return {_mm512_max_pd(a.v, b.v)}; }
+inline pack<double,8> abs(pack<double,8> a) noexcept { return {_mm512_abs_pd(a.v)}; }
+inline pack<double,8> copysign(pack<double,8> a, pack<double,8> s) noexcept {
+    const auto m = _mm512_set1_epi64(0x7fffffffffffffff);
+    return {_mm512_castsi512_pd(_mm512_ternarylogic_epi64(
+        m, _mm512_castpd_si512(a.v), _mm512_castpd_si512(s.v), 0xca))};
+}
+inline pack<double,8> mul_add(pack<double,8> a, pack<double,8> b, pack<double,8> c) noexcept {
+    return {_mm512_fmadd_pd(a.v, b.v, c.v)};
+}
+inline pack<double,8> ldexp(pack<double,8> a, pack<double,8> k) noexcept { return {_mm512_scalef_pd(a.v, k.v)}; }
+inline pack<double,8> frexp(pack<double,8> a, pack<double,8>* e) noexcept {
+    e->v = _mm512_add_pd(_mm512_getexp_pd(a.v), _mm512_set1_pd(1.0));
+    return {_mm512_getmant_pd(a.v, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src)};
+}
+
+#endif
+
+
+
+
+#if defined(AM_NUMERIC_SIMD_NEON)
+/*****************************************************************************
+ *
+ * NEON (AArch64)
+ *
+ *****************************************************************************/
+template<>
+struct pack<float,4>
+{
+    using value_type  = float;
+    using native_type = float32x4_t;
+    static constexpr int size() noexcept { return 4; }
+    static pack load(const float* p) noexcept { return {vld1q_f32(p)}; }
+    static pack broadcast(float x) noexcept { return {vdupq_n_f32(x)}; }
+    void store(float* p) const noexcept { vst1q_f32(p, v); }
+    native_type v;
+};
+
+inline pack<float,4> operator + (pack<float,4> a, pack<float,4> b) noexcept { return {vaddq_f32(a.v, b.v)}; }
+inline pack<float,4> operator - (pack<float,4> a, pack<float,4> b) noexcept { return {vsubq_f32(a.v, b.v)}; }
+inline pack<float,4> operator * (pack<float,4> a, pack<float,4> b) noexcept { return {vmulq_f32(a.v, b.v)}; }
+inline pack<float,4> operator / (pack<float,4> a, pack<float,4> b) noexcept { return {vdivq_f32(a.v, b.v)}; }
+inline pack<float,4> operator - (pack<float,4> a) noexcept { return {vnegq_f32(a.v)}; }
+inline pack<float,4> sqrt(pack<float,4> a) noexcept { return {vsqrtq_f32(a.v)}; }
+inline pack<float,4> rsqrt(pack<float,4> a) noexcept {
+    const auto y = pack<float,4>{vrsqrteq_f32(a.v)};
+    return detail::rsqrt_step(a, detail::rsqrt_step(a, y));
+}
+inline pack<float,4> min(pack<float,4> a, pack<float,4> b) noexcept { return {vminq_f32(a.v, b.v)}; }
+inline pack<float,4> max(pack<float,4> a, pack<float,4> b) noexcept { return {vmaxq_f32(a.v, b.v)}; }
+inline pack<float,4> abs(pack<float,4> a) noexcept { return {vabsq_f32(a.v)}; }
+inline pack<float,4> copysign(pack<float,4> a, pack<float,4> s) noexcept {
+    return {vbslq_f32(vdupq_n_u32(0x80000000u), s.v, a.v)};
+}
+inline pack<float,4> mul_add(pack<float,4> a, pack<float,4> b, pack<float,4> c) noexcept {
+    return {vfmaq_f32(c.v, a.v, b.v)};
+}
+inline pack<float,4> ldexp(pack<float,4> a, pack<float,4> k) noexcept {
+    const auto e = vshlq_n_s32(vaddq_s32(vcvtnq_s32_f32(k.v), vdupq_n_s32(127)), 23);
+    return {vmulq_f32(a.v, vreinterpretq_f32_s32(e))};
+}
+inline pack<float,4> frexp(pack<float,4> a, pack<float,4>* e) noexcept {
+    const auto b = vreinterpretq_u32_f32(a.v);
+    const auto x = vshrq_n_u32(vandq_u32(b, vdupq_n_u32(0x7f800000u)), 23);
+    e->v = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(x), vdupq_n_s32(126)));
+    return {vreinterpretq_f32_u32(vorrq_u32(
+        vandq_u32(b, vdupq_n_u32(0x807fffffu)), vdupq_n_u32(0x3f000000u)))};
+}
+
+//---------------------------------------------------------
+template<>
+struct pack<double,2>
+{
+    using value_type  = double;
+    using native_type = float64x2_t;
+    static constexpr int size() noexcept { return 2; }
+    static pack load(const double* p) noexcept { return {vld1q_f64(p)}; }
+    static pack broadcast(double x) noexcept { return {vdupq_n_f64(x)}; }
+    void store(double* p) const noexcept { vst1q_f64(p, v); }
+    native_type v;
+};
+
+inline pack<double,2> operator + (pack<double,2> a, pack<double,2> b) noexcept { return {vaddq_f64(a.v, b.v)}; }
+inline pack<double,2> operator - (pack<double,2> a, pack<double,2> b) noexcept { return {vsubq_f64(a.v, b.v)}; }
+inline pack<double,2> operator * (pack<double,2> a, pack<double,2> b) noexcept { return {vmulq_f64(a.v, b.v)}; }
+inline pack<double,2> operator / (pack<double,2> a, pack<double,2> b) noexcept { return {vdivq_f64(a.v, b.v)}; }
+inline pack<double,2> operator - (pack<double,2> a) noexcept { return {vnegq_f64(a.v)}; }
+inline pack<double,2> sqrt(pack<double,2> a) noexcept { return {vsqrtq_f64(a.v)}; }
+inline pack<double,2> rsqrt(pack<double,2> a) noexcept {
+    const auto y = pack<double,2>{vrsqrteq_f64(a.v)};
+    return detail::rsqrt_step(a, detail::rsqrt_step(a, detail::rsqrt_step(a, y)));
+}
+inline pack<double,2> min(pack<double,2> a, pack<double,2> b) noexcept { return {vminq_f64(a.v, b.v)}; }
+inline pack<double,2> max(pack<double,2> a, pack<double,2> b) noexcept { return {vmaxq_f64(a.v, b.v)}; }
+inline pack<double,2> abs(pack<double,2> a) noexcept { return {vabsq_f64(a.v)}; }
+inline pack<double,2> copysign(pack<double,2> a, pack<double,2> s) noexcept {
+    return {vbslq_f64(vdupq_n_u64(0x8000000000000000ull), s.v, a.v)};
+}
+inline pack<double,2> mul_add(pack<double,2> a, pack<double,2> b, pack<double,2> c) noexcept {
+    return {vfmaq_f64(c.v, a.v, b.v)};
+}
+inline pack<double,2> ldexp(pack<double,2> a, pack<double,2> k) noexcept {
+    const auto e = vshlq_n_s64(vaddq_s64(vcvtnq_s64_f64(k.v), vdupq_n_s64(1023)), 52);
+    return {vmulq_f64(a.v, vreinterpretq_f64_s64(e))};
+}
+inline pack<double,2> frexp(pack<double,2> a, pack<double,2>* e) noexcept {
+    const auto b = vreinterpretq_u64_f64(a.v);
+    const auto x = vshrq_n_u64(vandq_u64(b, vdupq_n_u64(0x7ff0000000000000ull)), 52);
+    e->v = vcvtq_f64_s64(vsubq_s64(vreinterpretq_s64_u64(x), vdupq_n_s64(1022)));
+    return {vreinterpretq_f64_u64(vorrq_u64(
+        vandq_u64(b, vdupq_n_u64(0x800fffffffffffffull)), vdupq_n_u64(0x3fe0000000000000ull)))};
+}
+
+#endif
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief calls kernel(P{}, i) for all i in [0,n) with P being the
+ *        native pack type for as long as full packs fit and
+ *        the 1-lane pack type for the remaining tail elements
+ *
+ *****************************************************************************/
+template<class T, class Kernel>
+inline void
+for_each_pack(std::size_t n, Kernel&& kernel)
+{
+    using wide_t = pack<T>;
+    using tail_t = pack<T,1>;
+
+    constexpr auto w = std::size_t(wide_t::size());
+
+    std::size_t i = 0;
+    if(w > 1) {
+        for(; (i + w) <= n; i += w) kernel(wide_t{}, i);
+    }
+    for(; i < n; ++i) kernel(tail_t{}, i);
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief minimal allocator returning memory aligned to 'Align' bytes;
+ *        used for SoA lane storage
+ *
+ *****************************************************************************/
+template<class T, std::size_t Align = max_alignment>
+class aligned_allocator
+{
+    static_assert(Align >= alignof(void*) && (Align & (Align-1)) == 0,
+        "aligned_allocator: alignment must be a power of 2");
+
+public:
+    using value_type = T;
+
+    template<class U>
+    struct rebind { using other = aligned_allocator<U,Align>; };
+
+    aligned_allocator() noexcept = default;
+
+    template<class U>
+    aligned_allocator(const aligned_allocator<U,Align>&) noexcept {}
+
+    T*
+    allocate(std::size_t n)
+    {
+        if(n > (std::numeric_limits<std::size_t>::max() - Align) / sizeof(T)) {
+            throw std::bad_alloc{};
+        }
+        //over-allocate and remember original address right before block
+        void* raw = std::malloc(n * sizeof(T) + Align + sizeof(void*));
+        if(!raw) throw std::bad_alloc{};
+
+        auto addr = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        addr = (addr + Align - 1) & ~std::uintptr_t(Align - 1);
+
+        void** p = reinterpret_cast<void**>(addr);
+        p[-1] = raw;
+        return reinterpret_cast<T*>(p);
+    }
+
+    void
+    deallocate(T* p, std::size_t) noexcept
+    {
+        if(p) std::free(reinterpret_cast<void**>(p)[-1]);
+    }
+
+    template<class U>
+    bool operator == (const aligned_allocator<U,Align>&) const noexcept { return true; }
+    template<class U>
+    bool operator != (const aligned_allocator<U,Align>&) const noexcept { return false; }
+};
+
+
+}  // namespace simd
+}  // namespace num
+}  // namespace am
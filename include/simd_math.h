@@ -0,0 +1,596 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "simd.h"
+
+
+namespace am {
+namespace num {
+namespace simd {
+
+
+/*****************************************************************************
+ *
+ * POLYNOMIAL APPROXIMATIONS
+ *
+ * @details branch-free elementary functions on packs for use in batch
+ *          kernels; the number of terms is chosen according to the
+ *          precision of the scalar type
+ *
+ *****************************************************************************/
+namespace detail {
+
+//-------------------------------------------------------------------
+/// @brief (-1)^k / (2k+1)!
+constexpr long double sinc_coeffs[] = {
+     1.000000000000000000000e+0L,
+    -1.666666666666666666667e-1L,
+     8.333333333333333333333e-3L,
+    -1.984126984126984126984e-4L,
+     2.755731922398589065256e-6L,
+    -2.505210838544171877505e-8L,
+     1.605904383682161459939e-10L,
+    -7.647163731819816475901e-13L,
+     2.811457254345520763199e-15L,
+    -8.220635246624329716956e-18L,
+     1.957294106339126123085e-20L,
+    -3.868170170630684037717e-23L,
+     6.446950284384473396195e-26L,
+    -9.183689863795546148426e-29L
+};
+
+/// @brief (-1)^k / (2k)!
+constexpr long double cos_coeffs[] = {
+     1.000000000000000000000e+0L,
+    -5.000000000000000000000e-1L,
+     4.166666666666666666667e-2L,
+    -1.388888888888888888889e-3L,
+     2.480158730158730158730e-5L,
+    -2.755731922398589065256e-7L,
+     2.087675698786809897921e-9L,
+    -1.147074559772972471385e-11L,
+     4.779477332387385297438e-14L,
+    -1.561920696858622646222e-16L,
+     4.110317623312164858478e-19L,
+    -8.896791392450573286749e-22L,
+     1.611737571096118349049e-24L,
+    -2.479596263224797460075e-27L
+};
+
+/// @brief (-1)^k / (2k+1)
+constexpr long double atan_coeffs[] = {
+     1.000000000000000000000e+0L,
+    -3.333333333333333333333e-1L,
+     2.000000000000000000000e-1L,
+    -1.428571428571428571429e-1L,
+     1.111111111111111111111e-1L,
+    -9.090909090909090909091e-2L,
+     7.692307692307692307692e-2L,
+    -6.666666666666666666667e-2L,
+     5.882352941176470588235e-2L,
+    -5.263157894736842105263e-2L,
+     4.761904761904761904762e-2L,
+    -4.347826086956521739130e-2L,
+     4.000000000000000000000e-2L,
+    -3.703703703703703703704e-2L
+};
+
+/// @brief pi/2 in full long double precision
+constexpr long double half_pi = 1.570796326794896619231321691639751442L;
+
+/// @brief number of Taylor terms needed for |x| <= pi/2
+///        (also sufficient for atan(x) with |x| <= tan(pi/16))
+template<class T>
+constexpr int taylor_terms =
+    (std::numeric_limits<T>::digits <= 24) ? 7 :
+   ((std::numeric_limits<T>::digits <= 53) ? 11 : 14);
+
+
+//-------------------------------------------------------------------
+template<int n, class P>
+inline P
+horner(const P& x, const long double* c) noexcept
+{
+    using T = typename P::value_type;
+
+    auto r = P::broadcast(T(c[n-1]));
+    for(int k = n-2; k >= 0; --k) {
+        r = mul_add(r, x, P::broadcast(T(c[k])));
+    }
+    return r;
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief sin(x)/x for |x| <= pi/2; sinc(0) = 1
+/// @details truncated Taylor series in x^2
+///          max. relative error ~ 1 ulp of the pack's scalar type
+//-------------------------------------------------------------------
+template<class P>
+inline P
+sinc(const P& x) noexcept
+{
+    using T = typename P::value_type;
+    return detail::horner<detail::taylor_terms<T>>(x*x, detail::sinc_coeffs);
+}
+
+//---------------------------------------------------------
+/// @brief sin(x) for |x| <= pi/2
+template<class P>
+inline P
+sin_pi2(const P& x) noexcept
+{
+    return x * sinc(x);
+}
+
+//---------------------------------------------------------
+/// @brief cos(x) for |x| <= pi/2
+template<class P>
+inline P
+cos_pi2(const P& x) noexcept
+{
+    using T = typename P::value_type;
+    return detail::horner<detail::taylor_terms<T>>(x*x, detail::cos_coeffs);
+}
+
+//---------------------------------------------------------
+/// @brief atan2(y,x) for all finite y,x (incl. signed zeros)
+/// @details reduces |y|/|x| to the first octant, applies the half-angle
+///          identity atan(a) = 2 atan(a / (1 + sqrt(1 + a^2))) twice and
+///          evaluates a Taylor series on |a| <= tan(pi/16);
+///          octant and quadrant are restored with exact sign arithmetic
+///          (no blends), so small angles keep their relative precision
+template<class P>
+inline P
+atan2(const P& y, const P& x) noexcept
+{
+    using T = typename P::value_type;
+
+    const auto one = P::broadcast(T(1));
+    const auto ax = abs(x);
+    const auto ay = abs(y);
+
+    //0/0 -> 0
+    auto a = min(ax,ay) / max(max(ax,ay),
+                              P::broadcast(std::numeric_limits<T>::min()));
+    a = a / (one + sqrt(mul_add(a, a, one)));
+    a = a / (one + sqrt(mul_add(a, a, one)));
+
+    const auto t = P::broadcast(T(4)) * a *
+        detail::horner<detail::taylor_terms<T>>(a*a, detail::atan_coeffs);
+
+    //|y| > |x|: pi/2 - t
+    const auto d = ax - ay;
+    const auto qpi = P::broadcast(T(detail::half_pi / 2));
+    const auto b1 = qpi - copysign(qpi, d);
+    const auto r1 = mul_add(copysign(one, d), t, b1);
+
+    //x < 0: pi - r1
+    const auto hpi = P::broadcast(T(detail::half_pi));
+    const auto b2 = hpi - copysign(hpi, x);
+    const auto r2 = mul_add(copysign(one, x), r1, b2);
+
+    return copysign(r2, y);
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * EXPONENTIAL, LOGARITHM, SINE / COSINE, ERROR FUNCTION
+ *
+ * @details full-range versions for float and double packs:
+ *          Cody-Waite argument reduction followed by the minimax
+ *          polynomials / rational functions from the Cephes library
+ *          (Cody's rational approximations for erf);
+ *          max. relative error of a few ulp; quadrant and range
+ *          selections are done with exact sign arithmetic (no branches)
+ *
+ *          1-lane packs call the standard library functions instead
+ *          (this also covers long double)
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<class T>
+using is_single_precision =
+    std::integral_constant<bool,(std::numeric_limits<T>::digits <= 24)>;
+
+
+//-------------------------------------------------------------------
+/// @brief Cephes expf: e^r - 1 - r = r^2 * P(r) for |r| <= ln(2)/2
+constexpr long double expf_minimax[] = {
+    5.0000001201E-1L, 1.6666665459E-1L, 4.1665795894E-2L,
+    8.3334519073E-3L, 1.3981999507E-3L, 1.9875691500E-4L
+};
+
+/// @brief Cephes exp: e^r = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+constexpr long double exp_pade_p[] = {
+    9.99999999999999999910E-1L, 3.02994407707441961300E-2L,
+    1.26177193074810590878E-4L
+};
+constexpr long double exp_pade_q[] = {
+    2.00000000000000000009E0L,  2.27265548208155028766E-1L,
+    2.52448340349684104192E-3L, 3.00198505138664455042E-6L
+};
+
+/// @brief Cephes logf: log(1+f) = f - f^2/2 + f^3 P(f)
+///        for sqrt(1/2)-1 <= f < sqrt(2)-1
+constexpr long double logf_minimax[] = {
+     3.3333331174E-1L, -2.4999993993E-1L,  2.0000714765E-1L,
+    -1.6668057665E-1L,  1.4249322787E-1L, -1.2420140846E-1L,
+     1.1676998740E-1L, -1.1514610310E-1L,  7.0376836292E-2L
+};
+
+/// @brief Cephes log: log(1+f) = f - f^2/2 + f^3 P(f)/Q(f)
+constexpr long double log_rational_p[] = {
+    7.70838733755885391666E0L, 1.79368678507819816313E1L,
+    1.44989225341610930846E1L, 4.70579119878881725854E0L,
+    4.97494994976747001425E-1L, 1.01875663804580931796E-4L
+};
+constexpr long double log_rational_q[] = {
+    2.31251620126765340583E1L, 7.11544750618563894466E1L,
+    8.29875266912776603211E1L, 4.52279145837532221105E1L,
+    1.12873587189167450590E1L, 1.0L
+};
+
+/// @brief Cephes sinf/cosf for |r| <= pi/4:
+///        sin(r) = r + r^3 S(r^2),  cos(r) = 1 - r^2/2 + r^4 C(r^2)
+constexpr long double sinf_minimax[] = {
+    -1.6666654611E-1L, 8.3321608736E-3L, -1.9515295891E-4L
+};
+constexpr long double cosf_minimax[] = {
+    4.166664568298827E-2L, -1.388731625493765E-3L, 2.443315711809948E-5L
+};
+
+/// @brief Cephes sin/cos (double)
+constexpr long double sin_minimax[] = {
+    -1.66666666666666307295E-1L,  8.33333333332211858878E-3L,
+    -1.98412698295895385996E-4L,  2.75573136213857245213E-6L,
+    -2.50507477628578072866E-8L,  1.58962301576546568060E-10L
+};
+constexpr long double cos_minimax[] = {
+     4.16666666666665929218E-2L, -1.38888888888730564116E-3L,
+     2.48015872888517045348E-5L, -2.75573141792967388112E-7L,
+     2.08757008419747316778E-9L, -1.13585365213876817300E-11L
+};
+
+/// @brief Cody: erf(x) = x P(x^2)/Q(x^2) for |x| <= 0.46875
+constexpr long double erf_small_p[] = {
+    3.20937758913846947e03L, 3.77485237685302021e02L, 1.13864154151050156e02L,
+    3.16112374387056560e00L, 1.85777706184603153e-1L
+};
+constexpr long double erf_small_q[] = {
+    2.84423683343917062e03L, 1.28261652607737228e03L, 2.44024637934444173e02L,
+    2.36012909523441209e01L, 1.0L
+};
+
+/// @brief Cody: erfc(x) = e^(-x^2) P(x)/Q(x) for 0.46875 <= x <= 4
+constexpr long double erfc_mid_p[] = {
+    1.23033935479799725e03L, 2.05107837782607147e03L, 1.71204761263407058e03L,
+    8.81952221241769090e02L, 2.98635138197400131e02L, 6.61191906371416295e01L,
+    8.88314979438837594e00L, 5.64188496988670089e-1L, 2.15311535474403846e-8L
+};
+constexpr long double erfc_mid_q[] = {
+    1.23033935480374942e03L, 3.43936767414372164e03L, 4.36261909014324716e03L,
+    3.29079923573345963e03L, 1.62138957456669019e03L, 5.37181101862009858e02L,
+    1.17693950891312499e02L, 1.57449261107098347e01L, 1.0L
+};
+
+/// @brief Cody: erfc(x) = e^(-x^2)/x (1/sqrt(pi) - z P(z)/Q(z)),
+///        z = 1/x^2 for x >= 4
+constexpr long double erfc_large_p[] = {
+    6.58749161529837803e-4L, 1.60837851487422766e-2L, 1.25781726111229246e-1L,
+    3.60344899949804439e-1L, 3.05326634961232344e-1L, 1.63153871373020978e-2L
+};
+constexpr long double erfc_large_q[] = {
+    2.33520497626869185e-3L, 6.05183413124413191e-2L, 5.27905102951428412e-1L,
+    1.87295284992346725e00L, 2.56852019228982242e00L, 1.0L
+};
+
+constexpr long double log2e      = 1.442695040888963407359924681001892137L;
+constexpr long double two_div_pi = 0.636619772367581343075535053490057448L;
+constexpr long double sqrt_half  = 0.707106781186547524400844362104849039L;
+constexpr long double rsqrt_pi   = 0.564189583547756286948079451560772586L;
+
+
+//-------------------------------------------------------------------
+/// @brief round to nearest integer for |x| < 2^(digits-2)
+template<class P>
+inline P
+round_nearest(const P& x) noexcept
+{
+    using T = typename P::value_type;
+    //1.5 * 2^(digits-1): adding it pushes all fraction bits out
+    const auto m = P::broadcast(
+        T(3) * T(std::uint64_t(1) << (std::numeric_limits<T>::digits - 2)));
+    return (x + m) - m;
+}
+
+//---------------------------------------------------------
+/// @brief 1 where d >= 0, 0 where d < 0
+template<class P>
+inline P
+step(const P& d) noexcept
+{
+    using T = typename P::value_type;
+    const auto half = P::broadcast(T(0.5));
+    return half + copysign(half, d);
+}
+
+
+//-------------------------------------------------------------------
+/// @brief e^r for |r| <= ln(2)/2
+template<class P>
+inline P
+exp_reduced(const P& r, std::true_type) noexcept
+{
+    using T = typename P::value_type;
+    return mul_add(horner<6>(r, expf_minimax), r*r, r) + P::broadcast(T(1));
+}
+
+template<class P>
+inline P
+exp_reduced(const P& r, std::false_type) noexcept
+{
+    using T = typename P::value_type;
+    const auto rr = r*r;
+    const auto p = r * horner<3>(rr, exp_pade_p);
+    const auto q = horner<4>(rr, exp_pade_q);
+    return P::broadcast(T(1)) + P::broadcast(T(2)) * p / (q - p);
+}
+
+//---------------------------------------------------------
+/// @brief f^3 (P(f) or P(f)/Q(f)) part of log(1+f)
+template<class P>
+inline P
+log_reduced(const P& f, const P& ff, std::true_type) noexcept
+{
+    return f * ff * horner<9>(f, logf_minimax);
+}
+
+template<class P>
+inline P
+log_reduced(const P& f, const P& ff, std::false_type) noexcept
+{
+    return f * ff * horner<6>(f, log_rational_p) / horner<6>(f, log_rational_q);
+}
+
+//---------------------------------------------------------
+/// @brief sin(r), cos(r) for |r| <= pi/4; Cody-Waite parts of pi/2
+template<class P>
+inline void
+sincos_reduced(const P& r, P* s, P* c, std::true_type) noexcept
+{
+    using T = typename P::value_type;
+    const auto rr = r*r;
+    *s = mul_add(r*rr, horner<3>(rr, sinf_minimax), r);
+    *c = mul_add(rr*rr, horner<3>(rr, cosf_minimax),
+                 mul_add(rr, P::broadcast(T(-0.5)), P::broadcast(T(1))));
+}
+
+template<class P>
+inline void
+sincos_reduced(const P& r, P* s, P* c, std::false_type) noexcept
+{
+    using T = typename P::value_type;
+    const auto rr = r*r;
+    *s = mul_add(r*rr, horner<6>(rr, sin_minimax), r);
+    *c = mul_add(rr*rr, horner<6>(rr, cos_minimax),
+                 mul_add(rr, P::broadcast(T(-0.5)), P::broadcast(T(1))));
+}
+
+constexpr long double pio2f_parts[] = {
+    1.5703125L, 4.837512969970703125E-4L, 7.54978995489188216E-8L
+};
+constexpr long double pio2_parts[] = {
+    1.57079625129699707031E0L, 7.54978941586159635336E-8L,
+    5.39030285815811905290E-15L
+};
+
+template<class T>
+constexpr const long double*
+pio2_split() noexcept
+{
+    return is_single_precision<T>::value ? pio2f_parts : pio2_parts;
+}
+
+//-------------------------------------------------------------------
+template<class P>
+using enable_if_vector_t = std::enable_if_t<(P::size() > 1)>;
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief e^x; results are clamped to [min, max] of the scalar type
+//-------------------------------------------------------------------
+template<class P, class = detail::enable_if_vector_t<P>>
+inline P
+exp(const P& x) noexcept
+{
+    using T = typename P::value_type;
+    using single = detail::is_single_precision<T>;
+
+    //e^lo = smallest normal, e^hi = largest finite number
+    const auto lo = single::value ? -87.3365447504L : -708.3964185322641L;
+    const auto hi = single::value ?  88.7228391116L :  709.7827128933840L;
+    //ln(2) = c1 + c2 with c1 having only a few mantissa bits
+    const auto c1 = single::value ? 0.693359375L : 6.93145751953125E-1L;
+    const auto c2 = single::value ? -2.12194440E-4L : 1.42860682030941723212E-6L;
+
+    const auto xc = min(max(x, P::broadcast(T(lo))), P::broadcast(T(hi)));
+    const auto k = detail::round_nearest(xc * P::broadcast(T(detail::log2e)));
+    auto r = mul_add(k, P::broadcast(T(-c1)), xc);
+    r = mul_add(k, P::broadcast(T(-c2)), r);
+
+    const auto y = detail::exp_reduced(r, single{});
+
+    //2^k in two steps so that both factors are normal numbers
+    const auto k1 = detail::round_nearest(
+        mul_add(k, P::broadcast(T(0.5)), P::broadcast(T(-0.25))));
+    return ldexp(ldexp(y, k1), k - k1);
+}
+
+//---------------------------------------------------------
+/// @brief natural logarithm for positive normal x
+template<class P, class = detail::enable_if_vector_t<P>>
+inline P
+log(const P& x) noexcept
+{
+    using T = typename P::value_type;
+    using single = detail::is_single_precision<T>;
+
+    const auto one = P::broadcast(T(1));
+    //ln(2) = c1 + c2
+    const auto c1 = 0.693359375L;
+    const auto c2 = single::value ? -2.12194440E-4L : -2.121944400546905827679E-4L;
+
+    auto e = P::broadcast(T(0));
+    const auto m = frexp(x, &e);
+    //x = (1+f) 2^e with sqrt(1/2) <= 1+f < sqrt(2); exact
+    const auto c = one - detail::step(m - P::broadcast(T(detail::sqrt_half)));
+    const auto f = mul_add(m, c, m) - one;
+    e = e - c;
+
+    const auto ff = f*f;
+    auto y = detail::log_reduced(f, ff, single{});
+    y = mul_add(e, P::broadcast(T(c2)), y);
+    y = mul_add(ff, P::broadcast(T(-0.5)), y);
+    return mul_add(e, P::broadcast(T(c1)), f + y);
+}
+
+//---------------------------------------------------------
+/// @brief sin(x) and cos(x) with shared argument reduction;
+///        accurate for |x| up to about 1e4 (float) or 1e9 (double)
+template<class P, class = detail::enable_if_vector_t<P>>
+inline void
+sincos(const P& x, P* s, P* c) noexcept
+{
+    using T = typename P::value_type;
+    using single = detail::is_single_precision<T>;
+
+    const auto one = P::broadcast(T(1));
+    const auto two = P::broadcast(T(2));
+    const auto dp = detail::pio2_split<T>();
+
+    //x = k pi/2 + r, |r| <= pi/4
+    const auto k = detail::round_nearest(x * P::broadcast(T(detail::two_div_pi)));
+    auto r = mul_add(k, P::broadcast(T(-dp[0])), x);
+    r = mul_add(k, P::broadcast(T(-dp[1])), r);
+    r = mul_add(k, P::broadcast(T(-dp[2])), r);
+
+    P sr, cr;
+    detail::sincos_reduced(r, &sr, &cr, single{});
+
+    //quadrant q = k mod 4 = 2b + a; a,b in {0,1}
+    const auto q = k - P::broadcast(T(4)) * detail::round_nearest(
+        mul_add(k, P::broadcast(T(0.25)), P::broadcast(T(-0.375))));
+    const auto a = q - two * detail::round_nearest(
+        mul_add(q, P::broadcast(T(0.5)), P::broadcast(T(-0.25))));
+    const auto sb = one - (q - a);   // 1-2b
+
+    *s = sb * mul_add(a, cr - sr, sr);
+    *c = sb * mul_add(a, -(sr + cr), cr);
+}
+
+//---------------------------------------------------------
+template<class P, class = detail::enable_if_vector_t<P>>
+inline P
+sin(const P& x) noexcept
+{
+    P s, c;
+    sincos(x, &s, &c);
+    return s;
+}
+
+//---------------------------------------------------------
+template<class P, class = detail::enable_if_vector_t<P>>
+inline P
+cos(const P& x) noexcept
+{
+    P s, c;
+    sincos(x, &s, &c);
+    return c;
+}
+
+//---------------------------------------------------------
+/// @brief error function
+/// @details all three of Cody's ranges are evaluated (each with its
+///          argument clamped to the range) and blended
+template<class P, class = detail::enable_if_vector_t<P>>
+inline P
+erf(const P& x) noexcept
+{
+    using T = typename P::value_type;
+
+    const auto one = P::broadcast(T(1));
+    const auto t1 = P::broadcast(T(0.46875));
+    const auto t2 = P::broadcast(T(4));
+    const auto ax = abs(x);
+
+    const auto xs = min(ax, t1);
+    const auto ys = xs*xs;
+    const auto rs = xs * detail::horner<5>(ys, detail::erf_small_p) /
+                         detail::horner<5>(ys, detail::erf_small_q);
+
+    const auto xm = min(max(ax, t1), t2);
+    const auto rm = exp(-xm*xm) * detail::horner<9>(xm, detail::erfc_mid_p) /
+                                  detail::horner<9>(xm, detail::erfc_mid_q);
+
+    const auto xl = max(ax, t2);
+    const auto z = one / (xl*xl);
+    const auto rl = exp(-xl*xl) / xl *
+        (P::broadcast(T(detail::rsqrt_pi)) - z *
+            detail::horner<6>(z, detail::erfc_large_p) /
+            detail::horner<6>(z, detail::erfc_large_q));
+
+    const auto rc = mul_add(detail::step(ax - t2), rl - rm, rm);
+    const auto r = mul_add(detail::step(ax - t1), (one - rc) - rs, rs);
+    return copysign(r, x);
+}
+
+
+//-------------------------------------------------------------------
+// 1-lane fallbacks
+//-------------------------------------------------------------------
+template<class T>
+inline pack<T,1> exp(pack<T,1> x) noexcept { return {std::exp(x.v)}; }
+template<class T>
+inline pack<T,1> log(pack<T,1> x) noexcept { return {std::log(x.v)}; }
+template<class T>
+inline pack<T,1> sin(pack<T,1> x) noexcept { return {std::sin(x.v)}; }
+template<class T>
+inline pack<T,1> cos(pack<T,1> x) noexcept { return {std::cos(x.v)}; }
+template<class T>
+inline pack<T,1> erf(pack<T,1> x) noexcept { return {std::erf(x.v)}; }
+template<class T>
+inline void
+sincos(pack<T,1> x, pack<T,1>* s, pack<T,1>* c) noexcept
+{
+    s->v = std::sin(x.v);
+    c->v = std::cos(x.v);
+}
+
+}  // namespace simd
+}  // namespace num
+}  // namespace am
@@ -0,0 +1,327 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "jacobian.h"
+
+
+namespace am {
+namespace num {
+
+
+/*************************************************************************//***
+ *
+ * @brief  structure of a sparse rows x cols matrix in CSR layout
+ *         (compressed sparse rows, column indices sorted within each row)
+ *
+ *****************************************************************************/
+class sparsity_pattern
+{
+public:
+    //---------------------------------------------------------------
+    using size_type = std::size_t;
+
+
+    //---------------------------------------------------------------
+    sparsity_pattern() = default;
+
+    //-----------------------------------------------------
+    /// @brief from CSR arrays;
+    ///        rowOffsets.size() must be rows+1,
+    ///        row i has the column indices [rowOffsets[i], rowOffsets[i+1])
+    sparsity_pattern(size_type rows, size_type cols,
+                     std::vector<size_type> rowOffsets,
+                     std::vector<size_type> colIndices)
+    :
+        rows_{rows}, cols_{cols},
+        offsets_(std::move(rowOffsets)), indices_(std::move(colIndices))
+    {
+        assert(offsets_.size() == rows_ + 1);
+        assert(offsets_.back() == indices_.size());
+        for(size_type i = 0; i < rows_; ++i) {
+            std::sort(indices_.begin() + std::ptrdiff_t(offsets_[i]),
+                      indices_.begin() + std::ptrdiff_t(offsets_[i+1]));
+        }
+        assert(std::all_of(indices_.begin(), indices_.end(),
+                           [&](size_type j) { return j < cols_; }));
+    }
+
+    //-----------------------------------------------------
+    /// @brief from (row,column) coordinates; duplicates are removed
+    sparsity_pattern(size_type rows, size_type cols,
+                     std::vector<std::pair<size_type,size_type>> entries)
+    :
+        rows_{rows}, cols_{cols}, offsets_(rows+1, 0), indices_{}
+    {
+        std::sort(entries.begin(), entries.end());
+        entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+        indices_.reserve(entries.size());
+        for(const auto& e : entries) {
+            assert(e.first < rows_ && e.second < cols_);
+            ++offsets_[e.first + 1];
+            indices_.push_back(e.second);
+        }
+        for(size_type i = 0; i < rows_; ++i) offsets_[i+1] += offsets_[i];
+    }
+
+
+    //---------------------------------------------------------------
+    size_type rows() const noexcept { return rows_; }
+    size_type cols() const noexcept { return cols_; }
+
+    size_type nonzeros() const noexcept { return indices_.size(); }
+
+    const std::vector<size_type>&
+    row_offsets() const noexcept { return offsets_; }
+
+    const std::vector<size_type>&
+    col_indices() const noexcept { return indices_; }
+
+
+private:
+    //---------------------------------------------------------------
+    size_type rows_ = 0;
+    size_type cols_ = 0;
+    std::vector<size_type> offsets_ = std::vector<size_type>(1, 0);
+    std::vector<size_type> indices_;
+};
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  partition of the columns of a sparsity pattern into groups
+ *         of structurally orthogonal columns (no two columns of the same
+ *         color have a nonzero in the same row)
+ *
+ *****************************************************************************/
+class column_coloring
+{
+public:
+    //---------------------------------------------------------------
+    using size_type = std::size_t;
+
+
+    //---------------------------------------------------------------
+    column_coloring() = default;
+
+    explicit
+    column_coloring(std::vector<size_type> colors):
+        colors_(std::move(colors)),
+        numColors_{colors_.empty() ? 0 :
+            (*std::max_element(colors_.begin(), colors_.end()) + 1)}
+    {}
+
+
+    //---------------------------------------------------------------
+    size_type num_colors() const noexcept { return numColors_; }
+    size_type size() const noexcept { return colors_.size(); }
+
+    size_type operator [] (size_type col) const noexcept {
+        return colors_[col];
+    }
+
+    const std::vector<size_type>&
+    colors() const noexcept { return colors_; }
+
+
+private:
+    //---------------------------------------------------------------
+    std::vector<size_type> colors_;
+    size_type numColors_ = 0;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * COLORING
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief greedy distance-2 coloring of the column intersection graph
+///        (columns are adjacent if they share a row);
+///        columns are visited in order of decreasing number of nonzeros
+///        (largest first), each gets the smallest color not used by
+///        any column it shares a row with
+inline column_coloring
+color_columns(const sparsity_pattern& p)
+{
+    using size_type = std::size_t;
+
+    const auto rows = p.rows();
+    const auto cols = p.cols();
+    const auto& rowOffs = p.row_offsets();
+    const auto& rowCols = p.col_indices();
+
+    //transpose: rows of each column (CSC)
+    std::vector<size_type> colOffs(cols+1, 0);
+    for(auto j : rowCols) ++colOffs[j+1];
+    for(size_type j = 0; j < cols; ++j) colOffs[j+1] += colOffs[j];
+
+    std::vector<size_type> colRows(rowCols.size());
+    {
+        auto pos = colOffs;
+        for(size_type i = 0; i < rows; ++i) {
+            for(auto k = rowOffs[i]; k < rowOffs[i+1]; ++k) {
+                colRows[pos[rowCols[k]]++] = i;
+            }
+        }
+    }
+
+    //largest first ordering
+    std::vector<size_type> order(cols);
+    for(size_type j = 0; j < cols; ++j) order[j] = j;
+    std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+        return (colOffs[a+1] - colOffs[a]) > (colOffs[b+1] - colOffs[b]);
+    });
+
+    constexpr auto none = size_type(-1);
+    std::vector<size_type> color(cols, none);
+    //forbidden[c] == j+1 <=> color c is taken by a neighbor of column j
+    std::vector<size_type> forbidden;
+    forbidden.reserve(64);
+
+    for(auto j : order) {
+        for(auto k = colOffs[j]; k < colOffs[j+1]; ++k) {
+            const auto i = colRows[k];
+            for(auto l = rowOffs[i]; l < rowOffs[i+1]; ++l) {
+                const auto c = color[rowCols[l]];
+                if(c != none) forbidden[c] = j + 1;
+            }
+        }
+        size_type c = 0;
+        while(c < forbidden.size() && forbidden[c] == j + 1) ++c;
+        if(c == forbidden.size()) forbidden.push_back(0);
+        color[j] = c;
+    }
+
+    return column_coloring{std::move(color)};
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * COMPRESSED JACOBIAN EVALUATION
+ *
+ * @details all columns with the same color are seeded in the same
+ *          tangent direction, so that one evaluation of f yields all of
+ *          them; Lanes colors are processed per evaluation, i.e.
+ *          num_colors / Lanes evaluations instead of n / Lanes
+ *
+ *****************************************************************************/
+namespace detail {
+
+template<std::size_t Lanes, class F, class T>
+inline void
+sparse_jacobian(F& f, const sparsity_pattern& p, const column_coloring& coloring,
+                const T* x, T* fx, T* values, std::size_t numThreads)
+{
+    static_assert(Lanes > 0, "sparse_jacobian: Lanes must be positive");
+    assert(coloring.size() == p.cols());
+
+    using num_t = jacobian_number<T,Lanes>;
+    using d_t   = typename num_t::type;
+    using buf_t = std::vector<d_t,simd::aligned_allocator<d_t>>;
+
+    const auto n = p.cols();
+    const auto m = p.rows();
+    const auto& offs = p.row_offsets();
+    const auto& cols = p.col_indices();
+    const auto& color = coloring.colors();
+
+    //at least one evaluation (for the function values)
+    const auto numBatches = std::max(std::size_t(1),
+        (coloring.num_colors() + Lanes - 1) / Lanes);
+
+    parallel_for_dynamic(numBatches, numThreads, 1, [&] {
+        //per-thread scratch
+        return [&,in = buf_t(n), out = buf_t(m)]
+            (std::size_t bb, std::size_t be) mutable
+        {
+            for(auto batch = bb; batch < be; ++batch) {
+                const auto b = batch * Lanes;
+                const auto e = b + Lanes;
+
+                for(std::size_t j = 0; j < n; ++j) {
+                    const auto c = color[j];
+                    in[j] = (c >= b && c < e) ? num_t::seeded(x[j], c - b)
+                                              : num_t::constant(x[j]);
+                }
+
+                f(static_cast<const d_t*>(in.data()), out.data());
+
+                //decompression
+                for(std::size_t i = 0; i < m; ++i) {
+                    for(auto k = offs[i]; k < offs[i+1]; ++k) {
+                        const auto c = color[cols[k]];
+                        if(c >= b && c < e) {
+                            values[k] = num_t::tangent(out[i], c - b);
+                        }
+                    }
+                }
+                if(fx && b == 0) {
+                    for(std::size_t i = 0; i < m; ++i) fx[i] = out[i].real();
+                }
+            }
+        };
+    });
+}
+
+}  // namespace detail
+
+
+
+//-------------------------------------------------------------------
+/// @brief sparse Jacobian of f: R^n -> R^m at x with known sparsity
+///        pattern p (m x n) and a column coloring of p
+///        (see jacobian.h for the requirements on f)
+/// @param values  CSR values (size p.nonzeros()) in the order of
+///                p.col_indices(): values[k] = dy_i / dx_j for the k-th
+///                nonzero (i,j)
+/// @param numThreads  1 = run on calling thread, 0 = all hardware threads
+template<std::size_t Lanes = 8, class F, class T>
+inline void
+sparse_jacobian(F&& f, const sparsity_pattern& p,
+                const column_coloring& coloring,
+                const T* x, T* values, std::size_t numThreads = 1)
+{
+    detail::sparse_jacobian<Lanes>(f, p, coloring, x,
+        static_cast<T*>(nullptr), values, numThreads);
+}
+
+//---------------------------------------------------------
+/// @brief additionally returns the function values fx = f(x) (size m)
+template<std::size_t Lanes = 8, class F, class T>
+inline void
+value_and_sparse_jacobian(F&& f, const sparsity_pattern& p,
+                          const column_coloring& coloring,
+                          const T* x, T* fx, T* values,
+                          std::size_t numThreads = 1)
+{
+    detail::sparse_jacobian<Lanes>(f, p, coloring, x, fx, values, numThreads);
+}
+
+
+}  // namespace num
+}  // namespace am
@@ -10,8 +10,11 @@
 
 #pragma once
 
+#include <cassert>
+
 #include "quaternion.h"
 #include "scomplex.h"
+#include "scomplex_diag.h"
 
 
 namespace am {
@@ -32,6 +35,18 @@ using split_biquat  = split_biquaternion<real_t>;
 
 
 
+//-------------------------------------------------------------------
+/// @brief split biquaternion with components in the null basis
+///        (see scomplex_diag); products need half the multiplications
+template<class T>
+using split_biquaternion_diag = quaternion<scomplex_diag<T>>;
+
+using split_biquat_diagf = split_biquaternion_diag<float>;
+using split_biquat_diagd = split_biquaternion_diag<double>;
+using split_biquat_diag  = split_biquaternion_diag<real_t>;
+
+
+
 
 /*****************************************************************************
  *
@@ -158,6 +173,65 @@ make_split_biquaternion(const quaternion<T>& q)
 }
 
 
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+make_split_biquaternion(const split_biquaternion_diag<T>& q)
+{
+    return split_biquaternion<T>{
+            make_scomplex(q.real()),
+            make_scomplex(q.imag_i()),
+            make_scomplex(q.imag_j()),
+            make_scomplex(q.imag_k())
+        };
+}
+
+//---------------------------------------------------------
+template<class T>
+inline constexpr auto
+make_split_biquaternion_diag(const split_biquaternion<T>& q)
+{
+    return split_biquaternion_diag<T>{
+            make_scomplex_diag(q.real()),
+            make_scomplex_diag(q.imag_i()),
+            make_scomplex_diag(q.imag_j()),
+            make_scomplex_diag(q.imag_k())
+        };
+}
+
+
+
+
+/*****************************************************************************
+ *
+ * INTEGER POWERS
+ *
+ *****************************************************************************/
+template<class T>
+inline split_biquaternion_diag<T>
+pow(split_biquaternion_diag<T> q, int n)
+{
+    assert(n >= 0);
+
+    auto r = split_biquaternion_diag<T>{};
+    while(n > 0) {
+        if(n & 1) r *= q;
+        n >>= 1;
+        if(n > 0) q = q * q;
+    }
+    return r;
+}
+
+//---------------------------------------------------------
+/// @brief q^n; squarings are done in the null basis
+template<class T>
+inline split_biquaternion<T>
+pow(const split_biquaternion<T>& q, int n)
+{
+    return make_split_biquaternion(pow(make_split_biquaternion_diag(q), n));
+}
+
+
 }  // namespace num
 }  // namespace am
 
@@ -260,6 +260,12 @@ struct common_numeric_type<T2,std::complex<T>>
     using type = common_numeric_t<std::complex<T>,T2>;
 };
 
+template<class T1, class T2>
+struct common_numeric_type<std::complex<T1>,std::complex<T2>>
+{
+    using type = std::complex<common_numeric_t<T1,T2>>;
+};
+
 
 
 
@@ -0,0 +1,572 @@
+/*****************************************************************************
+ *
+ * AM numeric facilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define AM_NUMERIC_HAS_MMAP
+#endif
+
+#include "quaternion_array.h"
+#include "dual_quaternion.h"
+
+
+namespace am {
+namespace num {
+
+
+/*****************************************************************************
+ *
+ * TRAJECTORY FILE FORMAT
+ *
+ * @details binary, native byte order; all sections start at offsets
+ *          that are multiples of 64 bytes:
+ *
+ *            header       64 bytes (see trajectory_header)
+ *            timestamps   double[count], ascending
+ *            lanes        quaternions:      w, x, y, z
+ *                         dual quaternions: w, x, y, z (real part),
+ *                                           w, x, y, z (dual part)
+ *                         each lane: scalar[count], 'lane_stride' bytes apart
+ *
+ *          readers reject files with a different byte order,
+ *          scalar size or element kind and files with a newer version
+ *
+ *****************************************************************************/
+constexpr std::uint32_t trajectory_format_version = 1;
+
+
+//-------------------------------------------------------------------
+enum class trajectory_kind : std::uint32_t {
+    quaternion = 1, dual_quaternion = 2
+};
+
+
+//-------------------------------------------------------------------
+struct trajectory_header
+{
+    char          magic[8];      ///< "AMTRAJ\0\0"
+    std::uint32_t version;
+    std::uint32_t byte_order;    ///< 0x01020304 as written by the producer
+    std::uint32_t kind;          ///< trajectory_kind
+    std::uint32_t scalar_size;   ///< bytes per scalar
+    std::uint64_t count;         ///< number of samples
+    std::uint64_t time_offset;   ///< byte offset of the timestamps
+    std::uint64_t lane_offset;   ///< byte offset of the first lane
+    std::uint64_t lane_stride;   ///< bytes from one lane to the next
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(trajectory_header) == 64,
+    "trajectory_header: unexpected padding");
+
+
+//-------------------------------------------------------------------
+class trajectory_error :
+    public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+
+
+
+/*****************************************************************************
+ *
+ * IMPLEMENTATION DETAILS
+ *
+ *****************************************************************************/
+namespace detail {
+
+constexpr char trajectory_magic[8] = {'A','M','T','R','A','J','\0','\0'};
+
+constexpr std::uint32_t trajectory_byte_order = 0x01020304u;
+
+
+//-------------------------------------------------------------------
+inline constexpr std::uint64_t
+align64(std::uint64_t x) noexcept
+{
+    return (x + 63) & ~std::uint64_t(63);
+}
+
+
+//-------------------------------------------------------------------
+template<class Q>
+struct trajectory_traits;
+
+template<class T>
+struct trajectory_traits<quaternion<T>>
+{
+    using numeric_type = T;
+    static constexpr auto kind = trajectory_kind::quaternion;
+    static constexpr int lanes = 4;
+};
+
+template<class T>
+struct trajectory_traits<quaternion<dual<T>>>
+{
+    using numeric_type = T;
+    static constexpr auto kind = trajectory_kind::dual_quaternion;
+    static constexpr int lanes = 8;
+};
+
+
+//-------------------------------------------------------------------
+/// @brief writes header, timestamps and 'numLanes' lanes;
+///        writeLane(stream, l) must write exactly n scalars of lane l
+template<class T, class LaneWriter>
+inline void
+write_trajectory_file(const std::string& filename, trajectory_kind kind,
+                      int numLanes, std::size_t n, const double* time,
+                      LaneWriter&& writeLane)
+{
+    if(!std::is_sorted(time, time + n)) {
+        throw trajectory_error{"write_trajectory: timestamps are not sorted"};
+    }
+
+    trajectory_header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, trajectory_magic, sizeof(h.magic));
+    h.version     = trajectory_format_version;
+    h.byte_order  = trajectory_byte_order;
+    h.kind        = std::uint32_t(kind);
+    h.scalar_size = std::uint32_t(sizeof(T));
+    h.count       = n;
+    h.time_offset = align64(sizeof(h));
+    h.lane_offset = align64(h.time_offset + n * sizeof(double));
+    h.lane_stride = align64(n * sizeof(T));
+
+    std::ofstream os{filename, std::ios::binary | std::ios::trunc};
+    if(!os) {
+        throw trajectory_error{"write_trajectory: can't open " + filename};
+    }
+
+    const char zeros[64] = {};
+    auto pos = std::uint64_t(0);
+    const auto pad_to = [&](std::uint64_t offset) {
+        os.write(zeros, std::streamsize(offset - pos));
+        pos = offset;
+    };
+
+    os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    pos = sizeof(h);
+
+    pad_to(h.time_offset);
+    os.write(reinterpret_cast<const char*>(time),
+             std::streamsize(n * sizeof(double)));
+    pos += n * sizeof(double);
+
+    for(int l = 0; l < numLanes; ++l) {
+        pad_to(h.lane_offset + std::uint64_t(l) * h.lane_stride);
+        writeLane(os, l);
+        pos += n * sizeof(T);
+    }
+
+    if(!os) {
+        throw trajectory_error{"write_trajectory: can't write " + filename};
+    }
+}
+
+
+//---------------------------------------------------------
+template<class T>
+inline void
+write_lane(std::ostream& os, const T* p, std::size_t n)
+{
+    os.write(reinterpret_cast<const char*>(p), std::streamsize(n * sizeof(T)));
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief read-only view of a whole file; memory-mapped where available,
+ *        otherwise read into a 64-byte aligned buffer
+ *
+ *****************************************************************************/
+class mapped_file
+{
+public:
+    //---------------------------------------------------------------
+    explicit
+    mapped_file(const std::string& filename)
+    {
+#if defined(AM_NUMERIC_HAS_MMAP)
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw trajectory_error{"trajectory_reader: can't open " + filename};
+        }
+        struct stat st;
+        if(::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw trajectory_error{"trajectory_reader: can't stat " + filename};
+        }
+        size_ = std::size_t(st.st_size);
+        if(size_ > 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if(p == MAP_FAILED) {
+                ::close(fd);
+                throw trajectory_error{"trajectory_reader: can't map " + filename};
+            }
+            data_ = static_cast<const char*>(p);
+        }
+        ::close(fd);
+#else
+        std::ifstream is{filename, std::ios::binary | std::ios::ate};
+        if(!is) {
+            throw trajectory_error{"trajectory_reader: can't open " + filename};
+        }
+        size_ = std::size_t(is.tellg());
+        buffer_.resize(size_);
+        is.seekg(0);
+        is.read(buffer_.data(), std::streamsize(size_));
+        if(!is) {
+            throw trajectory_error{"trajectory_reader: can't read " + filename};
+        }
+        data_ = buffer_.data();
+#endif
+    }
+
+    //-----------------------------------------------------
+    mapped_file(mapped_file&& src) noexcept :
+        data_{src.data_}, size_{src.size_}
+#if !defined(AM_NUMERIC_HAS_MMAP)
+        , buffer_{std::move(src.buffer_)}
+#endif
+    {
+        src.data_ = nullptr;
+        src.size_ = 0;
+    }
+
+    //-----------------------------------------------------
+    mapped_file&
+    operator = (mapped_file&& src) noexcept {
+        std::swap(data_, src.data_);
+        std::swap(size_, src.size_);
+#if !defined(AM_NUMERIC_HAS_MMAP)
+        std::swap(buffer_, src.buffer_);
+#endif
+        return *this;
+    }
+
+    //-----------------------------------------------------
+    ~mapped_file() {
+#if defined(AM_NUMERIC_HAS_MMAP)
+        if(data_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+
+    //---------------------------------------------------------------
+    const char*
+    data() const noexcept {
+        return data_;
+    }
+    //-----------------------------------------------------
+    std::size_t
+    size() const noexcept {
+        return size_;
+    }
+
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !defined(AM_NUMERIC_HAS_MMAP)
+    std::vector<char,simd::aligned_allocator<char>> buffer_;
+#endif
+};
+
+}  // namespace detail
+
+
+
+
+/*****************************************************************************
+ *
+ * WRITING
+ *
+ *****************************************************************************/
+
+//-------------------------------------------------------------------
+/// @brief writes n quaternion samples (SoA lanes) with timestamps
+/// @param time  ascending timestamps
+/// @throws trajectory_error
+//-------------------------------------------------------------------
+template<class T>
+inline void
+write_trajectory(const std::string& filename, std::size_t n,
+                 const double* time, const quaternion_lanes<const T>& q)
+{
+    const T* lanes[4] = {q.w, q.x, q.y, q.z};
+
+    detail::write_trajectory_file<T>(filename, trajectory_kind::quaternion,
+        4, n, time, [&](std::ostream& os, int l) {
+            detail::write_lane(os, lanes[l], n);
+        });
+}
+
+//---------------------------------------------------------
+template<class T>
+inline void
+write_trajectory(const std::string& filename,
+                 const double* time, const quaternion_array<T>& q)
+{
+    write_trajectory(filename, q.size(), time, q.lanes());
+}
+
+
+//-------------------------------------------------------------------
+/// @brief writes n dual quaternion samples (SoA lanes of real and dual
+///        parts) with timestamps
+/// @param time  ascending timestamps
+/// @throws trajectory_error
+//-------------------------------------------------------------------
+template<class T>
+inline void
+write_trajectory(const std::string& filename, std::size_t n,
+                 const double* time,
+                 const quaternion_lanes<const T>& real,
+                 const quaternion_lanes<const T>& dual)
+{
+    const T* lanes[8] = {real.w, real.x, real.y, real.z,
+                         dual.w, dual.x, dual.y, dual.z};
+
+    detail::write_trajectory_file<T>(filename, trajectory_kind::dual_quaternion,
+        8, n, time, [&](std::ostream& os, int l) {
+            detail::write_lane(os, lanes[l], n);
+        });
+}
+
+//---------------------------------------------------------
+/// @brief writes dual quaternions q[0,n) (array of structures)
+template<class T>
+inline void
+write_trajectory(const std::string& filename, std::size_t n,
+                 const double* time, const dual_quaternion<T>* q)
+{
+    detail::write_trajectory_file<T>(filename, trajectory_kind::dual_quaternion,
+        8, n, time, [&](std::ostream& os, int l) {
+            //gather one lane in blocks
+            constexpr std::size_t bs = 256;
+            T buf[bs];
+            for(std::size_t b = 0; b < n; b += bs) {
+                const auto m = std::min(bs, n - b);
+                for(std::size_t j = 0; j < m; ++j) {
+                    const auto& x = q[b+j];
+                    const auto& c = (l % 4 == 0) ? x.real()   :
+                                    (l % 4 == 1) ? x.imag_i() :
+                                    (l % 4 == 2) ? x.imag_j() : x.imag_k();
+                    buf[j] = (l < 4) ? c.real() : c.imag();
+                }
+                detail::write_lane(os, buf, m);
+            }
+        });
+}
+
+
+
+
+/*************************************************************************//***
+ *
+ * @brief  zero-copy reader for trajectory files
+ *
+ * @tparam Q  quaternion<T> or dual_quaternion<T>
+ *
+ * @details the file is memory-mapped; timestamps and lanes are
+ *          accessed in place, samples are assembled on access;
+ *          lookup by timestamp is a binary search over the mapped
+ *          timestamps
+ *
+ *****************************************************************************/
+template<class Q>
+class trajectory_reader
+{
+    using traits_t = detail::trajectory_traits<Q>;
+
+public:
+    //---------------------------------------------------------------
+    using value_type   = Q;
+    using numeric_type = typename traits_t::numeric_type;
+    using size_type    = std::size_t;
+
+
+    //---------------------------------------------------------------
+    /// @throws trajectory_error if the file can't be mapped or has an
+    ///         incompatible format
+    explicit
+    trajectory_reader(const std::string& filename) :
+        file_{filename}
+    {
+        if(file_.size() < sizeof(trajectory_header)) {
+            throw trajectory_error{"trajectory_reader: file too small"};
+        }
+        std::memcpy(&header_, file_.data(), sizeof(header_));
+
+        const auto& h = header_;
+        if(std::memcmp(h.magic, detail::trajectory_magic, sizeof(h.magic)) != 0) {
+            throw trajectory_error{"trajectory_reader: not a trajectory file"};
+        }
+        if(h.version > trajectory_format_version) {
+            throw trajectory_error{"trajectory_reader: unsupported version"};
+        }
+        if(h.byte_order != detail::trajectory_byte_order) {
+            throw trajectory_error{"trajectory_reader: wrong byte order"};
+        }
+        if(h.kind != std::uint32_t(traits_t::kind) ||
+           h.scalar_size != sizeof(numeric_type))
+        {
+            throw trajectory_error{"trajectory_reader: wrong element type"};
+        }
+        //divisions first, so that crafted sizes can't wrap around
+        const std::uint64_t size = file_.size();
+        if(h.time_offset % alignof(double) != 0 ||
+           h.lane_offset % alignof(numeric_type) != 0 ||
+           h.lane_stride % alignof(numeric_type) != 0 ||
+           h.time_offset > size || h.lane_offset > size ||
+           h.count > (size - h.time_offset) / sizeof(double) ||
+           h.count > (size - h.lane_offset) / sizeof(numeric_type))
+        {
+            throw trajectory_error{"trajectory_reader: corrupt file"};
+        }
+        const auto laneBytes = h.count * sizeof(numeric_type);
+        if(h.lane_stride < laneBytes ||
+           h.lane_stride > (size - h.lane_offset - laneBytes) /
+                           std::uint64_t(traits_t::lanes - 1))
+        {
+            throw trajectory_error{"trajectory_reader: corrupt file"};
+        }
+
+        time_ = reinterpret_cast<const double*>(file_.data() + h.time_offset);
+        for(int l = 0; l < traits_t::lanes; ++l) {
+            lanes_[l] = reinterpret_cast<const numeric_type*>(
+                file_.data() + h.lane_offset + std::uint64_t(l) * h.lane_stride);
+        }
+    }
+
+
+    //---------------------------------------------------------------
+    size_type
+    size() const noexcept {
+        return size_type(header_.count);
+    }
+    //-----------------------------------------------------
+    bool
+    empty() const noexcept {
+        return header_.count == 0;
+    }
+    //-----------------------------------------------------
+    std::uint32_t
+    version() const noexcept {
+        return header_.version;
+    }
+
+
+    //---------------------------------------------------------------
+    const double*
+    times() const noexcept {
+        return time_;
+    }
+    //-----------------------------------------------------
+    double
+    time(size_type i) const noexcept {
+        return time_[i];
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief lanes of the quaternions (of the real parts for
+    ///        dual quaternions)
+    quaternion_lanes<const numeric_type>
+    lanes() const noexcept {
+        return {lanes_[0], lanes_[1], lanes_[2], lanes_[3]};
+    }
+    //-----------------------------------------------------
+    /// @brief lanes of the dual parts (dual quaternions only)
+    template<class P = Q, class = std::enable_if_t<
+        traits_t::kind == trajectory_kind::dual_quaternion && sizeof(P) != 0>>
+    quaternion_lanes<const numeric_type>
+    dual_lanes() const noexcept {
+        return {lanes_[4], lanes_[5], lanes_[6], lanes_[7]};
+    }
+
+
+    //---------------------------------------------------------------
+    value_type
+    operator [] (size_type i) const noexcept {
+        return make(i, std::integral_constant<trajectory_kind,traits_t::kind>{});
+    }
+
+
+    //---------------------------------------------------------------
+    /// @brief index of the first sample with time >= t (size() if none)
+    size_type
+    lower_bound(double t) const noexcept {
+        return size_type(std::lower_bound(time_, time_ + size(), t) - time_);
+    }
+    //-----------------------------------------------------
+    /// @brief index of the last sample with time <= t
+    ///        (0 if t precedes all samples)
+    size_type
+    index_at(double t) const noexcept {
+        const auto i = size_type(std::upper_bound(time_, time_ + size(), t) - time_);
+        return (i > 0) ? i - 1 : 0;
+    }
+
+
+private:
+    //---------------------------------------------------------------
+    value_type
+    make(size_type i, std::integral_constant<trajectory_kind,
+                      trajectory_kind::quaternion>) const noexcept
+    {
+        return value_type{lanes_[0][i], lanes_[1][i], lanes_[2][i], lanes_[3][i]};
+    }
+    //-----------------------------------------------------
+    value_type
+    make(size_type i, std::integral_constant<trajectory_kind,
+                      trajectory_kind::dual_quaternion>) const noexcept
+    {
+        using d_t = dual<numeric_type>;
+        return value_type{
+            d_t{lanes_[0][i], lanes_[4][i]}, d_t{lanes_[1][i], lanes_[5][i]},
+            d_t{lanes_[2][i], lanes_[6][i]}, d_t{lanes_[3][i], lanes_[7][i]} };
+    }
+
+
+    //---------------------------------------------------------------
+    detail::mapped_file file_;
+    trajectory_header header_;
+    const double* time_ = nullptr;
+    std::array<const numeric_type*,traits_t::lanes> lanes_ {};
+};
+
+
+}  // namespace num
+}  // namespace am
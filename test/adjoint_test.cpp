@@ -0,0 +1,181 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/adjoint.h"
+#include  "../include/hyper_dual.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief scalar function of 4 variables using all supported operations
+struct test_function
+{
+    template<class D>
+    D operator () (const D* v) const
+    {
+        using std::exp; using std::log; using std::sin; using std::cos;
+        using std::tan; using std::sqrt; using std::cbrt; using std::atan;
+        using std::asin; using std::acos; using std::sinh; using std::cosh;
+        using std::tanh; using std::asinh; using std::atanh; using std::erf;
+        using std::erfc; using std::exp2; using std::expm1; using std::log10;
+        using std::log2; using std::log1p; using std::pow; using std::atan2;
+        using std::acosh;
+
+        const auto& x = v[0]; const auto& y = v[1];
+        const auto& z = v[2]; const auto& w = v[3];
+
+        return sin(x) * exp(y) / z + cos(x * y) - tan(z) + sqrt(x + y) +
+               cbrt(z) * w + atan(x - z) + asin(x / 4) * acos(y / 4) +
+               sinh(y) - cosh(z) + tanh(x * w) + asinh(x * z) + atanh(y / 3) +
+               erf(x) - erfc(z) + exp2(y) + expm1(x) + log(z) * log10(y) +
+               log2(x + z) + log1p(w) + pow(x, y) * pow(w, 3) +
+               atan2(y, w) - 2 / (x + w) + 3 * w * w + acosh(z);
+    }
+};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    constexpr std::size_t n = 4;
+    const T x[n] = {T(0.7), T(1.3), T(2.1), T(0.4)};
+    const auto f = test_function{};
+
+    //reference: value, gradient and Hessian with hyper_dual_vec
+    using hv_t = hyper_dual_vec<T,n>;
+    hv_t hx[n];
+    for(std::size_t i = 0; i < n; ++i) hx[i] = hv_t{x[i], i};
+    const auto ref = f(hx);
+
+    //gradient in one reverse sweep
+    adjoint_tape<T> tape;
+    T g[n];
+    const auto fx = value_and_gradient(tape, f, n, x, g);
+    if(!rel_approx_equal(fx, ref.real()) || !tape.empty() || adjoint_tape<T>::active()) {
+        throw std::runtime_error{"adjoint: wrong value"};
+    }
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!rel_approx_equal(g[i], ref.gradient(i))) {
+            throw std::runtime_error{"adjoint: wrong gradient"};
+        }
+    }
+
+    //f throws: previously active tape restored, records discarded
+    {
+        adjoint_tape<T> outer;
+        outer.activate();
+        bool thrown = false;
+        try {
+            value_and_gradient(tape, [](const auto* p) {
+                    const auto y = p[0] * p[1];
+                    if(y.value() > T(0)) throw std::runtime_error{"f"};
+                    return y;
+                }, n, x, g);
+        }
+        catch(std::runtime_error&) { thrown = true; }
+        if(!thrown || adjoint_tape<T>::active() != &outer || !tape.empty()) {
+            throw std::runtime_error{"adjoint: tape not restored after exception"};
+        }
+        outer.deactivate();
+    }
+
+    //Hessian-vector product (forward-over-reverse)
+    adjoint_tape<dual<T>> dtape;
+    const T v[n] = {T(1), T(-2), T(0.5), T(3)};
+    T hv[n], g2[n];
+    hessian_vector_product(dtape, f, n, x, v, hv, g2);
+    for(std::size_t i = 0; i < n; ++i) {
+        T ex = T(0);
+        for(std::size_t j = 0; j < n; ++j) ex += ref.hessian(i,j) * v[j];
+        if(!rel_approx_equal(hv[i], ex) || !rel_approx_equal(g2[i], ref.gradient(i))) {
+            throw std::runtime_error{"adjoint: wrong Hessian-vector product"};
+        }
+    }
+
+    //checkpoint / rewind, passive operations
+    tape.activate();
+    const auto a = tape.variable(T(2));
+    const auto b = tape.variable(T(3));
+    const auto c = a * b;
+    const auto cp = tape.checkpoint();
+
+    const auto k = adjoint<T>{T(5)} * adjoint<T>{T(2)} + T(1);
+    if(k.is_active() || tape.checkpoint() != cp) {
+        throw std::runtime_error{"adjoint: passive operations recorded"};
+    }
+
+    auto d = c;
+    d *= a;
+    d += T(1);
+    tape.backward(d);
+    if(!rel_approx_equal(tape.derivative(a), T(2) * T(2) * T(3)) ||
+       !rel_approx_equal(tape.derivative(b), T(4)))
+    {
+        throw std::runtime_error{"adjoint: wrong derivative"};
+    }
+
+    //discard d's records and differentiate a different expression
+    tape.rewind(cp);
+    const auto e = c - abs(-b) / a + abs2(a) + pow(2, b) - pow(2, b);
+    tape.backward(e);
+    if(tape.size() != cp + 10 ||
+       !rel_approx_equal(tape.derivative(a), T(3) + T(3) / T(4) + T(4)) ||
+       !rel_approx_equal(tape.derivative(b), T(2) - T(1) / T(2)) ||
+       tape.derivative(k) != T(0))
+    {
+        throw std::runtime_error{"adjoint: checkpoint/rewind"};
+    }
+    tape.deactivate();
+
+    //forward-over-reverse with dual constants
+    dtape.activate();
+    const auto s = dtape.variable(dual<T>{T(2), T(1)});
+    auto t = s * dual<T>{T(3), T(0)};
+    t += dual<T>{T(1), T(0)};
+    dtape.backward(t * s);
+    //d/ds (3s^2 + s) = 6s + 1; directional second derivative 6
+    if(!rel_approx_equal(dtape.derivative(s).real(), T(13)) ||
+       !rel_approx_equal(dtape.derivative(s).imag(), T(6)))
+    {
+        throw std::runtime_error{"adjoint: dual constants"};
+    }
+    dtape.deactivate();
+
+    static_assert(is_number<adjoint<T>>::value, "");
+    static_assert(std::is_same<common_numeric_t<adjoint<T>,T>,adjoint<T>>::value, "");
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,252 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/dual_array.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief relative error within 'ulps' units of the last place
+template<class T>
+bool close(T a, T b, T ulps = T(8))
+{
+    using std::abs;
+    return abs(a - b) <= ulps * std::numeric_limits<T>::epsilon() * abs(b);
+}
+
+//---------------------------------------------------------
+template<class T>
+bool approx(const am::num::dual<T>& a, const am::num::dual<T>& b)
+{
+    using am::num::rel_approx_equal;
+    return rel_approx_equal(a.real(), b.real()) &&
+           rel_approx_equal(a.imag(), b.imag());
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_fused_scalar()
+{
+    using namespace am::num;
+
+    for(int i = -40; i <= 40; ++i) {
+        const auto x = dual<T>{T(i) / T(4), T(1.5)};
+
+        dual<T> s, c;
+        sincos(x, &s, &c);
+        if(!approx(s, dual<T>{std::sin(x.real()),  T(1.5) * std::cos(x.real())}) ||
+           !approx(c, dual<T>{std::cos(x.real()), -T(1.5) * std::sin(x.real())}) ||
+           !approx(sin(x), s) || !approx(cos(x), c))
+        {
+            throw std::runtime_error{"dual: fused sin/cos"};
+        }
+
+        const auto ch = std::cosh(x.real());
+        sinhcosh(x, &s, &c);
+        if(!approx(s, dual<T>{std::sinh(x.real()), T(1.5) * ch}) ||
+           !approx(c, dual<T>{ch, T(1.5) * std::sinh(x.real())}) ||
+           !approx(sinh(x), s) || !approx(cosh(x), c) ||
+           !approx(tanh(x), dual<T>{std::tanh(x.real()), T(1.5) / (ch*ch)}))
+        {
+            throw std::runtime_error{"dual: fused sinh/cosh"};
+        }
+    }
+
+    //no overflow / cancellation for large arguments
+    const auto t = tanh(dual<T>{T(50), T(1)});
+    const auto h = sinh(dual<T>{T(-50), T(1)});
+    if(t.real() != T(1) || !(t.imag() >= T(0)) || !(t.imag() < T(1e-30)) ||
+       !close(h.real(), std::sinh(T(-50)), T(4)) ||
+       !close(h.imag(), std::cosh(T(-50)), T(4)))
+    {
+        throw std::runtime_error{"dual: fused hyperbolic, large arguments"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_kernels()
+{
+    using namespace am::num;
+
+    //not a multiple of the pack width (tail handling)
+    constexpr std::size_t n = 203;
+
+    std::vector<T> xr(n), xd(n), yr(n), yd(n), zr(n), zd(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        xr[i] = T(-20) + T(40) * T(i) / T(n);
+        xd[i] = T(1) + T(i % 7) / T(3);
+    }
+    const auto x  = dual_lanes<const T>{xr.data(), xd.data()};
+    const auto y  = dual_lanes<T>{yr.data(), yd.data()};
+    const auto z  = dual_lanes<T>{zr.data(), zd.data()};
+    const auto at = [&](std::size_t i) { return dual<T>{xr[i], xd[i]}; };
+    const auto out = [&](std::size_t i) { return dual<T>{yr[i], yd[i]}; };
+
+    exp(n, x, y);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!close(yr[i], std::exp(xr[i])) || !approx(out(i), exp(at(i)))) {
+            throw std::runtime_error{"dual_array: exp"};
+        }
+    }
+
+    erf(n, x, y);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!close(yr[i], std::erf(xr[i])) || !approx(out(i), erf(at(i)))) {
+            throw std::runtime_error{"dual_array: erf"};
+        }
+    }
+    //close to zero and beyond Cody's range boundaries
+    {
+        const T v[] = {T(1e-20), T(-1e-3), T(0.3), T(0.46875), T(-0.5),
+                       T(1), T(2.5), T(-3.9), T(4), T(4.1), T(5.5), T(-9), T(30)};
+        const T one[] = {1,1,1,1,1,1,1,1,1,1,1,1,1};
+        constexpr std::size_t m = sizeof(v) / sizeof(T);
+        erf(m, dual_lanes<const T>{v, one}, y);
+        for(std::size_t i = 0; i < m; ++i) {
+            if(!close(yr[i], std::erf(v[i]))) {
+                throw std::runtime_error{"dual_array: erf at range boundaries"};
+            }
+        }
+    }
+
+    sin(n, x, y);
+    cos(n, x, z);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(out(i), sin(at(i))) ||
+           !approx(dual<T>{zr[i], zd[i]}, cos(at(i))) ||
+           !close(yr[i] + T(2), std::sin(xr[i]) + T(2), T(4)) ||
+           !close(zr[i] + T(2), std::cos(xr[i]) + T(2), T(4)))
+        {
+            throw std::runtime_error{"dual_array: sin/cos"};
+        }
+    }
+    //larger arguments
+    {
+        std::vector<T> lr(n), one(n, T(1));
+        for(std::size_t i = 0; i < n; ++i) lr[i] = T(-5000) + T(49.7) * T(i);
+        sincos(n, dual_lanes<const T>{lr.data(), one.data()}, y, z);
+        for(std::size_t i = 0; i < n; ++i) {
+            if(!close(yr[i] + T(2), std::sin(lr[i]) + T(2), T(16)) ||
+               !close(zr[i] + T(2), std::cos(lr[i]) + T(2), T(16)) ||
+               !close(yd[i] + T(2), zr[i] + T(2), T(0)) ||
+               !close(zd[i] - T(2), -yr[i] - T(2), T(0)))
+            {
+                throw std::runtime_error{"dual_array: sincos"};
+            }
+        }
+    }
+
+    //positive arguments; in-place
+    for(std::size_t i = 0; i < n; ++i) {
+        zr[i] = T(1e-3) + T(i) * T(i) / T(7);
+        zd[i] = xd[i];
+    }
+    const auto pz = dual_lanes<const T>{zr.data(), zd.data()};
+    const auto pos = [&](std::size_t i) { return dual<T>{zr[i], zd[i]}; };
+
+    log(n, pz, y);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!close(yr[i] + T(10), std::log(zr[i]) + T(10), T(4)) ||
+           !approx(out(i), log(pos(i))))
+        {
+            throw std::runtime_error{"dual_array: log"};
+        }
+    }
+    //near 1 and over the whole exponent range
+    {
+        const T v[] = {T(1), T(1) + std::numeric_limits<T>::epsilon(),
+                       T(1) - std::numeric_limits<T>::epsilon(), T(0.7071), T(1.4142),
+                       T(1e-30), T(3e30), std::numeric_limits<T>::min(),
+                       std::numeric_limits<T>::max()};
+        const T one[] = {1,1,1,1,1,1,1,1,1};
+        constexpr std::size_t m = sizeof(v) / sizeof(T);
+        log(m, dual_lanes<const T>{v, one}, y);
+        for(std::size_t i = 0; i < m; ++i) {
+            if(!(yr[i] == std::log(v[i]) || close(yr[i], std::log(v[i])))) {
+                throw std::runtime_error{"dual_array: log, special values"};
+            }
+        }
+    }
+
+    sqrt(n, pz, y);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(out(i), sqrt(pos(i)))) {
+            throw std::runtime_error{"dual_array: sqrt"};
+        }
+    }
+
+    pow(n, pz, T(1.75), y);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(out(i), pow(pos(i), T(1.75)))) {
+            throw std::runtime_error{"dual_array: pow"};
+        }
+    }
+
+    //output aliases input
+    for(std::size_t i = 0; i < n; ++i) zr[i] = T(i) / T(7);
+    exp(n, dual_lanes<const T>{zr.data(), zd.data()}, z);
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto v = T(i) / T(7);
+        if(!close(zr[i], std::exp(v)) || !close(zd[i], xd[i] * zr[i], T(1))) {
+            throw std::runtime_error{"dual_array: exp in-place"};
+        }
+    }
+
+    //multi-threaded
+    std::vector<T> br(100000), bd(100000, T(1)), cr(100000), cd(100000);
+    for(std::size_t i = 0; i < br.size(); ++i) br[i] = T(i % 1000) / T(100);
+    erf(br.size(), dual_lanes<const T>{br.data(), bd.data()},
+        dual_lanes<T>{cr.data(), cd.data()}, 4);
+    for(std::size_t i = 0; i < br.size(); ++i) {
+        if(!close(cr[i], std::erf(br[i]))) {
+            throw std::runtime_error{"dual_array: erf multi-threaded"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    test_fused_scalar<T>();
+    test_kernels<T>();
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/dual_quaternion_array.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    //not a multiple of the pack width (tail handling)
+    constexpr std::size_t n = 203;
+
+    std::mt19937 urng{4711};
+    auto dist = std::uniform_real_distribution<T>{T(-4), T(4)};
+
+    auto px = std::vector<T>(n), py = px, pz = px;
+    for(std::size_t i = 0; i < n; ++i) {
+        px[i] = dist(urng); py[i] = dist(urng); pz[i] = dist(urng);
+    }
+    const auto in = vector3_lanes<const T>{px.data(), py.data(), pz.data()};
+    const auto at = [&](std::size_t i) {
+        return std::array<T,3>{{px[i], py[i], pz[i]}};
+    };
+
+    //one transform for all points
+    const auto q = make_rigid_transform(random_unit_quaternion<T>(urng),
+        std::array<T,3>{{T(1), T(-2), T(0.5)}});
+
+    auto ox = std::vector<T>(n), oy = ox, oz = ox;
+    transform_points(q, n, in, vector3_lanes<T>{ox.data(), oy.data(), oz.data()});
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto r = transform(q, at(i));
+        if(!rel_approx_equal(ox[i], r[0]) || !rel_approx_equal(oy[i], r[1]) || !rel_approx_equal(oz[i], r[2])) {
+            throw std::runtime_error{"transform_points: single transform"};
+        }
+    }
+
+    //one transform per point
+    std::vector<T> l[8];
+    for(auto& v : l) v.resize(n);
+    auto qs = std::vector<dual_quaternion<T>>{};
+    for(std::size_t i = 0; i < n; ++i) {
+        qs.push_back(make_rigid_transform(random_unit_quaternion<T>(urng),
+            std::array<T,3>{{dist(urng), dist(urng), dist(urng)}}));
+        for(int k = 0; k < 8; ++k) l[k][i] = qs.back().data()[k];
+    }
+    const auto lq = dual_quaternion_lanes<const T>{
+        quaternion_lanes<const T>{l[0].data(), l[1].data(), l[2].data(), l[3].data()},
+        quaternion_lanes<const T>{l[4].data(), l[5].data(), l[6].data(), l[7].data()} };
+
+    transform_points(n, lq, in, vector3_lanes<T>{ox.data(), oy.data(), oz.data()});
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto r = transform(qs[i], at(i));
+        if(!rel_approx_equal(ox[i], r[0]) || !rel_approx_equal(oy[i], r[1]) || !rel_approx_equal(oz[i], r[2])) {
+            throw std::runtime_error{"transform_points: per-point transforms"};
+        }
+    }
+
+    //output aliases input; multi-threaded
+    {
+        constexpr std::size_t nl = 50000;
+        auto lx = std::vector<T>(nl), ly = lx, lz = lx;
+        for(std::size_t i = 0; i < nl; ++i) {
+            lx[i] = T(i % 11); ly[i] = T(1); lz[i] = T(i % 3);
+        }
+        transform_points(q, nl, vector3_lanes<const T>{lx.data(), ly.data(), lz.data()},
+                         vector3_lanes<T>{lx.data(), ly.data(), lz.data()}, 4);
+        for(std::size_t i = 0; i < nl; ++i) {
+            const auto r = transform(q, std::array<T,3>{{T(i % 11), T(1), T(i % 3)}});
+            if(!rel_approx_equal(lx[i], r[0]) || !rel_approx_equal(ly[i], r[1]) || !rel_approx_equal(lz[i], r[2])) {
+                throw std::runtime_error{"transform_points: in-place, multi-threaded"};
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/dual_quaternion_interpolation.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::dual_quaternion<T>& a, const am::num::dual_quaternion<T>& b)
+{
+    for(int k = 0; k < 8; ++k) {
+        if(!am::num::rel_approx_equal(a.data()[k], b.data()[k])) return false;
+    }
+    return true;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    const std::size_t n = 29;
+
+    std::mt19937 urng{4711};
+    auto dist = std::uniform_real_distribution<T>{T(0), T(1)};
+    const auto rigid = [&] {
+        return make_rigid_transform(random_unit_quaternion<T>(urng),
+            std::array<T,3>{{dist(urng), T(2) * dist(urng), -dist(urng)}});
+    };
+
+    std::vector<dual_quaternion<T>> from, to;
+    std::vector<T> ts;
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto a = rigid();
+        auto b = rigid();
+        //small angles
+        if(i % 5 == 0) b = a * make_rigid_transform(
+            normalized(quaternion<T>{T(1), T(0.0001), T(0), T(0)}),
+            std::array<T,3>{{T(0.1), T(0), T(0.2)}});
+        //pure translation
+        if(i % 6 == 0) b = a * make_rigid_transform(
+            quaternion<T>{}, std::array<T,3>{{T(0.5), T(-1), T(0)}});
+        //identical keys
+        if(i % 7 == 0) b = a;
+        //antipodal keys
+        if(i % 4 == 0) b = -b;
+        from.push_back(a);
+        to.push_back(b);
+        ts.push_back(dist(urng));
+    }
+
+    const auto table = sclerp_table<T>{from, to};
+    if(table.size() != n) throw std::runtime_error{"wrong sclerp table size"};
+
+    std::vector<T> l[8];
+    for(auto& v : l) v.resize(n);
+    const auto out = dual_quaternion_lanes<T>{
+        quaternion_lanes<T>{l[0].data(), l[1].data(), l[2].data(), l[3].data()},
+        quaternion_lanes<T>{l[4].data(), l[5].data(), l[6].data(), l[7].data()} };
+    const auto result = [&](std::size_t i) {
+        return make_dual_quaternion(l[0][i], l[1][i], l[2][i], l[3][i],
+                                    l[4][i], l[5][i], l[6][i], l[7][i]);
+    };
+
+    table.interpolate(ts.data(), out);
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto expected = sclerp(from[i], to[i], ts[i]);
+        if(!approx(result(i), expected)) throw std::runtime_error{"wrong batch sclerp"};
+        if(!approx(table(i, ts[i]), expected)) throw std::runtime_error{"wrong single sclerp"};
+    }
+
+    //end points
+    table.interpolate(T(0), out);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(result(i), from[i])) throw std::runtime_error{"wrong sclerp at t = 0"};
+    }
+    table.interpolate(T(1), out);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(result(i), to[i]) && !approx(result(i), -to[i])) {
+            throw std::runtime_error{"wrong sclerp at t = 1"};
+        }
+    }
+
+    //trajectory segments
+    auto seg = sclerp_table<T>{};
+    seg.assign_segments(from);
+    if(seg.size() != n - 1) throw std::runtime_error{"wrong number of segments"};
+    for(std::size_t i = 0; i + 1 < n; ++i) {
+        if(!approx(seg(i, T(0.3)), sclerp(from[i], from[i+1], T(0.3)))) {
+            throw std::runtime_error{"wrong segment sclerp"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,222 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/dual_quaternion_skinning.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief unit dual quaternion: rotation r followed by translation t
+template<class T>
+am::num::dual_quaternion<T>
+rigid(const am::num::quaternion<T>& r, T tx, T ty, T tz)
+{
+    using namespace am::num;
+    const auto d = T(0.5) * (quaternion<T>{T(0), tx, ty, tz} * r);
+    return make_dual(r, d);
+}
+
+//---------------------------------------------------------
+template<class T>
+am::num::dual_quaternion<T>
+antipode(const am::num::dual_quaternion<T>& q)
+{
+    using namespace am::num;
+    return make_dual(T(-1) * real(q), T(-1) * imag(q));
+}
+
+//---------------------------------------------------------
+/// @brief scalar reference: blend with sign flip, normalize, transform
+template<class T>
+std::array<T,3>
+reference(const std::vector<am::num::dual_quaternion<T>>& bones,
+          const std::uint32_t* idx, const T* wgt,
+          std::size_t stride, std::size_t count,
+          const std::array<T,3>& p, std::array<T,3>* nrm)
+{
+    using namespace am::num;
+
+    const auto pivot = real(bones[idx[0]]);
+    auto br = quaternion<T>{T(0), T(0), T(0), T(0)};
+    auto bd = br;
+    for(std::size_t k = 0; k < count; ++k) {
+        const auto& b = bones[idx[k*stride]];
+        auto w = wgt[k*stride];
+        if(dot(pivot, real(b)) < T(0)) w = -w;
+        br += w * real(b);
+        bd += w * imag(b);
+    }
+    const auto len = norm(br);
+    br /= len;
+    bd /= len;
+
+    if(nrm) *nrm = rotate(br, *nrm);
+
+    const auto t = T(2) * (bd * conj(br));
+    const auto r = rotate(br, p);
+    return std::array<T,3>{{r[0] + t.imag_i(), r[1] + t.imag_j(), r[2] + t.imag_k()}};
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    std::mt19937 urng{4711};
+    auto dist = std::uniform_real_distribution<T>{T(-1), T(1)};
+
+    //bones; the last one is the antipode of the first
+    constexpr std::size_t nb = 6;
+    auto bones = std::vector<dual_quaternion<T>>{};
+    for(std::size_t b = 0; b + 1 < nb; ++b) {
+        const auto r = normalized(quaternion<T>{
+            T(2) + dist(urng), dist(urng), dist(urng), dist(urng)});
+        bones.push_back(rigid(r, dist(urng), dist(urng), dist(urng)));
+    }
+    bones.push_back(antipode(bones[0]));
+
+    //not a multiple of the pack width (tail handling)
+    constexpr std::size_t n = 203;
+    constexpr std::size_t m = 3;
+    auto idx = std::vector<std::uint32_t>(m*n);
+    auto wgt = std::vector<T>(m*n);
+    auto px = std::vector<T>(n), py = px, pz = px;
+    auto nx = px, ny = px, nz = px;
+    for(std::size_t i = 0; i < n; ++i) {
+        auto sum = T(0);
+        for(std::size_t k = 0; k < m; ++k) {
+            idx[k*n + i] = std::uint32_t((i * (k+1) + k) % nb);
+            wgt[k*n + i] = (k == 2 && i % 3 == 0) ? T(0) : T(1) + dist(urng);
+            sum += wgt[k*n + i];
+        }
+        for(std::size_t k = 0; k < m; ++k) wgt[k*n + i] /= sum;
+        px[i] = T(4) * dist(urng);
+        py[i] = T(4) * dist(urng);
+        pz[i] = T(4) * dist(urng);
+        nx[i] = dist(urng); ny[i] = dist(urng); nz[i] = dist(urng);
+    }
+
+    const auto skin = dual_quaternion_skinning<T>{bones};
+    if(skin.bone_count() != nb) {
+        throw std::runtime_error{"skinning: wrong bone count"};
+    }
+    const auto inf = skinning_influences<T>{idx.data(), wgt.data(), m};
+
+    auto ox = std::vector<T>(n), oy = ox, oz = ox;
+    auto mx = ox, my = ox, mz = ox;
+    skin(n, inf, vector3_lanes<const T>{px.data(), py.data(), pz.data()},
+                 vector3_lanes<T>{ox.data(), oy.data(), oz.data()},
+                 vector3_lanes<const T>{nx.data(), ny.data(), nz.data()},
+                 vector3_lanes<T>{mx.data(), my.data(), mz.data()});
+
+    for(std::size_t i = 0; i < n; ++i) {
+        auto nrm = std::array<T,3>{{nx[i], ny[i], nz[i]}};
+        const auto r = reference(bones, idx.data() + i, wgt.data() + i, n, m,
+                                 std::array<T,3>{{px[i], py[i], pz[i]}}, &nrm);
+        if(!rel_approx_equal(ox[i], r[0]) || !rel_approx_equal(oy[i], r[1]) || !rel_approx_equal(oz[i], r[2])) {
+            throw std::runtime_error{"skinning: wrong position"};
+        }
+        if(!rel_approx_equal(mx[i], nrm[0]) || !rel_approx_equal(my[i], nrm[1]) || !rel_approx_equal(mz[i], nrm[2])) {
+            throw std::runtime_error{"skinning: wrong normal"};
+        }
+    }
+
+    //antipodal bones give identical results
+    {
+        auto flipped = bones;
+        flipped[1] = antipode(flipped[1]);
+        flipped[3] = antipode(flipped[3]);
+        auto s2 = dual_quaternion_skinning<T>{};
+        s2.set_bones(flipped);
+        auto qx = ox, qy = oy, qz = oz;
+        s2(n, inf, vector3_lanes<const T>{px.data(), py.data(), pz.data()},
+                   vector3_lanes<T>{qx.data(), qy.data(), qz.data()});
+        for(std::size_t i = 0; i < n; ++i) {
+            if(!rel_approx_equal(qx[i], ox[i]) || !rel_approx_equal(qy[i], oy[i]) || !rel_approx_equal(qz[i], oz[i])) {
+                throw std::runtime_error{"skinning: antipodality"};
+            }
+        }
+    }
+
+    //single bone: rigid transform; output aliases input
+    {
+        const auto b = bones[2];
+        const auto one = std::vector<std::uint32_t>(n, 2);
+        const auto w = std::vector<T>(n, T(1));
+        auto qx = px, qy = py, qz = pz;
+        skin(n, skinning_influences<T>{one.data(), w.data(), 1},
+             vector3_lanes<const T>{qx.data(), qy.data(), qz.data()},
+             vector3_lanes<T>{qx.data(), qy.data(), qz.data()});
+        const auto t = T(2) * (imag(b) * conj(real(b)));
+        for(std::size_t i = 0; i < n; ++i) {
+            const auto r = rotate(real(b), std::array<T,3>{{px[i], py[i], pz[i]}});
+            if(!rel_approx_equal(qx[i], r[0] + t.imag_i()) ||
+               !rel_approx_equal(qy[i], r[1] + t.imag_j()) ||
+               !rel_approx_equal(qz[i], r[2] + t.imag_k()))
+            {
+                throw std::runtime_error{"skinning: single bone in-place"};
+            }
+        }
+    }
+
+    //multi-threaded
+    {
+        constexpr std::size_t nl = 50000;
+        auto li = std::vector<std::uint32_t>(2*nl);
+        auto lw = std::vector<T>(2*nl);
+        auto lx = std::vector<T>(nl), ly = lx, lz = lx;
+        for(std::size_t i = 0; i < nl; ++i) {
+            li[i] = std::uint32_t(i % nb);
+            li[nl + i] = std::uint32_t((i / 7) % nb);
+            lw[i] = T(0.25) + T(i % 5) / T(10);
+            lw[nl + i] = T(1) - lw[i];
+            lx[i] = T(i % 11); ly[i] = T(1); lz[i] = T(i % 3);
+        }
+        const auto linf = skinning_influences<T>{li.data(), lw.data(), 2};
+        auto sx = lx, sy = lx, sz = lx, tx = lx, ty = lx, tz = lx;
+        const auto lin = vector3_lanes<const T>{lx.data(), ly.data(), lz.data()};
+        skin(nl, linf, lin, vector3_lanes<T>{sx.data(), sy.data(), sz.data()});
+        skin(nl, linf, lin, vector3_lanes<T>{tx.data(), ty.data(), tz.data()}, 4);
+        for(std::size_t i = 0; i < nl; ++i) {
+            if(!rel_approx_equal(tx[i], sx[i]) || !rel_approx_equal(ty[i], sy[i]) || !rel_approx_equal(tz[i], sz[i])) {
+                throw std::runtime_error{"skinning: multi-threaded"};
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -10,28 +10,213 @@
 
 
 #include  "../include/dual_quaternion.h"
+#include  "../include/equality.h"
 #include  "../include/limits.h"
 #include  "../include/traits.h"
 
 #include <stdexcept>
 #include <iostream>
 #include <complex>
+#include <array>
 
 
 
 
 //-------------------------------------------------------------------
 template<class T>
-void test()
+bool approx(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    using am::num::rel_approx_equal;
+    return rel_approx_equal(a.real(),   b.real()  ) &&
+           rel_approx_equal(a.imag_i(), b.imag_i()) &&
+           rel_approx_equal(a.imag_j(), b.imag_j()) &&
+           rel_approx_equal(a.imag_k(), b.imag_k());
+}
+
+//---------------------------------------------------------
+template<class T>
+bool approx(const am::num::dual_quaternion<T>& a, const am::num::dual_quaternion<T>& b)
+{
+    return approx(real(a), real(b)) && approx(imag(a), imag(b));
+}
+
+//---------------------------------------------------------
+template<class T>
+bool approx(const std::array<T,3>& a, const std::array<T,3>& b)
+{
+    using am::num::rel_approx_equal;
+    return rel_approx_equal(a[0], b[0]) && rel_approx_equal(a[1], b[1]) &&
+           rel_approx_equal(a[2], b[2]);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_fused()
 {
     using namespace am;
     using namespace am::num;
 
-    using std::abs;
+    static_assert(sizeof(dual_quaternion<T>) == 8 * sizeof(T), "");
 
-    using quat_t = dual_quaternion<T>;
+    const auto p = make_dual_quaternion(T(1), T(-2), T(0.5), T(3),
+                                        T(0.25), T(1), T(-1), T(2));
+    const auto q = make_dual(quaternion<T>{T(0.5), T(1), T(2), T(-1)},
+                             quaternion<T>{T(-3), T(0), T(1), T(0.5)});
+
+    //product vs. (pr + e pd)(qr + e qd) = pr qr + e (pr qd + pd qr)
+    const auto ref = make_dual(real(p) * real(q),
+                               real(p) * imag(q) + imag(p) * real(q));
+    if(!approx(p * q, ref)) {
+        throw std::runtime_error{"dual_quaternion: wrong product"};
+    }
+    auto pp = p;
+    pp *= pp;
+    if(!approx(pp, p * p)) {
+        throw std::runtime_error{"dual_quaternion: wrong aliased product"};
+    }
+    if(!approx(times_conj(p, q), p * conj(q)) ||
+       !approx(conj_times(p, q), conj(p) * q))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong conjugate products"};
+    }
+
+    //assignment from a real quaternion clears the dual part
+    auto pa = p;
+    pa = quaternion<T>{T(0.5), T(1), T(2), T(-1)};
+    if(!approx(pa, make_dual(real(q), quaternion<T>{T(0), T(0), T(0), T(0)}))) {
+        throw std::runtime_error{"dual_quaternion: wrong assignment from quaternion"};
+    }
+    pa = quaternion<float>{1.f, 0.f, 0.f, 0.f};
+    if(!approx(pa, dual_quaternion<T>{})) {
+        throw std::runtime_error{"dual_quaternion: wrong mixed type assignment"};
+    }
+    const auto pc = dual_quaternion<T>(quaternion<float>{0.5f, 1.f, 2.f, -1.f});
+    if(!approx(pc, make_dual(real(q), quaternion<T>{T(0), T(0), T(0), T(0)}))) {
+        throw std::runtime_error{"dual_quaternion: wrong mixed type construction"};
+    }
+
+    //conjugates
+    if(!approx(dual_conj(p), make_dual(real(p), T(-1) * imag(p))) ||
+       !approx(full_conj(p), make_dual(conj(real(p)), T(-1) * conj(imag(p)))) ||
+       !approx(conj(p), make_dual(conj(real(p)), conj(imag(p)))))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong conjugates"};
+    }
+
+    //normalization
+    const auto u = normalized(p);
+    auto v = p;
+    v /= norm(p);
+    if(!rel_approx_equal(norm2(real(u)), T(1)) || !rel_approx_equal(dot(real(u), imag(u)), T(0)) ||
+       !approx(u, v))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong normalization"};
+    }
+
+    //rigid transforms
+    const auto ra = normalized(quaternion<T>{T(1), T(2), T(-1), T(0.5)});
+    const auto rb = normalized(quaternion<T>{T(-2), T(0), T(1), T(1)});
+    const auto ta = std::array<T,3>{{T(1), T(-2), T(3)}};
+    const auto tb = std::array<T,3>{{T(0.5), T(0), T(-1)}};
+    const auto a = make_rigid_transform(ra, ta);
+    const auto b = make_rigid_transform(rb, tb);
+    const auto x = std::array<T,3>{{T(2), T(1), T(-0.5)}};
+    const auto rx = rotate(ra, x);
+
+    if(!approx(translation(a), ta) ||
+       !approx(transform(a, x), std::array<T,3>{{rx[0] + ta[0], rx[1] + ta[1], rx[2] + ta[2]}}))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong point transform"};
+    }
+    //q (1 + e x) full_conj(q)
+    const auto px = a * make_dual(quaternion<T>{}, quaternion<T>{T(0), x[0], x[1], x[2]}) *
+                    full_conj(a);
+    const auto tx = transform(a, x);
+    if(!approx(imag(px), quaternion<T>{T(0), tx[0], tx[1], tx[2]}) ||
+       !approx(transform(a * b, x), transform(a, transform(b, x))) ||
+       !approx(a * conj(a), dual_quaternion<T>{}))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong composition"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_screw()
+{
+    using namespace am;
+    using namespace am::num;
+
+    //rotation by 1.2 about the z-parallel line through p0, then 0.7 along it
+    const auto p0 = std::array<T,3>{{T(1), T(2), T(0)}};
+    const auto sc = screw<T>{
+        std::array<T,3>{{T(0), T(0), T(1)}},
+        //p0 x axis
+        std::array<T,3>{{p0[1], -p0[0], T(0)}}, T(1.2), T(0.7)};
+    const auto q = make_dual_quaternion(sc);
+
+    //p0 is only translated along the axis
+    if(!approx(transform(q, p0), std::array<T,3>{{p0[0], p0[1], T(0.7)}}) ||
+       !rel_approx_equal(norm2(real(q)), T(1)) || !rel_approx_equal(dot(real(q), imag(q)), T(0)))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong screw motion"};
+    }
 
-    const auto eps = T(1) / T(1000);
+    const auto s = screw_parameters(q);
+    if(!approx(s.axis, sc.axis) || !approx(s.moment, sc.moment) ||
+       !rel_approx_equal(s.angle, sc.angle) || !rel_approx_equal(s.pitch, sc.pitch))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong screw parameters"};
+    }
+
+    //round trip of general transforms, incl. tiny and zero rotations
+    const T angles[] = {T(2.5), T(0.3), T(1e-3), T(1e-6), T(0)};
+    for(const auto a : angles) {
+        const auto r = quaternion<T>{std::cos(a/2), T(0.48) * std::sin(a/2),
+                                     T(-0.6) * std::sin(a/2), T(0.64) * std::sin(a/2)};
+        const auto g = make_rigid_transform(r, std::array<T,3>{{T(0.5), T(-1), T(2)}});
+        const auto gs = screw_parameters(g);
+        if(!approx(make_dual_quaternion(gs), g) || !approx(pow(g, T(1)), g) ||
+           !approx(pow(g, T(0.5)) * pow(g, T(0.5)), g) ||
+           !rel_approx_equal(gs.angle, a))
+        {
+            throw std::runtime_error{"dual_quaternion: screw round trip"};
+        }
+    }
+
+    //ScLERP
+    const auto a = make_rigid_transform(
+        normalized(quaternion<T>{T(1), T(2), T(-1), T(0.5)}),
+        std::array<T,3>{{T(1), T(-2), T(3)}});
+    const auto b = a * q;
+    if(!approx(sclerp(a, b, T(0)), a) || !approx(sclerp(a, b, T(1)), b) ||
+       !approx(sclerp(a, b, T(0.25)), a * pow(q, T(0.25))) ||
+       //antipodal key
+       !approx(sclerp(a, -b, T(0.25)), a * pow(q, T(0.25))))
+    {
+        throw std::runtime_error{"dual_quaternion: wrong sclerp"};
+    }
+    //constant screw: points on the axis move linearly along it
+    const auto mid = transform(sclerp(dual_quaternion<T>{}, q, T(0.5)), p0);
+    if(!approx(mid, std::array<T,3>{{p0[0], p0[1], T(0.35)}})) {
+        throw std::runtime_error{"dual_quaternion: sclerp does not follow the screw"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    using quat_t = dual_quaternion<T>;
 
     quat_t q1;
     quat_t q2 { dual<T>(1,-1), dual<T>(2,1), dual<T>(3,2), dual<T>(4,6)};
@@ -39,12 +224,15 @@ void test()
     q2.normalize();
 
     auto n = norm(q2);
-    if(abs(n.real() - T(1)) > eps) {
+    if(!rel_approx_equal(n.real(), T(1))) {
         throw std::runtime_error{"wrong norm after normalization"};
     }
 
     quat_t q3 { {1,-1}, {2,1}, {3,2}, {4,6}};
     q3.conjugate();
+
+    test_fused<T>();
+    test_screw<T>();
 }
 
 
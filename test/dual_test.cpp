@@ -20,6 +20,27 @@ using namespace am;
 using namespace am::num;
 
 
+//-------------------------------------------------------------------
+/// @brief (x^2 + 2x + 3) at x = 3 via compound assignments; f' = 2x + 2
+template<class T>
+constexpr dual<T>
+derivative_at_3()
+{
+    auto x = dual<T>{T(3), T(1)};
+    auto f = x;
+    f *= x;
+    f += T(2) * x;
+    f += T(3);
+    auto g = f;
+    g /= dual<T>{T(2), T(0)};
+    g *= T(2);
+    ++g;
+    --g;
+    return g;
+}
+
+
+
 //-------------------------------------------------------------------
 template<class T>
 void test()
@@ -49,6 +70,25 @@ void test()
     {
         throw std::runtime_error{"construction #3"};
     }
+
+    //mixed dual/scalar arithmetic (d/dx at x = 3)
+    const auto x = dual<T>{T(3), T(1)};
+    const auto f = (x + T(2)) * (T(1) - x) / (x - T(1)) + T(6) / x;
+    //f = (x+2)(1-x)/(x-1) + 6/x = -(x+2) + 6/x;  f' = -1 - 6/x^2
+    if( abs( f.real() - T(-3) ) > tolerance<T> ||
+        abs( f.imag() - T(-1) - T(-6)/T(9) ) > tolerance<T> )
+    {
+        throw std::runtime_error{"mixed dual/scalar arithmetic"};
+    }
+
+    //compile-time evaluation
+    constexpr auto s = sqrt(dual<T>{T(4), T(1)});
+    static_assert(s.real() > T(1.999) && s.real() < T(2.001) &&
+                  s.imag() > T(0.249) && s.imag() < T(0.251), "constexpr sqrt");
+
+    constexpr auto c = derivative_at_3<T>();
+    static_assert(c.real() > T(17.999) && c.real() < T(18.001) &&
+                  c.imag() > T(7.999) && c.imag() < T(8.001), "constexpr arithmetic");
     
 }
 
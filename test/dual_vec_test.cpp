@@ -0,0 +1,139 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/dual_vec.h"
+#include  "../include/dual.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief evaluates all one-argument functions on any dual-like type
+template<class D>
+D unary_chain(const D& x, const D& y, const D& z)
+{
+    using std::exp; using std::log; using std::sin; using std::cos;
+    using std::tan; using std::sqrt; using std::cbrt; using std::atan;
+    using std::asin; using std::acos; using std::sinh; using std::cosh;
+    using std::tanh; using std::asinh; using std::atanh; using std::erf;
+    using std::erfc; using std::exp2; using std::expm1; using std::log10;
+    using std::log2;
+
+    return sin(x) * exp(y) / z + cos(x * y) - tan(z) + sqrt(x + y) +
+           cbrt(z) + atan(x - z) + asin(x / 4) * acos(y / 4) +
+           sinh(y) - cosh(z) + tanh(x) + asinh(x * z) + atanh(y / 3) +
+           erf(x) - erfc(z) + exp2(y) + expm1(x) + log(z) * log10(y) +
+           log2(x + z);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    constexpr std::size_t n = 5;
+    using dv_t = dual_vec<T,n>;
+
+    const T v[n] = {T(0.7), T(1.3), T(2.1), T(-0.4), T(0.25)};
+
+    //gradient of a function of 5 variables in one evaluation
+    //vs. 5 evaluations with dual numbers
+    dv_t x[n];
+    dynamic_dual_vec<T> y[n];
+    for(std::size_t i = 0; i < n; ++i) {
+        x[i] = dv_t{v[i], i};
+        y[i] = dynamic_dual_vec<T>{v[i], i, n};
+    }
+
+    const auto f = unary_chain(x[0], x[1], x[2]) * x[3] + x[4];
+    const auto g = unary_chain(y[0], y[1], y[2]) * y[3] + y[4];
+
+    for(std::size_t i = 0; i < n; ++i) {
+        dual<T> d[n];
+        for(std::size_t j = 0; j < n; ++j) {
+            d[j] = dual<T>{v[j], T(i == j ? 1 : 0)};
+        }
+        const auto h = unary_chain(d[0], d[1], d[2]) * d[3] + d[4];
+
+        if(!rel_approx_equal(f.real(), h.real()) || !rel_approx_equal(f.tangent(i), h.imag()) ||
+           !rel_approx_equal(g.real(), h.real()) || !rel_approx_equal(g.tangent(i), h.imag()))
+        {
+            throw std::runtime_error{"dual_vec: wrong gradient"};
+        }
+    }
+    if(g.size() != n || f.size() != n) {
+        throw std::runtime_error{"dual_vec: wrong size"};
+    }
+
+    //functions with analytic derivatives
+    const auto p = pow(x[0], x[1]);
+    const auto a = atan2(x[1], x[0]);
+    const auto l = log1p(x[2]);
+    const auto r = T(2) / abs(x[3]) - T(1) + pow(x[4], 3) * T(2);
+    if(!rel_approx_equal(p.tangent(0), v[1] * std::pow(v[0], v[1] - T(1))) ||
+       !rel_approx_equal(p.tangent(1), std::pow(v[0], v[1]) * std::log(v[0])) ||
+       !rel_approx_equal(a.tangent(0), -v[1] / (v[0]*v[0] + v[1]*v[1])) ||
+       !rel_approx_equal(a.tangent(1),  v[0] / (v[0]*v[0] + v[1]*v[1])) ||
+       !rel_approx_equal(l.tangent(2), T(1) / (T(1) + v[2])) ||
+       !rel_approx_equal(r.tangent(3), T(2) / (v[3]*v[3])) ||
+       !rel_approx_equal(r.tangent(4), T(6) * v[4]*v[4]) ||
+       r.tangent(0) != T(0))
+    {
+        throw std::runtime_error{"dual_vec: wrong analytic derivative"};
+    }
+
+    //runtime-sized constants have no tangents
+    const auto c = dynamic_dual_vec<T>{T(3)};
+    const auto k = c * y[1] - y[1] / c + T(1);
+    if(c.size() != 0 || k.size() != n ||
+       !rel_approx_equal(k.tangent(1), T(3) - T(1)/T(3)) || k.tangent(0) != T(0))
+    {
+        throw std::runtime_error{"dual_vec: dynamic constants"};
+    }
+
+    //compound assignment
+    auto u = x[0];
+    u *= x[1];
+    u /= x[2];
+    u += x[3];
+    u -= T(2);
+    if(!rel_approx_equal(u.real(), v[0] * v[1] / v[2] + v[3] - T(2)) ||
+       !rel_approx_equal(u.tangent(2), -v[0] * v[1] / (v[2] * v[2])) ||
+       !rel_approx_equal(u.tangent(3), T(1)) || !(u < T(0)) || !(x[1] > x[0]))
+    {
+        throw std::runtime_error{"dual_vec: compound assignment"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
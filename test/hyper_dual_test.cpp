@@ -0,0 +1,152 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/hyper_dual.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief function of 4 variables using all supported operations
+template<class D>
+D fun(const D& x, const D& y, const D& z, const D& w)
+{
+    using std::exp; using std::log; using std::sin; using std::cos;
+    using std::tan; using std::sqrt; using std::cbrt; using std::atan;
+    using std::asin; using std::acos; using std::sinh; using std::cosh;
+    using std::tanh; using std::asinh; using std::atanh; using std::erf;
+    using std::erfc; using std::exp2; using std::expm1; using std::log10;
+    using std::log2; using std::log1p; using std::pow; using std::atan2;
+
+    return sin(x) * exp(y) / z + cos(x * y) - tan(z) + sqrt(x + y) +
+           cbrt(z) * w + atan(x - z) + asin(x / 4) * acos(y / 4) +
+           sinh(y) - cosh(z) + tanh(x * w) + asinh(x * z) + atanh(y / 3) +
+           erf(x) - erfc(z) + exp2(y) + expm1(x) + log(z) * log10(y) +
+           log2(x + z) + log1p(w) + pow(x, y) * w * w * w +
+           atan2(y, w) - 2 / (x + w) + 3 * w * w;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    constexpr std::size_t n = 4;
+    using hd_t = hyper_dual<T>;
+    using hv_t = hyper_dual_vec<T,n>;
+
+    const T v[n] = {T(0.7), T(1.3), T(2.1), T(0.4)};
+
+    //full Hessian in one evaluation vs. one hyper_dual pass per entry
+    hv_t x[n];
+    for(std::size_t i = 0; i < n; ++i) x[i] = hv_t{v[i], i};
+
+    const auto f = fun(x[0], x[1], x[2], x[3]);
+
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t j = 0; j < n; ++j) {
+            hd_t h[n];
+            for(std::size_t k = 0; k < n; ++k) {
+                h[k] = hd_t{v[k], T(k == i ? 1 : 0), T(k == j ? 1 : 0), T(0)};
+            }
+            const auto g = fun(h[0], h[1], h[2], h[3]);
+
+            if(!rel_approx_equal(f.real(), g.real()) ||
+               !rel_approx_equal(f.gradient(i), g.e1()) ||
+               !rel_approx_equal(f.gradient(j), g.e2()) ||
+               !rel_approx_equal(f.hessian(i,j), g.e1e2()) ||
+               !rel_approx_equal(f.hessian(i,j), f.hessian(j,i)))
+            {
+                throw std::runtime_error{"hyper_dual: wrong Hessian"};
+            }
+        }
+    }
+
+    //analytic second derivatives
+    const auto a = hd_t{v[0], T(1), T(1), T(0)};
+    const auto b = hd_t{v[1], T(0), T(1), T(0)};
+    const auto ax = make_hyper_dual(v[0], 1, 0, 0);
+    const auto xxy = ax * ax * b;
+    const auto s = sin(a);
+    const auto q = T(1) / a;
+    const auto p = pow(a, b);
+    const auto c = pow(a, 3);
+    if(!rel_approx_equal(xxy.e1e2(), T(2) * v[0]) ||
+       !rel_approx_equal(c.e1e2(), T(6) * v[0]) ||
+       !rel_approx_equal(s.e1e2(), -std::sin(v[0])) ||
+       !rel_approx_equal(q.e1e2(), T(2) / (v[0] * v[0] * v[0])) ||
+       !rel_approx_equal(p.e1e2(), std::pow(v[0], v[1] - T(1)) *
+                         (T(1) + v[1] * std::log(v[0])) +
+                         v[1] * (v[1] - T(1)) * std::pow(v[0], v[1] - T(2))))
+    {
+        throw std::runtime_error{"hyper_dual: wrong analytic derivative"};
+    }
+
+    //powers at base 0
+    {
+        const auto z = hd_t{T(0), T(1), T(1), T(0)};
+        const auto z1 = pow(z, T(1));
+        const auto z2 = pow(z, 2);
+        const auto z3 = pow(z, T(3));
+        if(z1.real() != T(0) || z1.e1() != T(1) || z1.e2() != T(1) || z1.e1e2() != T(0) ||
+           z2.real() != T(0) || z2.e1() != T(0) || z2.e2() != T(0) || z2.e1e2() != T(2) ||
+           z3.real() != T(0) || z3.e1() != T(0) || z3.e2() != T(0) || z3.e1e2() != T(0) ||
+           pow(z, 0).real() != T(1) || pow(z, 0).e1e2() != T(0))
+        {
+            throw std::runtime_error{"hyper_dual: pow at base 0"};
+        }
+    }
+
+    //mixed types and traits
+    const auto m = hyper_dual<float>{1.5f, 1.f, 1.f, 0.f} * T(2);
+    static_assert(std::is_same<std::decay_t<decltype(m)>,
+        hyper_dual<common_numeric_t<float,T>>>::value, "");
+    static_assert(is_number<hd_t>::value, "");
+    static_assert(is_floating_point<hd_t>::value, "");
+    static_assert(std::is_same<common_numeric_t<hd_t,hd_t>,hd_t>::value, "");
+
+    //compound assignment
+    auto u = a;
+    u *= b;
+    u /= a;
+    u += T(1);
+    u -= b;
+    if(!rel_approx_equal(u.real(), T(1)) || !rel_approx_equal(u.e1(), T(0)) ||
+       !rel_approx_equal(u.e2(), T(0))   || !rel_approx_equal(u.e1e2(), T(0)) || !(a < b))
+    {
+        throw std::runtime_error{"hyper_dual: compound assignment"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
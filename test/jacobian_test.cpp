@@ -0,0 +1,133 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/jacobian.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief y_i = sin(x_i) * x_{i+1} + exp(x_0 / 4) * i,  i in [0,n-1)
+///        y_{n-1} = sum_j x_j^2
+struct test_function
+{
+    std::size_t n;
+
+    template<class D>
+    void operator () (const D* x, D* y) const
+    {
+        using std::sin; using std::exp;
+        for(std::size_t i = 0; i+1 < n; ++i) {
+            y[i] = sin(x[i]) * x[i+1] + exp(x[0] / 4) * int(i);
+        }
+        y[n-1] = x[0] * x[0];
+        for(std::size_t j = 1; j < n; ++j) y[n-1] += x[j] * x[j];
+    }
+};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void check(const std::vector<T>& x, const std::vector<T>& jac,
+           const std::vector<T>& fx)
+{
+    using am::num::rel_approx_equal;
+
+    const auto n = x.size();
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t j = 0; j < n; ++j) {
+            T ex = T(0);
+            if(i+1 < n) {
+                if(j == i)   ex += std::cos(x[i]) * x[i+1];
+                if(j == i+1) ex += std::sin(x[i]);
+                if(j == 0)   ex += std::exp(x[0] / 4) * T(i) / T(4);
+            } else {
+                ex = T(2) * x[j];
+            }
+            if(!rel_approx_equal(jac[i*n + j], ex)) {
+                throw std::runtime_error{"jacobian: wrong entry"};
+            }
+        }
+    }
+    if(!fx.empty() &&
+       !rel_approx_equal(fx[0], std::sin(x[0]) * x[1]))
+    {
+        throw std::runtime_error{"jacobian: wrong function value"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    constexpr std::size_t n = 19;
+    std::vector<T> x(n);
+    for(std::size_t i = 0; i < n; ++i) x[i] = T(0.1) * T(i) - T(0.7);
+
+    std::vector<T> jac(n*n, T(-1));
+    std::vector<T> fx(n, T(-1));
+    const auto f = test_function{n};
+
+    //scalar dual seeds, single-threaded
+    jacobian<1>(f, n, x.data(), n, jac.data());
+    check(x, jac, std::vector<T>{});
+
+    //multi-lane seeds with partial last batch, multi-threaded
+    std::fill(jac.begin(), jac.end(), T(-1));
+    jacobian<4>(f, n, x.data(), n, jac.data(), 3);
+    check(x, jac, std::vector<T>{});
+
+    std::fill(jac.begin(), jac.end(), T(-1));
+    value_and_jacobian(f, n, x.data(), n, fx.data(), jac.data(), 0);
+    check(x, jac, fx);
+
+    //generic lambda
+    std::vector<T> j2(2*3);
+    jacobian<2>([](const auto* a, auto* b) {
+            b[0] = a[0] * a[1] * a[2];
+            b[1] = a[0] + a[1] - a[2];
+        }, 3, x.data(), 2, j2.data(), 2);
+
+    if(!rel_approx_equal(j2[0], x[1]*x[2]) || !rel_approx_equal(j2[1], x[0]*x[2]) ||
+       !rel_approx_equal(j2[2], x[0]*x[1]) || j2[3] != T(1) || j2[4] != T(1) ||
+       j2[5] != T(-1))
+    {
+        throw std::runtime_error{"jacobian: generic lambda"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
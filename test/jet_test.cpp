@@ -0,0 +1,172 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/jet.h"
+#include  "../include/hyper_dual.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief uses all supported operations
+template<class D>
+D fun(const D& x)
+{
+    using std::exp; using std::log; using std::sin; using std::cos;
+    using std::sqrt; using std::pow;
+
+    return sin(x) * exp(x) / (x + 2) + cos(x * x) - sqrt(x + 1) +
+           log(x) * pow(x, 3) - 2 / x + pow(x, x) + pow(2, x) * 3;
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief (x^2 + 2x + 3) / x at x = 2, evaluated at compile time
+template<class T>
+constexpr am::num::jet<T,3>
+rational_at_2()
+{
+    const auto x = am::num::jet<T,3>{T(2), T(1)};
+    return (x * x + T(2) * x + T(3)) / x;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    constexpr std::size_t n = 6;
+    using jet_t = jet<T,n>;
+    const auto x0 = T(0.8);
+    const auto x = make_jet<n>(x0, 1);
+
+    //closed-form derivatives
+    const auto e = exp(x);
+    const auto s = sin(x);
+    const auto c = cos(x);
+    const auto l = log(x);
+    const auto r = sqrt(x);
+    const auto p = pow(x, T(2.5));
+    auto fac = T(1);
+    auto falling = T(1);
+    for(std::size_t k = 0; k <= n; ++k) {
+        const auto kpi2 = T(k) * T(1.5707963267948966192313216916397514L);
+        if(k > 0) fac *= T(k);
+        if(!rel_approx_equal(e.derivative(k), std::exp(x0)) ||
+           !rel_approx_equal(s.derivative(k), std::sin(x0 + kpi2)) ||
+           !rel_approx_equal(c.derivative(k), std::cos(x0 + kpi2)) ||
+           !rel_approx_equal(p.derivative(k), falling * std::pow(x0, T(2.5) - T(k))) ||
+           (k > 0 && !rel_approx_equal(l.derivative(k),
+                T((k % 2) ? 1 : -1) * fac / T(k) / std::pow(x0, T(k)))))
+        {
+            throw std::runtime_error{"jet: wrong derivative"};
+        }
+        falling *= T(2.5) - T(k);
+    }
+
+    //identities
+    const auto one = s*s + c*c;
+    const auto id = exp(l);
+    const auto rr = r * r;
+    for(std::size_t k = 0; k <= n; ++k) {
+        const auto ref = T(k == 0 ? 1 : 0);
+        if(!rel_approx_equal(one[k], ref) || !rel_approx_equal(id[k], x[k]) ||
+           !rel_approx_equal(rr[k], x[k]) || !rel_approx_equal((x / x)[k], ref))
+        {
+            throw std::runtime_error{"jet: identities"};
+        }
+    }
+
+    //integer powers at base 0
+    {
+        const auto z = make_jet<n>(T(0), T(1));
+        const auto z2 = pow(z, 2);
+        const auto z3 = pow(z, T(3));
+        const auto zz = z * z;
+        for(std::size_t k = 0; k <= n; ++k) {
+            if(z2[k] != zz[k] || z3[k] != (zz * z)[k] ||
+               pow(z, 0)[k] != T(k == 0 ? 1 : 0) || pow(z, 9)[k] != T(0))
+            {
+                throw std::runtime_error{"jet: pow at base 0"};
+            }
+        }
+    }
+
+    //second order vs. hyper_dual
+    const auto f2 = fun(make_jet<2>(x0, 1));
+    const auto h2 = fun(make_hyper_dual(x0, 1, 1, 0));
+    if(!rel_approx_equal(f2[0], h2.real()) ||
+       !rel_approx_equal(f2.derivative(1), h2.e1()) ||
+       !rel_approx_equal(f2.derivative(2), h2.e1e2()))
+    {
+        throw std::runtime_error{"jet: wrong second-order derivative"};
+    }
+    //higher orders agree with lower ones
+    const auto f6 = fun(x);
+    if(!rel_approx_equal(f6[0], f2[0]) || !rel_approx_equal(f6[1], f2[1]) || !rel_approx_equal(f6[2], f2[2])) {
+        throw std::runtime_error{"jet: truncation must not affect lower orders"};
+    }
+
+    //compile-time evaluation: f = x + 2 + 3/x
+    constexpr auto q = rational_at_2<T>();
+    static_assert(q[0] > T(5.499) && q[0] < T(5.501) &&
+                  q.derivative(1) > T(0.249) && q.derivative(1) < T(0.251) &&
+                  q.derivative(2) > T(0.749) && q.derivative(2) < T(0.751) &&
+                  q.derivative(3) > T(-1.126) && q.derivative(3) < T(-1.124),
+                  "constexpr jet arithmetic");
+
+    //mixed types and traits
+    const auto m = jet<float,n>{1.5f, 1.f} * T(2);
+    static_assert(std::is_same<std::decay_t<decltype(m)>,
+        jet<common_numeric_t<float,T>,n>>::value, "");
+    static_assert(is_number<jet_t>::value, "");
+    static_assert(is_floating_point<jet_t>::value, "");
+    static_assert(std::is_same<common_numeric_t<jet_t,jet_t>,jet_t>::value, "");
+
+    //compound assignment
+    auto u = x;
+    u *= e;
+    u /= x;
+    u += T(1);
+    u -= e;
+    auto w = e;
+    w /= w;
+    if(!rel_approx_equal(u[0], T(1)) || !rel_approx_equal(u[3], T(0)) || !(x < e) || u != u ||
+       !rel_approx_equal(w[0], T(1)) || !rel_approx_equal(w[2], T(0)) || !rel_approx_equal(w[n], T(0))) {
+        throw std::runtime_error{"jet: compound assignment"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,168 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_array.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    using std::abs;
+    const auto eps = T(1)/T(1000);
+    return abs(a.real()   - b.real()  ) < eps &&
+           abs(a.imag_i() - b.imag_i()) < eps &&
+           abs(a.imag_j() - b.imag_j()) < eps &&
+           abs(a.imag_k() - b.imag_k()) < eps;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+    using std::abs;
+
+    //odd size => exercises vector body and scalar tail
+    const std::size_t n = 37;
+
+    std::mt19937 urng{12345};
+    auto dist = std::uniform_real_distribution<T>{T(-2), T(2)};
+
+    auto va = std::vector<quaternion<T>>{};
+    auto vb = std::vector<quaternion<T>>{};
+    for(std::size_t i = 0; i < n; ++i) {
+        va.emplace_back(dist(urng), dist(urng), dist(urng), dist(urng));
+        vb.emplace_back(dist(urng), dist(urng), dist(urng), dist(urng));
+    }
+
+    const auto a = make_quaternion_array(va);
+    const auto b = quaternion_array<T>{vb.begin(), vb.end()};
+
+    if(a.size() != n || b.size() != n) {
+        throw std::runtime_error{"wrong size after construction"};
+    }
+    if(make_quaternion_vector(a).size() != n || !approx(make_quaternion_vector(a)[5], va[5])) {
+        throw std::runtime_error{"wrong values after round trip conversion"};
+    }
+
+    quaternion_array<T> r;
+
+    multiply(a, b, r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], va[i] * vb[i])) throw std::runtime_error{"wrong batch multiply"};
+    }
+
+    multiply(va[3], b, r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], va[3] * vb[i])) throw std::runtime_error{"wrong batch multiply (q * array)"};
+    }
+
+    multiply(a, vb[3], r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], va[i] * vb[3])) throw std::runtime_error{"wrong batch multiply (array * q)"};
+    }
+
+    times_conj(a, b, r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], times_conj(va[i], vb[i]))) throw std::runtime_error{"wrong batch times_conj"};
+    }
+
+    conj_times(a, b, r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], conj_times(va[i], vb[i]))) throw std::runtime_error{"wrong batch conj_times"};
+    }
+
+    inverse(a, r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i] * va[i], quaternion<T>{})) throw std::runtime_error{"wrong batch inverse"};
+    }
+
+    //in-place (output aliases input)
+    auto c = a;
+    multiply(c, b, c);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(c[i], va[i] * vb[i])) throw std::runtime_error{"wrong in-place batch multiply"};
+    }
+
+    //batch rotation
+    auto px = std::vector<T>{}, py = std::vector<T>{}, pz = std::vector<T>{};
+    for(std::size_t i = 0; i < n; ++i) {
+        px.push_back(dist(urng)); py.push_back(dist(urng)); pz.push_back(dist(urng));
+    }
+    auto rx = std::vector<T>(n), ry = std::vector<T>(n), rz = std::vector<T>(n);
+    const auto in  = vector3_lanes<const T>{px.data(), py.data(), pz.data()};
+    const auto out = vector3_lanes<T>{rx.data(), ry.data(), rz.data()};
+
+    const auto q = normalized(va[0]);
+    rotate(q, n, in, out);
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto v = rotate(q, std::array<T,3>{{px[i], py[i], pz[i]}});
+        if(abs(v[0] - rx[i]) > T(0.001) || abs(v[1] - ry[i]) > T(0.001) || abs(v[2] - rz[i]) > T(0.001)) {
+            throw std::runtime_error{"wrong batch rotation"};
+        }
+    }
+
+    auto qs = a;
+    for(std::size_t i = 0; i < n; ++i) qs.set(i, normalized(va[i]));
+    rotate(qs, in, out, 4);
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto v = rotate(qs[i], std::array<T,3>{{px[i], py[i], pz[i]}});
+        if(abs(v[0] - rx[i]) > T(0.001) || abs(v[1] - ry[i]) > T(0.001) || abs(v[2] - rz[i]) > T(0.001)) {
+            throw std::runtime_error{"wrong per-point batch rotation"};
+        }
+    }
+
+    //normalization
+    auto n1 = a, n2 = a;
+    normalize(n1);
+    normalize_fast(n2);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(n1[i], normalized(va[i]))) throw std::runtime_error{"wrong batch normalize"};
+        if(!approx(n2[i], normalized(va[i]))) throw std::runtime_error{"wrong batch normalize_fast"};
+        if(abs(norm(n2[i]) - T(1)) > T(1e-6)) throw std::runtime_error{"batch normalize_fast out of error bound"};
+    }
+
+    //nearly-unit input: scale by 1 +- 0.001
+    for(std::size_t i = 0; i < n; ++i) {
+        n1.set(i, (T(1) + T(0.001) * T(int(i % 3) - 1)) * n1[i]);
+    }
+    renormalize(n1);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(abs(norm(n1[i]) - T(1)) > T(2e-6)) throw std::runtime_error{"batch renormalize out of error bound"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
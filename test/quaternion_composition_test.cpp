@@ -0,0 +1,134 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_composition.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    using std::abs;
+    const auto eps = T(1)/T(1000);
+    return abs(a.real()   - b.real()  ) < eps &&
+           abs(a.imag_i() - b.imag_i()) < eps &&
+           abs(a.imag_j() - b.imag_j()) < eps &&
+           abs(a.imag_k() - b.imag_k()) < eps;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test(std::size_t n)
+{
+    using namespace am;
+    using namespace am::num;
+
+    std::mt19937 urng{7};
+
+    //small rotations, so that the product does not become random too fast
+    std::vector<quaternion<T>> q;
+    for(std::size_t i = 0; i < n; ++i) {
+        q.push_back(normalized(quaternion<T>{1,0,0,0} +
+                               T(0.01) * random_unit_quaternion<T>(urng)));
+    }
+
+    //serial left fold reference
+    std::vector<quaternion<T>> ref;
+    auto p = quaternion<T>{};
+    for(const auto& x : q) {
+        p *= x;
+        p.normalize();
+        ref.push_back(p);
+    }
+
+    if(!approx(compose(q.begin(), q.begin()), quaternion<T>{})) {
+        throw std::runtime_error{"compose of empty range not identity"};
+    }
+    for(std::size_t threads : {std::size_t(1), std::size_t(0), std::size_t(3)}) {
+        if(!approx(compose(q.begin(), q.end(), threads), ref.back())) {
+            throw std::runtime_error{"wrong compose"};
+        }
+
+        std::vector<quaternion<T>> out(n);
+        if(partial_compose(q.begin(), q.end(), out.begin(), 16, threads) != out.end()) {
+            throw std::runtime_error{"wrong partial_compose return value"};
+        }
+        for(std::size_t i = 0; i < n; ++i) {
+            if(!approx(out[i], ref[i])) throw std::runtime_error{"wrong partial_compose"};
+        }
+        //in place
+        out = q;
+        partial_compose(out.begin(), out.end(), out.begin(), 16, threads);
+        if(!approx(out.back(), ref.back())) throw std::runtime_error{"wrong in-place partial_compose"};
+    }
+
+    const auto qa = make_quaternion_array(q);
+    if(!approx(compose(qa), ref.back())) throw std::runtime_error{"wrong quaternion_array compose"};
+
+    quaternion_array<T> pa;
+    partial_compose(qa, pa, 8, 0);
+    if(pa.size() != n || !approx(pa[n/2], ref[n/2])) {
+        throw std::runtime_error{"wrong quaternion_array partial_compose"};
+    }
+    //in place, multi-threaded
+    auto pb = qa;
+    partial_compose(pb, pb, 8, 3);
+    if(pb.size() != n || !approx(pb[n-1], ref[n-1])) {
+        throw std::runtime_error{"wrong in-place quaternion_array partial_compose"};
+    }
+
+    //non-unit chain: no normalization by default
+    if(n > 0) {
+        auto s = std::vector<quaternion<T>>{};
+        auto e = std::vector<quaternion<T>>{};
+        auto x = quaternion<T>{};
+        for(std::size_t i = 0; i < 40; ++i) {
+            s.push_back(T(1.05) * q[i % n]);
+            x *= s.back();
+            e.push_back(x);
+        }
+        auto out = s;
+        partial_compose(s.begin(), s.end(), out.begin());
+        const auto sa = make_quaternion_array(s);
+        auto oa = quaternion_array<T>{};
+        partial_compose(sa, oa);
+        for(std::size_t i = 0; i < s.size(); ++i) {
+            if(!approx(out[i], e[i]) || !approx(oa[i], e[i])) {
+                throw std::runtime_error{"wrong non-unit partial_compose"};
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>(1000);
+        test<double>(100000);
+        test<long double>(3);
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,233 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_compression.h"
+#include  "../include/quaternion_random.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief rotation angle between the rotations represented by a and b
+template<class T1, class T2>
+double angle_between(const am::num::quaternion<T1>& a,
+                     const am::num::quaternion<T2>& b)
+{
+    using quat_t = am::num::quaternion<long double>;
+    const auto p = quat_t(a);
+    const auto q = quat_t(b);
+    const auto d = std::abs(
+        p.real()*q.real() + p.imag_i()*q.imag_i() +
+        p.imag_j()*q.imag_j() + p.imag_k()*q.imag_k()) /
+        std::sqrt(norm2(p) * norm2(q));
+    return static_cast<double>(2 * std::acos(std::min(1.0L, d)));
+}
+
+
+
+//-------------------------------------------------------------------
+void test_half()
+{
+    using am::num::half;
+
+    const float exact[] = {0.0f, 1.0f, -2.0f, 0.5f, 65504.0f,
+                           6.103515625e-05f, 5.9604644775390625e-08f};
+    for(auto x : exact) {
+        if(float(half(x)) != x) throw std::runtime_error{"half: not exact"};
+    }
+    if(half(1.0f).bits() != 0x3c00u || half(-2.0f).bits() != 0xc000u) {
+        throw std::runtime_error{"half: wrong bits"};
+    }
+    //round to nearest even
+    if(float(half(1.0f + 1.0f/2048.0f)) != 1.0f ||
+       float(half(1.0f + 3.0f/2048.0f)) != 1.0f + 2.0f/1024.0f)
+    {
+        throw std::runtime_error{"half: wrong rounding"};
+    }
+    //no double rounding (via float) for wider types
+    const double above = 1.0 + 1.0/2048.0 + std::ldexp(1.0, -40);
+    const double below = 1.0 + 1.0/2048.0 - std::ldexp(1.0, -40);
+    const double tiny  = std::ldexp(1.0, -25) + std::ldexp(1.0, -50);
+    if(float(half(above)) != 1.0f + 1.0f/1024.0f ||
+       float(half(-above)) != -1.0f - 1.0f/1024.0f ||
+       float(half(below)) != 1.0f ||
+       float(half(static_cast<long double>(above))) != 1.0f + 1.0f/1024.0f ||
+       half(tiny).bits() != 0x0001u ||
+       half(1.0 + 1.0/2048.0).bits() != 0x3c00u ||
+       !std::isinf(float(half(1e300))) ||
+       !std::isnan(float(half(std::numeric_limits<double>::quiet_NaN()))))
+    {
+        throw std::runtime_error{"half: wrong rounding from double"};
+    }
+    if(!std::isinf(float(half(70000.0f))) ||
+       !std::isnan(float(half(std::numeric_limits<float>::quiet_NaN()))))
+    {
+        throw std::runtime_error{"half: wrong special values"};
+    }
+
+    //batch conversion == scalar conversion
+    std::vector<float> f(1000), g(1000);
+    std::vector<half> h(1000);
+    for(std::size_t i = 0; i < f.size(); ++i) {
+        f[i] = (float(i) - 500.0f) * 0.37f;
+    }
+    am::num::to_half(f.size(), f.data(), h.data());
+    am::num::to_float(h.size(), h.data(), g.data());
+    for(std::size_t i = 0; i < f.size(); ++i) {
+        if(h[i].bits() != half(f[i]).bits() || g[i] != float(h[i])) {
+            throw std::runtime_error{"half: batch conversion"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<int Bits, class T>
+void test_packed(const am::num::quaternion_array<T>& q)
+{
+    using namespace am::num;
+    using pq_t = packed_quaternion<Bits>;
+
+    const auto eps = pq_t::max_angle_error();
+
+    //identity is exact
+    const auto id = quaternion<T>(pq_t{});
+    if(id.real() != T(1) || id.imag_i() != T(0) ||
+       id.imag_j() != T(0) || id.imag_k() != T(0))
+    {
+        throw std::runtime_error{"packed_quaternion: identity"};
+    }
+
+    //worst case for the dropped component
+    const auto h = quaternion<T>{T(-0.5), T(0.5), T(-0.5), T(0.5)};
+    if(angle_between(h, quaternion<T>(pq_t{h})) > eps) {
+        throw std::runtime_error{"packed_quaternion: error bound"};
+    }
+
+    std::vector<pq_t> p(q.size());
+    compress(q, p.data(), 3);
+
+    quaternion_array<T> r;
+    decompress(p.size(), p.data(), r, 3);
+
+    double maxErr = 0;
+    for(std::size_t i = 0; i < q.size(); ++i) {
+        if(p[i] != pq_t{q[i]}) {
+            throw std::runtime_error{"packed_quaternion: batch encoding"};
+        }
+        const auto s = quaternion<T>(p[i]);
+        const auto d = angle_between(q[i], r[i]);
+        if(angle_between(s, r[i]) > 1e-6 || d > eps) {
+            throw std::runtime_error{"packed_quaternion: round trip"};
+        }
+        maxErr = std::max(maxErr, d);
+    }
+    //bound is not too loose
+    if(maxErr < eps / 10) {
+        throw std::runtime_error{"packed_quaternion: error bound too loose"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test(std::size_t n)
+{
+    using namespace am;
+    using namespace am::num;
+
+    quaternion_array<T> q;
+    random_unit_quaternions(q, n, 4321);
+
+    test_packed<32>(q);
+    test_packed<48>(q);
+    if(std::numeric_limits<T>::digits > 24) test_packed<64>(q);
+
+    //half precision
+    std::vector<quath> h(n);
+    compress(q, h.data(), 2);
+
+    quaternion_array<T> r;
+    decompress(h.size(), h.data(), r, 2);
+
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto s = quath{q[i]};
+        if(s.real().bits() != h[i].real().bits() ||
+           s.imag_k().bits() != h[i].imag_k().bits())
+        {
+            throw std::runtime_error{"quaternion<half>: batch conversion"};
+        }
+        if(angle_between(q[i], r[i]) > max_half_quaternion_angle_error() ||
+           angle_between(h[i], r[i]) > 1e-6)
+        {
+            throw std::runtime_error{"quaternion<half>: round trip"};
+        }
+    }
+
+    //batch conversion of values next to half ties: no double rounding
+    if(std::numeric_limits<T>::digits > 24) {
+        const T t[] = {
+            T(0.5) + std::ldexp(T(1), -12) + std::ldexp(T(1), -45),
+            T(0.5) + std::ldexp(T(1), -12) - std::ldexp(T(1), -45),
+            T(1) + std::ldexp(T(1), -11) + std::ldexp(T(1), -40),
+            std::ldexp(T(1), -25) + std::ldexp(T(1), -50) };
+        quaternion_array<T> a;
+        for(std::size_t i = 0; i < 37; ++i) {
+            const auto sgn = (i & 1) ? T(-1) : T(1);
+            a.push_back(quaternion<T>{sgn * t[i % 4], t[(i+1) % 4],
+                                      -t[(i+2) % 4], t[(i+3) % 4]});
+        }
+        std::vector<quath> ah(a.size());
+        compress(a, ah.data());
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            const auto s = quath{a[i]};
+            if(s.real().bits()   != ah[i].real().bits()   ||
+               s.imag_i().bits() != ah[i].imag_i().bits() ||
+               s.imag_j().bits() != ah[i].imag_j().bits() ||
+               s.imag_k().bits() != ah[i].imag_k().bits())
+            {
+                throw std::runtime_error{"quaternion<half>: batch rounding"};
+            }
+        }
+    }
+
+    //arithmetic is carried out in float
+    const quaternion<float> p = h[0] * h[1];
+    if(angle_between(p, q[0] * q[1]) > 4 * max_half_quaternion_angle_error()) {
+        throw std::runtime_error{"quaternion<half>: product"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_half();
+
+        test<float>(1000);
+        test<double>(1000);
+        test<long double>(300);
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,186 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_conversion.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(T a, T b)
+{
+    using std::abs;
+    return abs(a - b) < T(1)/T(1000);
+}
+
+//---------------------------------------------------------
+template<class T>
+bool same_rotation(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    using std::abs;
+    return approx(abs(dot(a,b)), T(1));
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_atan2()
+{
+    using am::num::simd::pack;
+
+    const T vals[] = {T(0), T(-0.0), T(1), T(-1), T(1e-20), T(-1e-20),
+                      T(0.3), T(-2.5), T(1e6), T(-7)};
+
+    for(auto y : vals) {
+        for(auto x : vals) {
+            const auto a = am::num::simd::atan2(pack<T,1>{y}, pack<T,1>{x}).v;
+            const auto e = std::atan2(y, x);
+            if(std::abs(a - e) > T(8) * std::numeric_limits<T>::epsilon() * std::abs(e) ||
+               std::signbit(a) != std::signbit(e))
+            {
+                throw std::runtime_error{"wrong simd::atan2"};
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    test_atan2<T>();
+
+    const std::size_t n = 37;
+
+    std::mt19937 urng{1234};
+
+    //special rotations (identity, 180 degree turns)
+    quaternion_array<T> q;
+    q.push_back(quaternion<T>{1,0,0,0});
+    q.push_back(quaternion<T>{0,1,0,0});
+    q.push_back(quaternion<T>{0,0,1,0});
+    q.push_back(quaternion<T>{0,0,0,1});
+    q.push_back(normalized(quaternion<T>{0,1,-1,0}));
+    while(q.size() < n) q.push_back(random_unit_quaternion<T>(urng));
+
+    //rotation matrices
+    const auto v = std::array<T,3>{{T(0.5), T(-2), T(3)}};
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto m = to_rotation_matrix(q[i]);
+        const auto r = rotate(q[i], v);
+        for(int k = 0; k < 3; ++k) {
+            if(!approx(m[k][0]*v[0] + m[k][1]*v[1] + m[k][2]*v[2], r[k])) {
+                throw std::runtime_error{"wrong rotation matrix"};
+            }
+        }
+        const auto p = from_rotation_matrix(m);
+        if(!same_rotation(p, q[i]) || p.real() < T(0)) {
+            throw std::runtime_error{"wrong quaternion from rotation matrix"};
+        }
+    }
+
+    std::vector<T> lanes(9*n);
+    auto mlanes = matrix3_lanes<T>{};
+    T** mptr = &mlanes.m00;
+    for(std::size_t k = 0; k < 9; ++k) mptr[k] = lanes.data() + k*n;
+
+    to_rotation_matrix(q, mlanes);
+    quaternion_array<T> p;
+    const auto cm = matrix3_lanes<const T>{
+        mlanes.m00, mlanes.m01, mlanes.m02,
+        mlanes.m10, mlanes.m11, mlanes.m12,
+        mlanes.m20, mlanes.m21, mlanes.m22};
+    from_rotation_matrix(n, cm, p, 0);
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto m = to_rotation_matrix(q[i]);
+        if(!approx(mlanes.m12[i], m[1][2]) || !approx(mlanes.m20[i], m[2][0])) {
+            throw std::runtime_error{"wrong batch rotation matrix"};
+        }
+        if(!same_rotation(p[i], q[i])) {
+            throw std::runtime_error{"wrong batch quaternion from rotation matrix"};
+        }
+    }
+
+    //Euler angles
+    const auto e = make_euler_angles(degrees<T>{30}, degrees<T>{-20}, radians<T>{T(1)});
+    if(!approx(radians_cast<T>(e.yaw), pi<T>/T(6))) {
+        throw std::runtime_error{"wrong Euler angle units"};
+    }
+    const auto qe = from_euler_angles(e);
+    const auto ref = quaternion<T>{std::cos(pi<T>/T(12)), 0, 0, std::sin(pi<T>/T(12))} *
+                     quaternion<T>{std::cos(pi<T>/T(-18)), 0, std::sin(pi<T>/T(-18)), 0} *
+                     quaternion<T>{std::cos(T(0.5)), std::sin(T(0.5)), 0, 0};
+    if(!same_rotation(qe, ref)) throw std::runtime_error{"wrong quaternion from Euler angles"};
+
+    std::vector<T> yaw(n), pitch(n), roll(n);
+    to_euler_angles(q, euler_lanes<T>{yaw.data(), pitch.data(), roll.data()});
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto ei = to_euler_angles(q[i]);
+        if(!approx(radians_cast<T>(ei.yaw), yaw[i]) ||
+           !approx(radians_cast<T>(ei.pitch), pitch[i]) ||
+           !approx(radians_cast<T>(ei.roll), roll[i]))
+        {
+            throw std::runtime_error{"wrong batch Euler angles"};
+        }
+        if(!same_rotation(from_euler_angles(ei), q[i])) {
+            throw std::runtime_error{"wrong Euler angle round trip"};
+        }
+    }
+
+    from_euler_angles(n, euler_lanes<const T>{yaw.data(), pitch.data(), roll.data()}, p);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!same_rotation(p[i], q[i])) {
+            throw std::runtime_error{"wrong batch quaternion from Euler angles"};
+        }
+    }
+
+    //angles beyond +/- pi
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto k = T(int(i % 7) - 3);
+        yaw[i]   += T(2) * k * pi<T>;
+        pitch[i] -= T(4) * k * pi<T>;
+        roll[i]  += T(6) * k * pi<T>;
+    }
+    from_euler_angles(n, euler_lanes<const T>{yaw.data(), pitch.data(), roll.data()}, p);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!same_rotation(p[i], q[i])) {
+            throw std::runtime_error{"wrong batch quaternion from large Euler angles"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
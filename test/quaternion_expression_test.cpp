@@ -0,0 +1,138 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_expression.h"
+#include  "../include/dual_quaternion.h"
+#include  "../include/biquaternion.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <complex>
+#include <type_traits>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    using std::abs;
+    using am::num::abs;
+    using r_t = std::decay_t<decltype(abs(a.real() - b.real()))>;
+    const auto eps = r_t(1) / r_t(1000);
+    return abs(a.real()   - b.real()  ) < eps &&
+           abs(a.imag_i() - b.imag_i()) < eps &&
+           abs(a.imag_j() - b.imag_j()) < eps &&
+           abs(a.imag_k() - b.imag_k()) < eps;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    using quat_t = quaternion<T>;
+
+    const auto a = quat_t{T(1), T(2), T(-1), T(0.5)};
+    const auto b = quat_t{T(0.5), T(-1), T(3), T(2)};
+    const auto c = quat_t{T(-2), T(0.25), T(1), T(-1)};
+    const auto d = quat_t{T(1.5), T(1), T(-0.5), T(2)};
+
+    //same semantics as the eager inverse (d is not a unit quaternion)
+    const auto dinv = inverse(d);
+
+    //single patterns
+    if(!approx(quat_t(lazy(a) * lazy(b)), a * b)) {
+        throw std::runtime_error{"quaternion_expression: x*y"};
+    }
+    if(!approx(quat_t(lazy(a) * conj(lazy(b))), a * conj(b))) {
+        throw std::runtime_error{"quaternion_expression: x*conj(y)"};
+    }
+    if(!approx(quat_t(conj(lazy(a)) * lazy(b)), conj(a) * b)) {
+        throw std::runtime_error{"quaternion_expression: conj(x)*y"};
+    }
+    if(!approx(quat_t(conj(lazy(a)) * conj(lazy(b))), conj(a) * conj(b))) {
+        throw std::runtime_error{"quaternion_expression: conj(x)*conj(y)"};
+    }
+    if(!approx(quat_t(lazy(a) * inverse(lazy(d))), a * dinv)) {
+        throw std::runtime_error{"quaternion_expression: x*inverse(y)"};
+    }
+    if(!approx(quat_t(inverse(lazy(d)) * lazy(a)), dinv * a)) {
+        throw std::runtime_error{"quaternion_expression: inverse(x)*y"};
+    }
+    if(!approx(quat_t(lazy(d) * inverse(lazy(d))), d * inverse(d)) ||
+       !approx(quat_t(inverse(lazy(d))), inverse(d)))
+    {
+        throw std::runtime_error{"quaternion_expression: x*inverse(x)"};
+    }
+    if(!approx(quat_t(lazy(a) * inverse(lazy(d))), times_inverse(a, d)) ||
+       !approx(quat_t(inverse(lazy(d)) * lazy(a)), inverse_times(d, a)))
+    {
+        throw std::runtime_error{"quaternion_expression: eager inverse semantics"};
+    }
+    if(!approx(quat_t(conj(conj(lazy(a)))), a)) {
+        throw std::runtime_error{"quaternion_expression: conj(conj(x))"};
+    }
+
+    //chains, mixed with plain quaternions and scalars
+    const quat_t r = lazy(a) * b * conj(lazy(c)) * inverse(lazy(d));
+    if(!approx(r, a * b * conj(c) * dinv)) {
+        throw std::runtime_error{"quaternion_expression: chain"};
+    }
+    if(!approx(eval(T(2) * (lazy(a) + lazy(b)) - T(3) * lazy(c)),
+               T(2) * (a + b) - T(3) * c))
+    {
+        throw std::runtime_error{"quaternion_expression: sum/scale"};
+    }
+    if(!approx(quat_t(conj(lazy(a) * lazy(b)) * lazy(c)), conj(a * b) * c)) {
+        throw std::runtime_error{"quaternion_expression: conj(x*y)*z"};
+    }
+
+    //dual quaternions
+    using dq_t = dual_quaternion<T>;
+    const auto p = dq_t{dual<T>(1,-1), dual<T>(2,1), dual<T>(3,2), dual<T>(4,6)};
+    const auto q = dq_t{dual<T>(0,2), dual<T>(-1,1), dual<T>(2,0), dual<T>(1,-3)};
+    const dq_t pq = lazy(p) * conj(lazy(q));
+    if(!approx(pq, times_conj(p, q))) {
+        throw std::runtime_error{"quaternion_expression: dual quaternion"};
+    }
+
+    //biquaternions
+    using cx_t = std::complex<T>;
+    using bq_t = biquaternion<T>;
+    const auto u = bq_t{cx_t(1,1), cx_t(0,2), cx_t(-1,0), cx_t(2,-1)};
+    const auto v = bq_t{cx_t(2,0), cx_t(1,-1), cx_t(0,1), cx_t(1,1)};
+    const bq_t uv = conj(lazy(u)) * lazy(v);
+    if(!approx(uv, conj_times(u, v))) {
+        throw std::runtime_error{"quaternion_expression: biquaternion"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_integration.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    using std::abs;
+
+    const std::size_t n = 23;
+    const int steps = 1000;
+    const auto dt = T(1) / T(steps);
+    const auto eps = T(1) / T(1000);
+
+    std::mt19937 urng{99};
+    auto dist = std::uniform_real_distribution<T>{T(-3), T(3)};
+
+    auto wx = std::vector<T>{}, wy = std::vector<T>{}, wz = std::vector<T>{};
+    quaternion_array<T> qw, qb;
+    for(std::size_t i = 0; i < n; ++i) {
+        wx.push_back(dist(urng)); wy.push_back(dist(urng)); wz.push_back(dist(urng));
+        const auto q = random_unit_quaternion<T>(urng);
+        qw.push_back(q);
+        qb.push_back(q);
+    }
+    const auto q0 = qw;
+    const auto w = vector3_lanes<const T>{wx.data(), wy.data(), wz.data()};
+
+    for(int s = 0; s < steps; ++s) {
+        integrate_angular_velocity(qw, w, dt);
+        integrate_body_angular_velocity(qb, w, dt);
+    }
+
+    //constant angular velocity => closed form solution
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto dq = exp(quaternion<T>{0, wx[i]/2, wy[i]/2, wz[i]/2});
+        const auto ew = dq * q0[i];
+        const auto eb = q0[i] * dq;
+
+        if( abs(qw[i].real()   - ew.real())   > eps ||
+            abs(qw[i].imag_i() - ew.imag_i()) > eps ||
+            abs(qw[i].imag_j() - ew.imag_j()) > eps ||
+            abs(qw[i].imag_k() - ew.imag_k()) > eps )
+        {
+            throw std::runtime_error{"wrong world frame integration"};
+        }
+        if( abs(qb[i].real()   - eb.real())   > eps ||
+            abs(qb[i].imag_i() - eb.imag_i()) > eps ||
+            abs(qb[i].imag_j() - eb.imag_j()) > eps ||
+            abs(qb[i].imag_k() - eb.imag_k()) > eps )
+        {
+            throw std::runtime_error{"wrong body frame integration"};
+        }
+        if(abs(norm(qw[i]) - T(1)) > eps || abs(norm(qb[i]) - T(1)) > eps) {
+            throw std::runtime_error{"norm drift after integration"};
+        }
+    }
+
+    //single large steps: |w| dt / 2 well beyond pi/2
+    for(const auto h : {T(1), T(2.5)}) {
+        auto ql = q0;
+        integrate_angular_velocity(ql, w, h);
+        for(std::size_t i = 0; i < n; ++i) {
+            const auto e = exp(quaternion<T>{0, h*wx[i]/2, h*wy[i]/2, h*wz[i]/2}) * q0[i];
+            if( abs(ql[i].real()   - e.real())   > eps ||
+                abs(ql[i].imag_i() - e.imag_i()) > eps ||
+                abs(ql[i].imag_j() - e.imag_j()) > eps ||
+                abs(ql[i].imag_k() - e.imag_k()) > eps )
+            {
+                throw std::runtime_error{"wrong integration with large step"};
+            }
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
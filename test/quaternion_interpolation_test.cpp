@@ -0,0 +1,109 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_interpolation.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    using std::abs;
+    const auto eps = T(1)/T(1000);
+    return abs(a.real()   - b.real()  ) < eps &&
+           abs(a.imag_i() - b.imag_i()) < eps &&
+           abs(a.imag_j() - b.imag_j()) < eps &&
+           abs(a.imag_k() - b.imag_k()) < eps;
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    const std::size_t n = 29;
+
+    std::mt19937 urng{4711};
+    auto dist = std::uniform_real_distribution<T>{T(0), T(1)};
+
+    quaternion_array<T> from, to;
+    std::vector<T> ts;
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto a = random_unit_quaternion<T>(urng);
+        auto b = random_unit_quaternion<T>(urng);
+        //small angles
+        if(i % 5 == 0) b = normalized(a + T(0.0001) * b);
+        //identical keys
+        if(i % 7 == 0) b = a;
+        from.push_back(a);
+        to.push_back(b);
+        ts.push_back(dist(urng));
+    }
+
+    const auto table = slerp_table<T>{from, to};
+    if(table.size() != n) throw std::runtime_error{"wrong slerp table size"};
+
+    quaternion_array<T> r;
+    table.interpolate(ts.data(), r);
+    for(std::size_t i = 0; i < n; ++i) {
+        auto expected = slerp(from[i], to[i], ts[i]);
+        if(!approx(r[i], expected)) throw std::runtime_error{"wrong batch slerp"};
+        if(!approx(table(i, ts[i]), expected)) throw std::runtime_error{"wrong single slerp"};
+        if(!is_normalized(r[i]) && std::abs(norm(r[i]) - T(1)) > T(0.0001)) {
+            throw std::runtime_error{"batch slerp result not normalized"};
+        }
+    }
+
+    //end points
+    table.interpolate(T(0), r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], from[i])) throw std::runtime_error{"wrong slerp at t = 0"};
+    }
+    table.interpolate(T(1), r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], to[i]) && !approx(r[i], T(-1) * to[i])) {
+            throw std::runtime_error{"wrong slerp at t = 1"};
+        }
+    }
+
+    nlerp(from, to, ts.data(), r);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!approx(r[i], nlerp(from[i], to[i], ts[i]))) throw std::runtime_error{"wrong batch nlerp"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_mean.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b,
+            T eps = T(1)/T(1000))
+{
+    using std::abs;
+    return abs(a.real()   - b.real()  ) < eps &&
+           abs(a.imag_i() - b.imag_i()) < eps &&
+           abs(a.imag_j() - b.imag_j()) < eps &&
+           abs(a.imag_k() - b.imag_k()) < eps;
+}
+
+
+//---------------------------------------------------------
+template<class T>
+bool approx(T a, T b)
+{
+    using std::abs;
+    return abs(a - b) < T(1)/T(1000);
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test(std::size_t n)
+{
+    using namespace am;
+    using namespace am::num;
+
+    std::mt19937 urng{99};
+    auto noise = std::normal_distribution<T>{T(0), T(0.01)};
+
+    const auto center = random_unit_quaternion<T>(urng);
+    const auto ref = (center.real() < T(0)) ? T(-1) * center : center;
+
+    //empty
+    quaternion_mean_accumulator<T> acc;
+    if(!acc.empty() || !approx(acc.mean(), quaternion<T>{})) {
+        throw std::runtime_error{"empty accumulator mean not identity"};
+    }
+
+    //symmetric noise around 'center' with random signs
+    quaternion_array<T> q;
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto d = normalized(quaternion<T>{1, noise(urng), noise(urng), noise(urng)});
+        const auto s = (i % 2) ? T(1) : T(-1);
+        q.push_back(s * center * d);
+        q.push_back(s * center * conj(d));
+    }
+
+    for(std::size_t threads : {std::size_t(1), std::size_t(0)}) {
+        if(!approx(mean(q, nullptr, threads), ref)) throw std::runtime_error{"wrong mean"};
+    }
+
+    //scalar add + merging of partial states
+    quaternion_mean_accumulator<T> a, b;
+    for(std::size_t i = 0; i < q.size(); ++i) {
+        if(i < q.size() / 3) a.add(q[i]); else b.add(q[i]);
+    }
+    acc = a + b;
+    if(!approx(acc.weight(), T(q.size()))) throw std::runtime_error{"wrong weight"};
+    if(!approx(acc.mean(), mean(q))) throw std::runtime_error{"wrong merged mean"};
+
+    //weights: single sample dominates
+    const auto other = random_unit_quaternion<T>(urng);
+    std::vector<T> wt(q.size(), T(0));
+    wt[q.size() / 2] = T(1);
+    q.set(q.size() / 2, other);
+    const auto expected = (other.real() < T(0)) ? T(-1) * other : other;
+    if(!approx(mean(q, wt.data(), 0), expected)) throw std::runtime_error{"wrong weighted mean"};
+
+    //degenerate eigenvalues: two samples 90 degrees apart -> halfway
+    acc.clear();
+    acc.add(quaternion<T>{1,0,0,0});
+    acc.add(normalized(quaternion<T>{1,0,0,1}));
+    if(!approx(acc.mean(), slerp(quaternion<T>{1,0,0,0},
+                                 normalized(quaternion<T>{1,0,0,1}), T(0.5))))
+    {
+        throw std::runtime_error{"wrong mean of two samples"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>(1000);
+        test<double>(60000);
+        test<long double>(50);
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,153 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/quaternion_random.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool identical(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    return !(a.real()   < b.real())   && !(b.real()   < a.real())   &&
+           !(a.imag_i() < b.imag_i()) && !(b.imag_i() < a.imag_i()) &&
+           !(a.imag_j() < b.imag_j()) && !(b.imag_j() < a.imag_j()) &&
+           !(a.imag_k() < b.imag_k()) && !(b.imag_k() < a.imag_k());
+}
+
+
+
+//-------------------------------------------------------------------
+void test_philox()
+{
+    using am::num::philox4x32;
+
+    //known answers (Random123)
+    const auto a = philox4x32<>::generate({{0,0,0,0}}, {{0,0}});
+    const auto b = philox4x32<>::generate(
+        {{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}},
+        {{0xa4093822u, 0x299f31d0u}});
+
+    if(a[0] != 0x6627e8d5u || a[1] != 0xe169c58du ||
+       a[2] != 0xbc57ac4cu || a[3] != 0x9b00dbd8u ||
+       b[0] != 0xd16cfe09u || b[1] != 0x94fdccebu ||
+       b[2] != 0x5001e420u || b[3] != 0x24126ea1u)
+    {
+        throw std::runtime_error{"wrong philox4x32 output"};
+    }
+
+    //engine interface vs. counter access
+    auto g = philox4x32<>{42, 7};
+    auto h = g;
+    const auto b1 = g.block(1);
+    for(int i = 0; i < 4; ++i) g();
+    for(int i = 0; i < 4; ++i) {
+        if(g() != b1[i]) throw std::runtime_error{"wrong philox4x32 sequence"};
+    }
+    h.discard(6);
+    g = philox4x32<>{42, 7};
+    for(int i = 0; i < 6; ++i) g();
+    if(g != h || g() != h()) throw std::runtime_error{"wrong philox4x32::discard"};
+
+    //discard starting mid-block
+    for(unsigned long long n : {1ull, 2ull, 3ull, 4ull, 5ull, 9ull, 14ull}) {
+        for(int start = 0; start < 5; ++start) {
+            auto seq = philox4x32<>{1234};
+            auto skip = seq;
+            for(int i = 0; i < start; ++i) { seq(); skip(); }
+            for(unsigned long long i = 0; i < n; ++i) seq();
+            skip.discard(n);
+            for(int i = 0; i < 6; ++i) {
+                if(seq() != skip()) {
+                    throw std::runtime_error{"wrong philox4x32::discard mid-block"};
+                }
+            }
+        }
+    }
+
+    if(philox4x32<>{42, 7}() == philox4x32<>{42, 8}()) {
+        throw std::runtime_error{"philox4x32 streams not independent"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test(std::size_t n)
+{
+    using namespace am;
+    using namespace am::num;
+
+    quaternion_array<T> q;
+    random_unit_quaternions(q, n, 1234);
+    if(q.size() != n) throw std::runtime_error{"wrong number of quaternions"};
+
+    //unit length and first moments (means 0, E[w^2] = 1/4)
+    T mean[4] = {0,0,0,0};
+    T sq = 0;
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto x = q[i];
+        if(std::abs(norm(x) - T(1)) > T(1)/T(10000)) {
+            throw std::runtime_error{"random quaternion not normalized"};
+        }
+        mean[0] += x.real();   mean[1] += x.imag_i();
+        mean[2] += x.imag_j(); mean[3] += x.imag_k();
+        sq += x.real() * x.real();
+    }
+    for(auto m : mean) {
+        if(std::abs(m / T(n)) > T(0.02)) throw std::runtime_error{"random quaternions biased"};
+    }
+    if(std::abs(sq / T(n) - T(0.25)) > T(0.02)) {
+        throw std::runtime_error{"random quaternions not uniform"};
+    }
+
+    //reproducible for any number of threads; buffer version identical
+    quaternion_array<T> p;
+    random_unit_quaternions(p, n, 1234, 0, 0);
+    quaternion_array<T> r;
+    random_unit_quaternions(r, n, 1234, 0, 3);
+    std::vector<quaternion<T>> v(n);
+    random_unit_quaternions(v.data(), v.data() + n, 1234, 0, 3);
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!identical(p[i], q[i]) || !identical(r[i], q[i]) ||
+           !identical(v[i], q[i]))
+        {
+            throw std::runtime_error{"random quaternions not reproducible"};
+        }
+    }
+
+    random_unit_quaternions(p, n, 1234, 1);
+    if(identical(p[0], q[0])) throw std::runtime_error{"random quaternion streams not independent"};
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_philox();
+        test<float>(10000);
+        test<double>(50000);
+        test<long double>(1000);
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
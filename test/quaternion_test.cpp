@@ -18,6 +18,65 @@
 
 
 
+//-------------------------------------------------------------------
+/// @brief rotation group of the cube, generated at compile time
+template<class T>
+struct rotation_table {
+    am::num::quaternion<T> q[32];
+    int n = 0;
+};
+
+template<class T>
+constexpr bool
+same_rotation(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    const auto d = dot(a,b);
+    return d > T(0.999) || d < T(-0.999);
+}
+
+template<class T>
+constexpr rotation_table<T>
+cube_rotations()
+{
+    using am::num::quaternion;
+
+    const auto s = am::num::constexpr_sqrt(T(0.5));
+    const quaternion<T> gen[2] = { quaternion<T>{s, s, 0, 0},
+                                   quaternion<T>{s, 0, s, 0} };
+    rotation_table<T> t;
+    t.q[t.n++] = quaternion<T>{};
+    for(int i = 0; i < t.n && t.n < 32; ++i) {
+        for(const auto& g : gen) {
+            auto r = t.q[i];
+            r *= g;
+            r.normalize();
+            bool found = false;
+            for(int j = 0; j < t.n; ++j) {
+                if(same_rotation(t.q[j], r)) found = true;
+            }
+            if(!found) t.q[t.n++] = r;
+        }
+    }
+    return t;
+}
+
+//---------------------------------------------------------
+template<class T>
+constexpr am::num::quaternion<T>
+mutated(am::num::quaternion<T> q)
+{
+    q += am::num::quaternion<T>{1, 1, 1, 1};
+    q *= T(2);
+    q.times_conj(am::num::quaternion<T>{0, 0, 1, 0});
+    q.conj_times(am::num::quaternion<T>{0, 1, 0, 0});
+    q.conjugate();
+    q.invert();
+    q -= T(1);
+    return q;
+}
+
+
+
 //-------------------------------------------------------------------
 template<class T>
 void test()
@@ -141,6 +200,80 @@ void test()
     {
         throw std::runtime_error{"wrong values after conj_times(q1,q2)"};
     }
+
+    //rotation by 90 degrees about z: x -> y
+    const auto s2 = std::sqrt(T(0.5));
+    const auto v1 = rotate(quaternion<T>{s2, 0, 0, s2}, std::array<T,3>{{1, 2, 3}});
+    if( abs(v1[0] + 2) > eps ||
+        abs(v1[1] - 1) > eps ||
+        abs(v1[2] - 3) > eps )
+    {
+        throw std::runtime_error{"wrong values after rotate(q,v)"};
+    }
+
+    const auto q6 = normalized(quaternion<T>{1,2,3,4});
+    const auto v2 = rotate(q6, std::array<T,3>{{-1, 2, 5}});
+    const auto q7 = q6 * quaternion<T>{0, -1, 2, 5} * conj(q6);
+    if( abs(v2[0] - q7.imag_i()) > eps ||
+        abs(v2[1] - q7.imag_j()) > eps ||
+        abs(v2[2] - q7.imag_k()) > eps )
+    {
+        throw std::runtime_error{"rotate(q,v) differs from q * v * conj(q)"};
+    }
+
+    //exp / log / pow
+    const auto q8 = quaternion<T>{T(0.5), T(-0.25), T(1), T(0.75)};
+    const auto q9 = exp(log(q8));
+    if( abs(q9.real()   - q8.real())   > eps ||
+        abs(q9.imag_i() - q8.imag_i()) > eps ||
+        abs(q9.imag_j() - q8.imag_j()) > eps ||
+        abs(q9.imag_k() - q8.imag_k()) > eps )
+    {
+        throw std::runtime_error{"exp(log(q)) != q"};
+    }
+
+    const auto q10 = exp(quaternion<T>{0, 0, 0, pi<T>/4});
+    if( abs(q10.real() - s2) > eps || abs(q10.imag_k() - s2) > eps ) {
+        throw std::runtime_error{"wrong values after exp"};
+    }
+
+    const auto q11 = pow(q8, T(0.5));
+    const auto q12 = q11 * q11;
+    if( abs(q12.real()   - q8.real())   > eps ||
+        abs(q12.imag_i() - q8.imag_i()) > eps ||
+        abs(q12.imag_j() - q8.imag_j()) > eps ||
+        abs(q12.imag_k() - q8.imag_k()) > eps )
+    {
+        throw std::runtime_error{"pow(q,0.5)^2 != q"};
+    }
+
+    auto q13 = T(1.001) * normalized(q8);
+    q13.renormalize();
+    if(abs(norm(q13) - 1) > T(2e-6)) throw std::runtime_error{"wrong norm after renormalize"};
+    if(abs(norm(renormalized(T(0.999) * q13)) - 1) > T(2e-6)) {
+        throw std::runtime_error{"wrong norm after renormalized"};
+    }
+
+    //compile-time evaluation
+    constexpr auto table = cube_rotations<T>();
+    static_assert(table.n == 24, "cube rotation group must have 24 elements");
+    static_assert(norm(quaternion<T>{0, 3, 0, 4}) > T(4.999) &&
+                  norm(quaternion<T>{0, 3, 0, 4}) < T(5.001), "constexpr norm");
+
+    constexpr auto q14 = mutated(quaternion<T>{1, 2, 3, 4});
+    const auto q15 = mutated(quaternion<T>{1, 2, 3, 4});
+    if( abs(q14.real()   - q15.real())   > eps ||
+        abs(q14.imag_i() - q15.imag_i()) > eps ||
+        abs(q14.imag_j() - q15.imag_j()) > eps ||
+        abs(q14.imag_k() - q15.imag_k()) > eps )
+    {
+        throw std::runtime_error{"constexpr and runtime evaluation differ"};
+    }
+    for(int i = 0; i < table.n; ++i) {
+        if(!is_normalized(table.q[i])) {
+            throw std::runtime_error{"constexpr rotation table not normalized"};
+        }
+    }
 }
 
 
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/scomplex_array.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <limits>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::scomplex<T>& a, const am::num::scomplex<T>& b)
+{
+    using std::abs;
+    const auto eps = T(1)/T(1000);
+    return abs(a.real() - b.real()) <= eps * (T(1) + abs(b.real())) &&
+           abs(a.imag() - b.imag()) <= eps * (T(1) + abs(b.imag()));
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am::num;
+
+    //not a multiple of the pack width (tail handling)
+    constexpr std::size_t n = 203;
+
+    std::vector<T> xr(n), xi(n), yr(n), yi(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        //|imag| < real
+        xr[i] = T(0.1) + T(8) * T(i) / T(n);
+        xi[i] = xr[i] * (T(i % 9) - T(4)) / T(5);
+    }
+    const auto x = scomplex_lanes<const T>{xr.data(), xi.data()};
+    const auto y = scomplex_lanes<T>{yr.data(), yi.data()};
+    const auto at = [&](std::size_t i) { return scomplex<T>{xr[i], xi[i]}; };
+    const auto out = [&](std::size_t i) { return scomplex<T>{yr[i], yi[i]}; };
+
+    const auto check = [&](const char* name, auto&& f) {
+        for(std::size_t i = 0; i < n; ++i) {
+            if(!approx(out(i), f(at(i)))) {
+                throw std::runtime_error{std::string("scomplex_array: ") + name};
+            }
+        }
+    };
+
+    exp(n, x, y);
+    check("exp", [](const auto& v) { return exp(v); });
+    log(n, x, y);
+    check("log", [](const auto& v) { return log(v); });
+    sqrt(n, x, y);
+    check("sqrt", [](const auto& v) { return sqrt(v); });
+    pow(n, x, T(1.75), y);
+    check("pow", [](const auto& v) { return pow(v, T(1.75)); });
+    sin(n, x, y);
+    check("sin", [](const auto& v) { return sin(v); });
+    cos(n, x, y);
+    check("cos", [](const auto& v) { return cos(v); });
+    sinh(n, x, y);
+    check("sinh", [](const auto& v) { return sinh(v); });
+    cosh(n, x, y);
+    check("cosh", [](const auto& v) { return cosh(v); });
+    erf(n, x, y);
+    check("erf", [](const auto& v) { return erf(v); });
+
+    //small arguments: sinh must not cancel
+    {
+        using std::abs;
+        std::vector<T> sr(n), si(n, T(0));
+        for(std::size_t i = 0; i < n; ++i) {
+            sr[i] = std::pow(T(10), -T(1) - T(i % 9)) * ((i % 2) ? T(1) : T(-1));
+        }
+        sinh(n, scomplex_lanes<const T>{sr.data(), si.data()}, y);
+        const auto tol = T(16) * std::numeric_limits<T>::epsilon();
+        for(std::size_t i = 0; i < n; ++i) {
+            const auto r = std::sinh(sr[i]);
+            if(abs(yr[i] - r) > tol * abs(r) || abs(yi[i]) > tol * abs(r)) {
+                throw std::runtime_error{"scomplex_array: sinh small argument"};
+            }
+        }
+    }
+
+    //output aliases input; multi-threaded
+    std::vector<T> br(100000), bi(100000);
+    for(std::size_t i = 0; i < br.size(); ++i) {
+        br[i] = T(i % 1000) / T(100);
+        bi[i] = T(0.5) * br[i];
+    }
+    sin(br.size(), scomplex_lanes<const T>{br.data(), bi.data()},
+        scomplex_lanes<T>{br.data(), bi.data()}, 4);
+    for(std::size_t i = 0; i < br.size(); ++i) {
+        const auto r = T(i % 1000) / T(100);
+        if(!approx(scomplex<T>{br[i], bi[i]}, sin(scomplex<T>{r, T(0.5) * r}))) {
+            throw std::runtime_error{"scomplex_array: sin in-place, multi-threaded"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
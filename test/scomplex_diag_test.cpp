@@ -0,0 +1,160 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/scomplex_diag.h"
+#include  "../include/split_biquaternion.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <random>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::scomplex<T>& a, const am::num::scomplex<T>& b)
+{
+    using std::abs;
+    const auto eps = T(1)/T(1000);
+    return abs(a.real() - b.real()) <= eps * (T(1) + abs(b.real())) &&
+           abs(a.imag() - b.imag()) <= eps * (T(1) + abs(b.imag()));
+}
+
+//---------------------------------------------------------
+template<class T>
+bool approx(const am::num::split_biquaternion<T>& a,
+            const am::num::split_biquaternion<T>& b)
+{
+    return approx(a.real(), b.real()) && approx(a.imag_i(), b.imag_i()) &&
+           approx(a.imag_j(), b.imag_j()) && approx(a.imag_k(), b.imag_k());
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_scomplex_diag()
+{
+    using namespace am;
+    using namespace am::num;
+
+    const auto x = scomplex<T>{T(1.5), T(-0.5)};
+    const auto y = scomplex<T>{T(0.75), T(0.25)};
+    const auto dx = make_scomplex_diag(x);
+    const auto dy = scomplex_diag<T>{y};
+
+    //conversions
+    if(!approx(make_scomplex(dx), x) || !approx(scomplex<T>(dy), y) ||
+       dx.e1() != T(1) || dx.e2() != T(2))
+    {
+        throw std::runtime_error{"scomplex_diag: conversion"};
+    }
+
+    //arithmetic agrees with the (real,imag) representation
+    if(!approx(make_scomplex(dx * dy), x * y) ||
+       !approx(make_scomplex(dx + dy), x + y) ||
+       !approx(make_scomplex(dx - dy), x - y) ||
+       !approx(make_scomplex(T(2) * dx), T(2) * x) ||
+       !approx(make_scomplex(conj(dx)), conj(x)) ||
+       !approx(make_scomplex(times_conj(dx, dy)), times_conj(x, y)) ||
+       !approx(make_scomplex(conj_times(dx, dy)), conj_times(x, y)) ||
+       !approx(make_scomplex((dx / dy) * dy), x) ||
+       std::abs(abs2(dx) - abs2(x)) > T(1e-4))
+    {
+        throw std::runtime_error{"scomplex_diag: arithmetic"};
+    }
+
+    auto p = dx;
+    p *= dy;
+    p += T(1);
+    p.conjugate();
+    if(!approx(make_scomplex(p), conj(x * y + scomplex<T>{T(1), T(0)}))) {
+        throw std::runtime_error{"scomplex_diag: compound assignment"};
+    }
+
+    //functions
+    if(!approx(make_scomplex(exp(dx)), exp(x)) ||
+       !approx(make_scomplex(log(dy)), log(y)) ||
+       !approx(make_scomplex(sqrt(dx)), sqrt(x)) ||
+       !approx(make_scomplex(pow(dx, T(2.5))), pow(x, T(2.5))) ||
+       !approx(make_scomplex(sin(dx)), sin(x)) ||
+       !approx(make_scomplex(cosh(dy)), cosh(y)))
+    {
+        throw std::runtime_error{"scomplex_diag: functions"};
+    }
+
+    static_assert(is_number<scomplex_diag<T>>::value, "");
+    static_assert(is_floating_point<scomplex_diag<T>>::value, "");
+    static_assert(std::is_same<common_numeric_t<scomplex_diag<T>,T>,
+                               scomplex_diag<T>>::value, "");
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test_split_biquaternion_diag()
+{
+    using namespace am;
+    using namespace am::num;
+
+    std::mt19937 urng{4711};
+    auto dist = std::uniform_real_distribution<T>{T(-0.5), T(0.5)};
+    const auto random_sbq = [&] {
+        return make_split_biquaternion(
+            T(1) + dist(urng), dist(urng), dist(urng), dist(urng),
+            dist(urng), dist(urng), dist(urng), dist(urng));
+    };
+
+    //long product in both representations
+    auto p = split_biquaternion<T>{};
+    auto d = split_biquaternion_diag<T>{};
+    for(int i = 0; i < 12; ++i) {
+        const auto q = random_sbq();
+        p *= q;
+        d *= make_split_biquaternion_diag(q);
+    }
+    if(!approx(make_split_biquaternion(d), p)) {
+        throw std::runtime_error{"split_biquaternion_diag: product chain"};
+    }
+
+    //integer powers
+    const auto q = random_sbq();
+    auto q5 = q;
+    for(int i = 1; i < 5; ++i) q5 *= q;
+    if(!approx(pow(q, 5), q5) || !approx(pow(q, 1), q) ||
+       !approx(pow(q, 0), split_biquaternion<T>{}) ||
+       !approx(make_split_biquaternion(pow(make_split_biquaternion_diag(q), 5)), q5))
+    {
+        throw std::runtime_error{"split_biquaternion_diag: integer power"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_scomplex_diag<float>();
+        test_scomplex_diag<double>();
+        test_scomplex_diag<long double>();
+        test_split_biquaternion_diag<float>();
+        test_split_biquaternion_diag<double>();
+        test_split_biquaternion_diag<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,116 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/scomplex.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool approx(const am::num::scomplex<T>& a, const am::num::scomplex<T>& b)
+{
+    using std::abs;
+    const auto eps = T(1)/T(1000);
+    return abs(a.real() - b.real()) <= eps * (T(1) + abs(b.real())) &&
+           abs(a.imag() - b.imag()) <= eps * (T(1) + abs(b.imag()));
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+
+    //j*a: exp(j a) = cosh(a) + j sinh(a)
+    const auto ja = scomplex<T>{T(0), T(0.75)};
+    if(!approx(exp(ja), scomplex<T>{std::cosh(T(0.75)), std::sinh(T(0.75))})) {
+        throw std::runtime_error{"scomplex: exp(j a)"};
+    }
+
+    for(int k = -4; k <= 4; ++k) {
+        //|imag| < real  (inside the light cone)
+        const auto x = scomplex<T>{T(1.5), T(k) / T(4)};
+        const auto y = scomplex<T>{T(-0.5), T(0.25)};
+        const auto one = scomplex<T>{T(1), T(0)};
+
+        if(!approx(exp(log(x)), x) || !approx(log(exp(y)), y) ||
+           !approx(exp(x + y), exp(x) * exp(y)) ||
+           !approx(exp2(x), exp(T(0.6931471805599453094172321L) * x)) ||
+           !approx(expm1(y) + one, exp(y)) ||
+           !approx(log1p(x), log(x + one)) ||
+           !approx(T(2.302585092994045684017991L) * log10(x), log(x)) ||
+           !approx(T(0.6931471805599453094172321L) * log2(x), log(x)) ||
+           !approx(log_base(T(3), x) * std::log(T(3)), log(x)))
+        {
+            throw std::runtime_error{"scomplex: exp / log"};
+        }
+
+        if(!approx(sqrt(x) * sqrt(x), x) || !approx(cbrt(x) * cbrt(x) * cbrt(x), x) ||
+           !approx(cbrt(y) * cbrt(y) * cbrt(y), y) ||
+           !approx(pow(x, T(3)), x * x * x) ||
+           !approx(pow(x, scomplex<T>{T(2), T(0)}), x * x) ||
+           !approx(pow(x, y), exp(y * log(x))))
+        {
+            throw std::runtime_error{"scomplex: roots / powers"};
+        }
+
+        if(!approx(sin(y) * sin(y) + cos(y) * cos(y), one) ||
+           !approx(tan(y) * cos(y), sin(y)) ||
+           !approx(sin(asin(y)), y) || !approx(cos(acos(y)), y) ||
+           !approx(tan(atan(x)), x))
+        {
+            throw std::runtime_error{"scomplex: trigonometric"};
+        }
+
+        if(!approx(cosh(x) * cosh(x) - sinh(x) * sinh(x), one) ||
+           !approx(tanh(y) * cosh(y), sinh(y)) ||
+           !approx(sinh(asinh(x)), x) || !approx(cosh(acosh(x + one)), x + one) ||
+           !approx(tanh(atanh(y)), y))
+        {
+            throw std::runtime_error{"scomplex: hyperbolic"};
+        }
+
+        if(!approx(erf(y) + erfc(y), one) || !approx(erf(-x), -erf(x))) {
+            throw std::runtime_error{"scomplex: error function"};
+        }
+
+        //f(r + j d) = f(r) + j d f'(r) for small d
+        const auto h = T(1e-3);
+        const auto z = sin(scomplex<T>{T(0.8), h});
+        if(!approx(z, scomplex<T>{std::sin(T(0.8)), h * std::cos(T(0.8))})) {
+            throw std::runtime_error{"scomplex: first order expansion"};
+        }
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
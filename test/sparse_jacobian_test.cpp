@@ -0,0 +1,140 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/sparse_jacobian.h"
+#include  "../include/equality.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+/// @brief tridiagonal coupling + every row depends on the last variable
+///        y_i = x_{i-1} * x_i + sin(x_{i+1}) + x_{n-1} / (i+1)
+struct banded_function
+{
+    std::size_t n;
+
+    template<class D>
+    void operator () (const D* x, D* y) const
+    {
+        using std::sin;
+        for(std::size_t i = 0; i < n; ++i) {
+            y[i] = x[n-1] / int(i+1);
+            if(i > 0)   y[i] += x[i-1] * x[i];
+            if(i+1 < n) y[i] += sin(x[i+1]);
+        }
+    }
+};
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test()
+{
+    using namespace am;
+    using namespace am::num;
+    using std::size_t;
+
+    constexpr size_t n = 41;
+    std::vector<T> x(n);
+    for(size_t i = 0; i < n; ++i) x[i] = T(0.05) * T(i) - T(0.9);
+
+    //pattern from coordinates (with duplicates)
+    std::vector<std::pair<size_t,size_t>> coords;
+    for(size_t i = 0; i < n; ++i) {
+        coords.emplace_back(i, n-1);
+        if(i > 0)   coords.emplace_back(i, i-1);
+        coords.emplace_back(i, i);
+        if(i+1 < n) coords.emplace_back(i, i+1);
+        coords.emplace_back(i, i);
+    }
+    const auto p = sparsity_pattern{n, n, coords};
+    if(p.nonzeros() != 3*n - 2 + n - 2) {
+        throw std::runtime_error{"sparsity_pattern: wrong number of nonzeros"};
+    }
+
+    //same pattern from CSR arrays
+    const auto q = sparsity_pattern{n, n, p.row_offsets(), p.col_indices()};
+    if(q.col_indices() != p.col_indices()) {
+        throw std::runtime_error{"sparsity_pattern: CSR construction"};
+    }
+
+    //coloring: valid and small
+    const auto c = color_columns(p);
+    if(c.size() != n || c.num_colors() > 4) {
+        throw std::runtime_error{"color_columns: too many colors"};
+    }
+    for(size_t i = 0; i < n; ++i) {
+        const auto& o = p.row_offsets();
+        for(auto k = o[i]; k < o[i+1]; ++k) {
+            for(auto l = k+1; l < o[i+1]; ++l) {
+                if(c[p.col_indices()[k]] == c[p.col_indices()[l]]) {
+                    throw std::runtime_error{"color_columns: invalid coloring"};
+                }
+            }
+        }
+    }
+
+    //compressed vs. dense evaluation
+    const auto f = banded_function{n};
+    std::vector<T> dense(n*n);
+    jacobian(f, n, x.data(), n, dense.data());
+
+    std::vector<T> values(p.nonzeros(), T(-1));
+    std::vector<T> fx(n, T(-1));
+
+    const auto check = [&] {
+        for(size_t i = 0; i < n; ++i) {
+            const auto& o = p.row_offsets();
+            for(auto k = o[i]; k < o[i+1]; ++k) {
+                if(!rel_approx_equal(values[k], dense[i*n + p.col_indices()[k]])) {
+                    throw std::runtime_error{"sparse_jacobian: wrong value"};
+                }
+            }
+        }
+    };
+
+    sparse_jacobian<1>(f, p, c, x.data(), values.data());
+    check();
+
+    std::fill(values.begin(), values.end(), T(-1));
+    sparse_jacobian<2>(f, p, c, x.data(), values.data(), 2);
+    check();
+
+    std::fill(values.begin(), values.end(), T(-1));
+    value_and_sparse_jacobian(f, p, c, x.data(), fx.data(), values.data(), 0);
+    check();
+    if(!rel_approx_equal(fx[3], x[2]*x[3] + std::sin(x[4]) + x[n-1] / T(4))) {
+        throw std::runtime_error{"sparse_jacobian: wrong function value"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>();
+        test<double>();
+        test<long double>();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
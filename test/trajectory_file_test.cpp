@@ -0,0 +1,178 @@
+/*****************************************************************************
+ *
+ * AM utilities
+ *
+ * released under MIT license
+ *
+ * 2008-2017 André Müller
+ *
+ *****************************************************************************/
+
+
+#include  "../include/trajectory_file.h"
+#include  "../include/quaternion_random.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+bool identical(const am::num::quaternion<T>& a, const am::num::quaternion<T>& b)
+{
+    return !(a.real()   < b.real())   && !(b.real()   < a.real())   &&
+           !(a.imag_i() < b.imag_i()) && !(b.imag_i() < a.imag_i()) &&
+           !(a.imag_j() < b.imag_j()) && !(b.imag_j() < a.imag_j()) &&
+           !(a.imag_k() < b.imag_k()) && !(b.imag_k() < a.imag_k());
+}
+
+
+
+//-------------------------------------------------------------------
+template<class T>
+void test(std::size_t n)
+{
+    using namespace am;
+    using namespace am::num;
+
+    const std::string filename = "trajectory_file_test.tmp";
+
+    std::vector<double> time(n);
+    for(std::size_t i = 0; i < n; ++i) time[i] = 0.5 * double(i) + 10.0;
+
+    //quaternions
+    quaternion_array<T> q;
+    random_unit_quaternions(q, n, 77);
+    write_trajectory(filename, time.data(), q);
+    {
+        trajectory_reader<quaternion<T>> r{filename};
+
+        if(r.size() != n || r.version() != trajectory_format_version) {
+            throw std::runtime_error{"trajectory_reader: wrong header"};
+        }
+        for(std::size_t i = 0; i < n; ++i) {
+            if(!identical(r[i], q[i]) || r.time(i) != time[i]) {
+                throw std::runtime_error{"trajectory_reader: wrong sample"};
+            }
+        }
+        //lanes are aligned views into the file
+        if(reinterpret_cast<std::uintptr_t>(r.lanes().x) % 64 != 0) {
+            throw std::runtime_error{"trajectory_reader: lanes not aligned"};
+        }
+
+        //lookup by timestamp
+        if(n > 1 && (r.lower_bound(10.0) != 0 || r.lower_bound(10.2) != 1 ||
+           r.lower_bound(1e9) != n || r.index_at(10.7) != 1 ||
+           r.index_at(0.0) != 0 || r.index_at(1e9) != n-1))
+        {
+            throw std::runtime_error{"trajectory_reader: wrong time lookup"};
+        }
+
+        //wrong element type
+        bool thrown = false;
+        try { trajectory_reader<dual_quaternion<T>> d{filename}; }
+        catch(trajectory_error&) { thrown = true; }
+        if(!thrown) throw std::runtime_error{"trajectory_reader: kind not checked"};
+    }
+
+    //dual quaternions
+    std::vector<dual_quaternion<T>> dq(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        const auto p = q[i];
+        const auto t = quaternion<T>{T(0), T(i), T(1), T(-2)};
+        const auto d = T(0.5) * (t * p);
+        dq[i] = dual_quaternion<T>{
+            dual<T>{p.real(), d.real()}, dual<T>{p.imag_i(), d.imag_i()},
+            dual<T>{p.imag_j(), d.imag_j()}, dual<T>{p.imag_k(), d.imag_k()} };
+    }
+    write_trajectory(filename, n, time.data(), dq.data());
+    {
+        const auto r = trajectory_reader<dual_quaternion<T>>{filename};
+
+        for(std::size_t i = 0; i < n; ++i) {
+            const auto a = r[i];
+            if(!identical(quaternion<T>{a.real().real(), a.imag_i().real(),
+                                        a.imag_j().real(), a.imag_k().real()}, q[i]) ||
+               a.imag_k().imag() != dq[i].imag_k().imag() ||
+               r.dual_lanes().y[i] != dq[i].imag_j().imag())
+            {
+                throw std::runtime_error{"trajectory_reader: wrong dual quaternion"};
+            }
+        }
+    }
+
+    //unsorted timestamps are rejected
+    if(n > 1) {
+        std::swap(time[0], time[1]);
+        bool thrown = false;
+        try { write_trajectory(filename, time.data(), q); }
+        catch(trajectory_error&) { thrown = true; }
+        if(!thrown) throw std::runtime_error{"write_trajectory: order not checked"};
+    }
+
+    std::remove(filename.c_str());
+}
+
+
+
+//-------------------------------------------------------------------
+/// @brief header fields that would overflow the size checks
+void test_corrupt_header()
+{
+    using namespace am::num;
+
+    const std::string filename = "trajectory_file_test_corrupt.tmp";
+    auto q = quaternion_array<double>(16);
+    auto time = std::vector<double>(16);
+    for(std::size_t i = 0; i < time.size(); ++i) time[i] = double(i);
+
+    const auto corrupt = [&](auto modify) {
+        write_trajectory(filename, time.data(), q);
+        {
+            auto f = std::fstream{filename,
+                std::ios::in | std::ios::out | std::ios::binary};
+            trajectory_header h;
+            f.read(reinterpret_cast<char*>(&h), sizeof(h));
+            modify(h);
+            f.seekp(0);
+            f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        }
+        bool thrown = false;
+        try { trajectory_reader<quaternion<double>>{filename}; }
+        catch(trajectory_error&) { thrown = true; }
+        std::remove(filename.c_str());
+        return thrown;
+    };
+
+    if(!corrupt([](trajectory_header& h) { h.count = std::uint64_t(1) << 61; }) ||
+       !corrupt([](trajectory_header& h) { h.count = ~std::uint64_t(0); }) ||
+       !corrupt([](trajectory_header& h) { h.time_offset = ~std::uint64_t(7); }) ||
+       !corrupt([](trajectory_header& h) { h.lane_offset = ~std::uint64_t(7); }) ||
+       !corrupt([](trajectory_header& h) { h.lane_stride = std::uint64_t(1) << 62; }))
+    {
+        throw std::runtime_error{"trajectory_reader: corrupt header accepted"};
+    }
+}
+
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test<float>(1000);
+        test<double>(777);
+        test<long double>(3);
+        test<double>(0);
+        test_corrupt_header();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}